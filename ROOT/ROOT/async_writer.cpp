@@ -0,0 +1,45 @@
+#include "async_writer.hpp"
+
+AsyncWriter::AsyncWriter(std::size_t capacity) : queue(capacity == 0 ? 1 : capacity) {
+    this->thread = std::thread([this] { this->work(); });
+}
+
+AsyncWriter::~AsyncWriter() {
+    this->stopping.store(true, std::memory_order_release);
+    this->pushed.fetch_add(1, std::memory_order_release);
+    this->pushed.notify_one();
+    this->thread.join();
+}
+
+void AsyncWriter::submit(std::function<void()> job) {
+    while (true) {
+        // read the counter before trying, so that a slot freed in between wakes the wait up at once
+        std::uint32_t seen = this->popped.load(std::memory_order_acquire);
+        if (this->queue.try_push(job)) {
+            break;
+        }
+        this->popped.wait(seen, std::memory_order_acquire);
+    }
+    this->pushed.fetch_add(1, std::memory_order_release);
+    this->pushed.notify_one();
+}
+
+void AsyncWriter::work() {
+    std::function<void()> job;
+    while (true) {
+        // every job queued before the stop request is visible once stopping is seen
+        bool stop = this->stopping.load(std::memory_order_acquire);
+        std::uint32_t seen = this->pushed.load(std::memory_order_acquire);
+        if (this->queue.try_pop(job)) {
+            job();
+            job = nullptr;
+            this->popped.fetch_add(1, std::memory_order_release);
+            this->popped.notify_all();
+            continue;
+        }
+        if (stop) {
+            return;
+        }
+        this->pushed.wait(seen, std::memory_order_acquire);
+    }
+}
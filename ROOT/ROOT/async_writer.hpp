@@ -0,0 +1,154 @@
+/**
+ * @file async_writer.hpp
+ * @brief Background writer thread fed through a bounded lock-free queue.
+ *
+ * Solving threads hand over their results as write jobs and go back to solving; a single writer thread runs the
+ * jobs (building the printers and writing the files) in the order they were queued by each thread. When the writer
+ * falls behind and the queue is full, the solving threads wait for a free slot, so that the results waiting to be
+ * written never grow without bound.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef ASYNC_WRITER_HPP
+#define ASYNC_WRITER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief Bounded multi-producer single-consumer queue.
+ *
+ * Every slot carries a sequence number telling whether it is free for the producer of a given lap or holds a value
+ * for the consumer: producers only compete (with a compare-and-swap) for the tail index, and neither side ever takes
+ * a lock.
+ */
+template <typename T>
+class MpscQueue {
+  public:
+    /**
+     * @brief Create an empty queue.
+     *
+     * @param capacity The minimum number of slots, rounded up to a power of two (and to at least two slots, since
+     * a published slot of a single-slot queue would look free to the producer of the next lap).
+     */
+    explicit MpscQueue(std::size_t capacity) {
+        std::size_t slots = 2;
+        while (slots < capacity) {
+            slots <<= 1;
+        }
+        this->cells = std::make_unique<Cell[]>(slots);
+        this->mask = slots - 1;
+        for (std::size_t i = 0; i < slots; ++i) {
+            this->cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    /**
+     * @brief Queue a value, unless the queue is full. Can be called from any thread.
+     *
+     * @param value The value, which is left untouched when the queue is full.
+     * @return true if the value was queued, false if the queue is full.
+     */
+    bool try_push(T& value) {
+        std::size_t position = this->tail.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = this->cells[position & this->mask];
+            std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto lap = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (lap == 0) {
+                if (this->tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                // the slot still holds the value of the previous lap
+                return false;
+            } else {
+                position = this->tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    /**
+     * @brief Take the oldest value, if any. Must only be called from the consumer thread.
+     *
+     * @param value Where to move the value.
+     * @return true if a value was taken, false if the queue is empty.
+     */
+    bool try_pop(T& value) {
+        Cell& cell = this->cells[this->head & this->mask];
+        if (cell.sequence.load(std::memory_order_acquire) != this->head + 1) {
+            return false;
+        }
+        value = std::move(cell.value);
+        cell.sequence.store(this->head + this->mask + 1, std::memory_order_release);
+        ++this->head;
+        return true;
+    }
+    /** @brief Number of slots of the queue. */
+    std::size_t capacity() const { return this->mask + 1; }
+
+  private:
+    /**
+     * @brief Slot of the queue.
+     *
+     */
+    struct Cell {
+        std::atomic<std::size_t> sequence;  //!< Position of the value, plus one once the value is published.
+        T value;                            //!< The queued value.
+    };
+    std::unique_ptr<Cell[]> cells;                 //!< The slots.
+    std::size_t mask = 0;                          //!< Number of slots minus one, to wrap the positions.
+    alignas(64) std::atomic<std::size_t> tail{0};  //!< Next position to be claimed by a producer.
+    alignas(64) std::size_t head = 0;              //!< Next position to be read by the consumer.
+};
+
+/**
+ * @brief Writer thread running the write jobs queued by one or more solving threads.
+ *
+ * Jobs queued by the same thread are run in order; the destructor runs the jobs still queued before joining the
+ * writer thread.
+ */
+class AsyncWriter {
+  public:
+    /**
+     * @brief Start the writer thread.
+     *
+     * @param capacity The number of jobs which can wait to be run before submit blocks.
+     */
+    explicit AsyncWriter(std::size_t capacity);
+    /**
+     * @brief Run the jobs which are still queued and join the writer thread.
+     *
+     */
+    ~AsyncWriter();
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+    /**
+     * @brief Queue a write job, waiting for a free slot if the writer thread has fallen behind.
+     *
+     * @param job The job to run on the writer thread.
+     */
+    void submit(std::function<void()> job);
+    /** @brief Number of jobs run so far. */
+    std::size_t written() const { return this->popped.load(std::memory_order_acquire); }
+
+  private:
+    friend class AsyncWriterTester;          //!< Friend test fixture class for unit testing.
+    MpscQueue<std::function<void()>> queue;  //!< Jobs waiting for the writer thread.
+    std::atomic<std::uint32_t> pushed{0};    //!< Jobs queued so far, waited on by the writer thread when idle.
+    std::atomic<std::uint32_t> popped{0};    //!< Jobs taken so far, waited on by the producers when full.
+    std::atomic<bool> stopping{false};       //!< Set by the destructor to let the writer thread return.
+    std::thread thread;                      //!< The writer thread.
+    /**
+     * @brief Loop run by the writer thread, running jobs until the writer is stopped and the queue is empty.
+     *
+     */
+    void work();
+};
+
+#endif  // ASYNC_WRITER_HPP
@@ -0,0 +1,125 @@
+/**
+ * @file batch.cpp
+ * @brief Implementation of the batch runner and of its summary rows.
+ *
+ * @author Saransh-cpp
+ */
+#include "batch.hpp"
+
+#include <charconv>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "text_format.hpp"
+#include "thread_pool.hpp"
+
+bool parse_batch_shard(const std::string& text, BatchShard& shard) {
+    auto slash = text.find('/');
+    if (slash == std::string::npos || slash == 0 || slash + 1 == text.size()) {
+        return false;
+    }
+    BatchShard parsed;
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    auto [index_end, index_ec] = std::from_chars(first, first + slash, parsed.index);
+    auto [count_end, count_ec] = std::from_chars(first + slash + 1, last, parsed.count);
+    if (index_ec != std::errc() || count_ec != std::errc() || index_end != first + slash || count_end != last ||
+        parsed.count == 0 || parsed.index >= parsed.count) {
+        return false;
+    }
+    shard = parsed;
+    return true;
+}
+
+std::size_t run_batch(std::size_t problems, const BatchShard& shard, std::size_t jobs,
+                      const std::function<BatchRow(std::size_t)>& solve, const std::function<void(BatchRow&)>& emit) {
+    std::size_t size = problems > shard.index ? (problems - shard.index + shard.count - 1) / shard.count : 0;
+    std::vector<std::optional<BatchRow>> rows(size);
+    std::mutex mutex;
+    std::condition_variable ready;
+
+    ThreadPool pool(jobs);
+    for (std::size_t k = 0; k < size; ++k) {
+        pool.submit([&, k] {
+            BatchRow row = solve(shard.index + k * shard.count);
+            {
+                std::lock_guard lock(mutex);
+                rows[k] = std::move(row);
+            }
+            ready.notify_one();
+        });
+    }
+
+    // the pool runs the problems in order, so a row rarely waits long for the ones before it
+    for (std::size_t k = 0; k < size; ++k) {
+        BatchRow row;
+        {
+            std::unique_lock lock(mutex);
+            ready.wait(lock, [&rows, k] { return rows[k].has_value(); });
+            row = std::move(*rows[k]);
+            rows[k].reset();
+        }
+        emit(row);
+    }
+    return size;
+}
+
+std::string batch_csv_header(char separator) {
+    std::string header;
+    for (const char* column : {"id", "name", "status", "root", "residual", "iterations", "evaluations", "seconds"}) {
+        if (!header.empty()) {
+            header += separator;
+        }
+        header += column;
+    }
+    return header + '\n';
+}
+
+void append_batch_csv(std::string& out, const BatchRow& row, char separator) {
+    out += std::to_string(row.id);
+    out += separator;
+    // names are quoted only when they could be mistaken for several columns
+    if (row.name.find_first_of(std::string{separator, '"', '\n'}) != std::string::npos) {
+        out += '"';
+        for (char character : row.name) {
+            out += character;
+            if (character == '"') {
+                out += '"';
+            }
+        }
+        out += '"';
+    } else {
+        out += row.name;
+    }
+    out += separator;
+    out += solver_status_name(row.status);
+    out += separator;
+    append_number(out, row.root);
+    out += separator;
+    append_number(out, row.residual);
+    out += separator;
+    out += std::to_string(row.iterations);
+    out += separator;
+    out += std::to_string(row.evaluations);
+    out += separator;
+    append_number(out, row.seconds);
+    out += '\n';
+}
+
+void append_batch_jsonl(std::string& out, const BatchRow& row) {
+    out += "{\"id\":" + std::to_string(row.id) + ",\"name\":";
+    append_json_string(out, row.name);
+    out += ",\"status\":\"";
+    out += solver_status_name(row.status);
+    out += "\",\"root\":";
+    append_json_number(out, row.root);
+    out += ",\"residual\":";
+    append_json_number(out, row.residual);
+    out += ",\"iterations\":" + std::to_string(row.iterations);
+    out += ",\"evaluations\":" + std::to_string(row.evaluations);
+    out += ",\"seconds\":";
+    append_json_number(out, row.seconds);
+    out += "}\n";
+}
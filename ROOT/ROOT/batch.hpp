@@ -0,0 +1,94 @@
+/**
+ * @file batch.hpp
+ * @brief Parallel, shardable execution of a batch of problems, summarized with one row per problem.
+ *
+ * A workload is split across processes (or hosts) with shards: shard i of N takes the problems whose index modulo
+ * N is i, so that problems of similar cost sitting next to each other in the input are spread over every shard.
+ * Inside a process, the problems of the shard are solved by a pool of threads, and their rows are handed over in
+ * the order of the input as soon as every preceding row is ready.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <libROOT/method.hpp>
+#include <string>
+
+/**
+ * @brief A shard of a batch: the problems whose index modulo count is index.
+ *
+ */
+struct BatchShard {
+    std::size_t index = 0;  //!< The position of the shard, from 0 to count - 1.
+    std::size_t count = 1;  //!< The number of shards the batch is split into.
+};
+
+/**
+ * @brief Summary of one solved problem of a batch.
+ *
+ */
+struct BatchRow {
+    std::uint64_t id = 0;                           //!< Index of the problem in the whole batch.
+    std::string name;                               //!< Name of the problem, possibly empty.
+    SolverStatus status = SolverStatus::CONVERGED;  //!< How the solving process ended.
+    double root = 0.0;                              //!< The last estimate of the root.
+    double residual = 0.0;                          //!< The absolute value of the function at the root.
+    int iterations = 0;                             //!< Number of iterations performed.
+    long evaluations = 0;                           //!< Number of function evaluations performed.
+    double seconds = 0.0;                           //!< Wall-clock time spent solving the problem.
+    Eigen::MatrixX2d results;                       //!< Results of the solver, kept for the outputs which need them.
+};
+
+/**
+ * @brief Parse a shard written as "i/N", with 0 <= i < N.
+ *
+ * @param text The shard description.
+ * @param shard The parsed shard, left untouched if the description is invalid.
+ * @return true if the description is valid, false otherwise.
+ */
+bool parse_batch_shard(const std::string& text, BatchShard& shard);
+
+/**
+ * @brief Solve the problems of a shard on a pool of threads and hand their rows over in the order of the input.
+ *
+ * @param problems The number of problems of the whole batch.
+ * @param shard The shard to solve.
+ * @param jobs The number of threads solving problems.
+ * @param solve Solves the problem with a given index and summarizes it; called concurrently by the threads.
+ * @param emit Receives the rows one at a time, in increasing order of index, on the calling thread.
+ * @return The number of problems of the shard.
+ */
+std::size_t run_batch(std::size_t problems, const BatchShard& shard, std::size_t jobs,
+                      const std::function<BatchRow(std::size_t)>& solve, const std::function<void(BatchRow&)>& emit);
+
+/**
+ * @brief The header line of a CSV summary.
+ *
+ * @param separator The separator character of the columns.
+ * @return The header, ended by a newline.
+ */
+std::string batch_csv_header(char separator);
+
+/**
+ * @brief Append a row to a CSV summary.
+ *
+ * @param out The text to append to.
+ * @param row The row to write, ended by a newline.
+ * @param separator The separator character of the columns.
+ */
+void append_batch_csv(std::string& out, const BatchRow& row, char separator);
+
+/**
+ * @brief Append a row to a JSON Lines summary, as one object.
+ *
+ * @param out The text to append to.
+ * @param row The row to write, ended by a newline.
+ */
+void append_batch_jsonl(std::string& out, const BatchRow& row);
+
+#endif  // BATCH_HPP
@@ -0,0 +1,202 @@
+#include "binary_format.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <libROOT/method.hpp>
+#include <string>
+
+static_assert(std::endian::native == std::endian::little, "the binary batch format assumes a little-endian host");
+
+BinaryBatchView::BinaryBatchView(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "\033[31mBinaryBatchView: failed to open file: " << filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(BinaryBatchHeader)) {
+        ::close(fd);
+        std::cerr << "\033[31mBinaryBatchView: file too small to be a binary batch: " << filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    this->length = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "\033[31mBinaryBatchView: failed to map file: " << filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    this->data = static_cast<const std::byte*>(mapping);
+    this->header = reinterpret_cast<const BinaryBatchHeader*>(this->data);  // NOLINT
+
+    if (!this->validate()) {
+        std::cerr << "\033[31mBinaryBatchView: malformed binary batch file: " << filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+BinaryBatchView::~BinaryBatchView() {
+    if (this->data != nullptr) {
+        ::munmap(const_cast<std::byte*>(this->data), this->length);  // NOLINT
+    }
+}
+
+bool BinaryBatchView::validate() const {
+    if (std::memcmp(this->header->magic, binary_batch_magic, sizeof(binary_batch_magic)) != 0 ||
+        this->header->version != binary_batch_version) {
+        return false;
+    }
+
+    std::uint64_t problems = this->header->problems;
+    auto fits = [this, problems](std::uint64_t offset, std::uint64_t width) {
+        return offset % 8 == 0 && offset >= sizeof(BinaryBatchHeader) && offset <= this->length &&
+               problems <= (this->length - offset) / width;
+    };
+    if (!fits(this->header->method_offset, sizeof(std::int32_t)) ||
+        !fits(this->header->tolerance_offset, sizeof(double)) ||
+        !fits(this->header->max_iter_offset, sizeof(std::int32_t)) ||
+        !fits(this->header->aitken_offset, sizeof(std::uint8_t)) ||
+        !fits(this->header->first_offset, sizeof(double)) || !fits(this->header->second_offset, sizeof(double)) ||
+        !fits(this->header->function_offset, sizeof(std::uint32_t)) ||
+        !fits(this->header->auxiliary_offset, sizeof(std::uint32_t))) {
+        return false;
+    }
+
+    // the dictionary holds strings + 1 offsets, the last one being the size of the string data
+    std::uint64_t idx_offset = this->header->string_idx_offset;
+    if (idx_offset % 8 != 0 || idx_offset > this->length ||
+        this->header->strings >= (this->length - idx_offset) / sizeof(std::uint64_t)) {
+        return false;
+    }
+    // the rows and the dictionary entries are checked when they are read (see check_row), so that opening a file
+    // costs the same whatever its number of problems
+    const auto* string_offsets = reinterpret_cast<const std::uint64_t*>(this->data + idx_offset);  // NOLINT
+    std::uint64_t data_offset = this->header->string_data_offset;
+    return data_offset <= this->length && string_offsets[this->header->strings] <= this->length - data_offset;
+}
+
+bool BinaryBatchView::check_expression(std::uint32_t index) const {
+    if (index >= this->header->strings) {
+        return false;
+    }
+    const auto* string_offsets =
+        reinterpret_cast<const std::uint64_t*>(this->data + this->header->string_idx_offset);  // NOLINT
+    return string_offsets[index] <= string_offsets[index + 1] &&
+           string_offsets[index + 1] <= string_offsets[this->header->strings];
+}
+
+bool BinaryBatchView::check_row(std::size_t row, std::string& error) const {
+    if (row >= this->size()) {
+        error = "is out of the batch";
+        return false;
+    }
+    std::int32_t method = this->method()[row];
+    if (method != Method::BISECTION && method != Method::CHORDS && method != Method::NEWTON &&
+        method != Method::FIXED_POINT) {
+        error = "has unknown method " + std::to_string(method);
+        return false;
+    }
+    std::uint32_t auxiliary = this->auxiliary()[row];
+    if (auxiliary == binary_batch_no_function && (method == Method::NEWTON || method == Method::FIXED_POINT)) {
+        error = "requires a derivative or g-function";
+        return false;
+    }
+    if (!this->check_expression(this->function()[row]) ||
+        (auxiliary != binary_batch_no_function && !this->check_expression(auxiliary))) {
+        error = "references a missing or malformed expression";
+        return false;
+    }
+    if (this->max_iterations()[row] <= 0) {
+        error = "has non-positive max_iterations " + std::to_string(this->max_iterations()[row]);
+        return false;
+    }
+    // written as a negation so that NaN is rejected as well
+    if (!(this->tolerance()[row] > 0.0)) {
+        error = "has non-positive tolerance " + std::to_string(this->tolerance()[row]);
+        return false;
+    }
+    return true;
+}
+
+std::string_view BinaryBatchView::expression(std::uint32_t index) const {
+    const auto* string_offsets =
+        reinterpret_cast<const std::uint64_t*>(this->data + this->header->string_idx_offset);  // NOLINT
+    const auto* string_data = reinterpret_cast<const char*>(this->data + this->header->string_data_offset);  // NOLINT
+    return {string_data + string_offsets[index], string_offsets[index + 1] - string_offsets[index]};
+}
+
+void write_binary_batch(const std::string& filename, const BinaryBatchColumns& columns) {
+    std::size_t problems = columns.method.size();
+    if (columns.tolerance.size() != problems || columns.max_iterations.size() != problems ||
+        columns.aitken.size() != problems || columns.first.size() != problems || columns.second.size() != problems ||
+        columns.function.size() != problems || columns.auxiliary.size() != problems) {
+        std::cerr << "\033[31mwrite_binary_batch: columns have different lengths\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "\033[31mError: could not open file " << filename << " for writing.\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    BinaryBatchHeader header{};
+    std::memcpy(header.magic, binary_batch_magic, sizeof(binary_batch_magic));
+    header.version = binary_batch_version;
+    header.problems = problems;
+    header.strings = columns.expressions.size();
+
+    // lay out the sections one after the other, each one starting at an 8-byte boundary
+    std::uint64_t offset = sizeof(BinaryBatchHeader);
+    auto place = [&offset](std::uint64_t& section_offset, std::uint64_t bytes) {
+        section_offset = offset;
+        offset = (offset + bytes + 7) / 8 * 8;
+    };
+    place(header.method_offset, problems * sizeof(std::int32_t));
+    place(header.tolerance_offset, problems * sizeof(double));
+    place(header.max_iter_offset, problems * sizeof(std::int32_t));
+    place(header.aitken_offset, problems * sizeof(std::uint8_t));
+    place(header.first_offset, problems * sizeof(double));
+    place(header.second_offset, problems * sizeof(double));
+    place(header.function_offset, problems * sizeof(std::uint32_t));
+    place(header.auxiliary_offset, problems * sizeof(std::uint32_t));
+    place(header.string_idx_offset, (columns.expressions.size() + 1) * sizeof(std::uint64_t));
+    header.string_data_offset = offset;
+
+    std::vector<std::uint64_t> string_offsets;
+    string_offsets.reserve(columns.expressions.size() + 1);
+    std::uint64_t string_length = 0;
+    for (const auto& expression : columns.expressions) {
+        string_offsets.push_back(string_length);
+        string_length += expression.size();
+    }
+    string_offsets.push_back(string_length);
+
+    auto write_section = [&file](std::uint64_t section_offset, const void* bytes, std::size_t size) {
+        static constexpr char padding[8] = {};
+        auto position = static_cast<std::uint64_t>(file.tellp());
+        file.write(padding, static_cast<std::streamsize>(section_offset - position));
+        file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));  // NOLINT
+    write_section(header.method_offset, columns.method.data(), problems * sizeof(std::int32_t));
+    write_section(header.tolerance_offset, columns.tolerance.data(), problems * sizeof(double));
+    write_section(header.max_iter_offset, columns.max_iterations.data(), problems * sizeof(std::int32_t));
+    write_section(header.aitken_offset, columns.aitken.data(), problems * sizeof(std::uint8_t));
+    write_section(header.first_offset, columns.first.data(), problems * sizeof(double));
+    write_section(header.second_offset, columns.second.data(), problems * sizeof(double));
+    write_section(header.function_offset, columns.function.data(), problems * sizeof(std::uint32_t));
+    write_section(header.auxiliary_offset, columns.auxiliary.data(), problems * sizeof(std::uint32_t));
+    write_section(header.string_idx_offset, string_offsets.data(), string_offsets.size() * sizeof(std::uint64_t));
+    file.seekp(static_cast<std::streamoff>(header.string_data_offset));
+    for (const auto& expression : columns.expressions) {
+        file.write(expression.data(), static_cast<std::streamsize>(expression.size()));
+    }
+}
@@ -0,0 +1,188 @@
+/**
+ * @file binary_format.hpp
+ * @brief Columnar binary input format for batches of root-finding problems.
+ *
+ * The format stores every problem parameter as a fixed-width column, so that a file can be memory-mapped and
+ * read without any parsing. All values are little-endian and every section starts at an 8-byte aligned offset
+ * (measured from the beginning of the file). A file is laid out as:
+ *
+ * | Section            | Type                    | Content                                                      |
+ * |--------------------|-------------------------|--------------------------------------------------------------|
+ * | header             | BinaryBatchHeader       | magic, version, counts and the offsets of the sections below |
+ * | method             | int32[problems]         | Method enumeration value                                     |
+ * | tolerance          | float64[problems]       | Tolerance for convergence                                    |
+ * | max_iterations     | int32[problems]         | Maximum number of iterations                                 |
+ * | aitken             | uint8[problems]         | 1 if Aitken acceleration is enabled, 0 otherwise             |
+ * | first              | float64[problems]       | initial guess (newton, fixed_point), x0 or interval_a        |
+ * | second             | float64[problems]       | x1 or interval_b (ignored by newton and fixed_point)         |
+ * | function           | uint32[problems]        | dictionary index of the function                             |
+ * | auxiliary          | uint32[problems]        | dictionary index of the derivative or g-function, or none    |
+ * | string offsets     | uint64[strings + 1]     | offsets of the dictionary entries inside the string data     |
+ * | string data        | char[]                  | concatenated expression strings (not null-terminated)        |
+ *
+ * Expressions are stored once in the dictionary and referenced by index, so a batch sweeping the same function
+ * over many initial guesses stores (and parses) the expression a single time.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef BINARY_FORMAT_HPP
+#define BINARY_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Fixed-size header at the beginning of a columnar binary batch file.
+ *
+ */
+struct BinaryBatchHeader {
+    char magic[8];                     //!< File signature, always "ROOTBIN" followed by a null byte.
+    std::uint32_t version;             //!< Version of the format (currently 1).
+    std::uint32_t reserved;            //!< Reserved for future use, always 0.
+    std::uint64_t problems;            //!< Number of problems (rows) stored in every column.
+    std::uint64_t strings;             //!< Number of entries in the expression dictionary.
+    std::uint64_t method_offset;       //!< Offset of the method column.
+    std::uint64_t tolerance_offset;    //!< Offset of the tolerance column.
+    std::uint64_t max_iter_offset;     //!< Offset of the max_iterations column.
+    std::uint64_t aitken_offset;       //!< Offset of the aitken column.
+    std::uint64_t first_offset;        //!< Offset of the first initial value column.
+    std::uint64_t second_offset;       //!< Offset of the second initial value column.
+    std::uint64_t function_offset;     //!< Offset of the function index column.
+    std::uint64_t auxiliary_offset;    //!< Offset of the auxiliary function index column.
+    std::uint64_t string_idx_offset;   //!< Offset of the dictionary offsets.
+    std::uint64_t string_data_offset;  //!< Offset of the dictionary string data.
+};
+
+/** @brief Version of the format written and accepted by ROOT. */
+constexpr std::uint32_t binary_batch_version = 1;
+/** @brief Auxiliary function index marking problems without a derivative or g-function. */
+constexpr std::uint32_t binary_batch_no_function = 0xFFFFFFFFU;
+/** @brief Signature at the start of every columnar binary batch file. */
+constexpr char binary_batch_magic[8] = {'R', 'O', 'O', 'T', 'B', 'I', 'N', '\0'};
+
+/**
+ * @brief Owning columns of a batch, used to produce columnar binary files.
+ *
+ */
+struct BinaryBatchColumns {
+    std::vector<std::int32_t> method;          //!< Method of each problem.
+    std::vector<double> tolerance;             //!< Tolerance of each problem.
+    std::vector<std::int32_t> max_iterations;  //!< Maximum iterations of each problem.
+    std::vector<std::uint8_t> aitken;          //!< Aitken flag of each problem.
+    std::vector<double> first;                 //!< First initial value of each problem.
+    std::vector<double> second;                //!< Second initial value of each problem.
+    std::vector<std::uint32_t> function;       //!< Dictionary index of the function of each problem.
+    std::vector<std::uint32_t> auxiliary;      //!< Dictionary index of the auxiliary function of each problem.
+    std::vector<std::string> expressions;      //!< The expression dictionary.
+};
+
+/**
+ * @brief Read-only, memory-mapped view over a columnar binary batch file.
+ *
+ * The columns are exposed as spans pointing directly into the mapping; nothing is copied or parsed.
+ */
+class BinaryBatchView {
+  public:
+    /**
+     * @brief Map a columnar binary batch file and validate its header and the bounds of its sections.
+     *
+     * The rows are not scanned: check_row validates a row before it is used.
+     *
+     * @param filename The path of the file to map.
+     */
+    explicit BinaryBatchView(const std::string& filename);
+    /**
+     * @brief Unmap the file.
+     *
+     */
+    ~BinaryBatchView();
+    BinaryBatchView(const BinaryBatchView&) = delete;
+    BinaryBatchView& operator=(const BinaryBatchView&) = delete;
+
+    /** @brief Number of problems stored in the file. */
+    std::size_t size() const { return this->header->problems; }
+    /** @brief Number of entries in the expression dictionary. */
+    std::size_t strings() const { return this->header->strings; }
+    /** @brief The method column. */
+    std::span<const std::int32_t> method() const { return column<std::int32_t>(this->header->method_offset); }
+    /** @brief The tolerance column. */
+    std::span<const double> tolerance() const { return column<double>(this->header->tolerance_offset); }
+    /** @brief The max_iterations column. */
+    std::span<const std::int32_t> max_iterations() const {
+        return column<std::int32_t>(this->header->max_iter_offset);
+    }
+    /** @brief The aitken column. */
+    std::span<const std::uint8_t> aitken() const { return column<std::uint8_t>(this->header->aitken_offset); }
+    /** @brief The first initial value column. */
+    std::span<const double> first() const { return column<double>(this->header->first_offset); }
+    /** @brief The second initial value column. */
+    std::span<const double> second() const { return column<double>(this->header->second_offset); }
+    /** @brief The function index column. */
+    std::span<const std::uint32_t> function() const { return column<std::uint32_t>(this->header->function_offset); }
+    /** @brief The auxiliary function index column. */
+    std::span<const std::uint32_t> auxiliary() const {
+        return column<std::uint32_t>(this->header->auxiliary_offset);
+    }
+    /**
+     * @brief Check that a row describes a problem which can be solved.
+     *
+     * The method must be bisection, chords, newton or fixed_point, the latter two with an auxiliary function, the
+     * row must reference well-formed entries of the expression dictionary, max_iterations must be positive, and the
+     * tolerance must be a positive number.
+     *
+     * @param row The index of the problem.
+     * @param error The reason why the row is rejected, left untouched otherwise.
+     * @return true if the row can be solved, false otherwise.
+     */
+    bool check_row(std::size_t row, std::string& error) const;
+    /**
+     * @brief Check that an entry of the expression dictionary lies inside the string data.
+     *
+     * @param index The dictionary index.
+     * @return true if the entry can be read with expression, false otherwise.
+     */
+    bool check_expression(std::uint32_t index) const;
+    /**
+     * @brief Access an entry of the expression dictionary.
+     *
+     * @param index The dictionary index, which must have passed check_expression.
+     * @return A view of the expression string, pointing into the mapping.
+     */
+    std::string_view expression(std::uint32_t index) const;
+
+  private:
+    friend class BinaryBatchTester;             //!< Friend test fixture class for unit testing.
+    const std::byte* data = nullptr;            //!< Start of the mapping.
+    std::size_t length = 0;                     //!< Length of the mapping in bytes.
+    const BinaryBatchHeader* header = nullptr;  //!< The header at the start of the mapping.
+    /**
+     * @brief Helper method to view a column stored at a given offset.
+     *
+     * @param offset The offset of the column from the start of the file.
+     * @return A span of size() elements.
+     */
+    template <typename T>
+    std::span<const T> column(std::uint64_t offset) const {
+        return {reinterpret_cast<const T*>(this->data + offset), this->size()};  // NOLINT
+    }
+    /**
+     * @brief Helper method to check the header and that every section of the file lies inside the mapping.
+     *
+     * @return true if the file is well-formed, false otherwise.
+     */
+    bool validate() const;
+};
+
+/**
+ * @brief Write a batch in the columnar binary format.
+ *
+ * @param filename The path of the file to write.
+ * @param columns The columns to write; every per-problem column must have the same length.
+ */
+void write_binary_batch(const std::string& filename, const BinaryBatchColumns& columns);
+
+#endif  // BINARY_FORMAT_HPP
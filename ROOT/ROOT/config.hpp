@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <libROOT/method.hpp>
+#include <string>
 
 /**
  * @brief Base (shared) configuration (data) class for root-finding methods.
@@ -37,6 +38,9 @@ class ConfigBase {
     bool aitken;                             //!< Indicates whether Aitken acceleration is enabled.
     bool verbose;                            //!< Indicates whether verbose output is enabled.
     std::function<double(double)> function;  //!< The function for which the root is to be found.
+    std::string name;                        //!< Optional name of the problem (e.g. a DAT section header).
+    double time_limit = 0.0;                 //!< Wall-clock seconds allowed to the solving process, 0 for no limit.
+    long max_evaluations = 0;                //!< Function evaluations allowed to the solving process, 0 for no limit.
 };
 
 /**
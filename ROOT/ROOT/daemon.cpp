@@ -0,0 +1,235 @@
+#include "daemon.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "text_format.hpp"
+
+namespace {
+
+/**
+ * @brief Fill a Unix domain socket address, exiting if the path does not fit.
+ *
+ * @param socket_path The path of the socket.
+ * @return The socket address.
+ */
+sockaddr_un make_address(const std::string& socket_path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "\033[31mSolverDaemon: socket path too long: " << socket_path << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+    return address;
+}
+
+bool read_exactly(int fd, char* bytes, std::size_t size) {
+    while (size > 0) {
+        ssize_t count = ::recv(fd, bytes, size, 0);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        bytes += count;
+        size -= static_cast<std::size_t>(count);
+    }
+    return true;
+}
+
+bool write_exactly(int fd, const char* bytes, std::size_t size) {
+    while (size > 0) {
+        // MSG_NOSIGNAL: a client going away must not kill the daemon with SIGPIPE
+        ssize_t count = ::send(fd, bytes, size, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        bytes += count;
+        size -= static_cast<std::size_t>(count);
+    }
+    return true;
+}
+
+}  // namespace
+
+bool read_frame(int fd, std::string& payload) {
+    std::array<unsigned char, 4> prefix{};
+    if (!read_exactly(fd, reinterpret_cast<char*>(prefix.data()), prefix.size())) {  // NOLINT
+        return false;
+    }
+    std::uint32_t length = static_cast<std::uint32_t>(prefix[0]) | static_cast<std::uint32_t>(prefix[1]) << 8U |
+                           static_cast<std::uint32_t>(prefix[2]) << 16U | static_cast<std::uint32_t>(prefix[3]) << 24U;
+    if (length > daemon_max_frame) {
+        return false;
+    }
+    payload.resize(length);
+    return read_exactly(fd, payload.data(), length);
+}
+
+bool write_frame(int fd, std::string_view payload) {
+    auto length = static_cast<std::uint32_t>(payload.size());
+    // the prefix and a short payload are sent in a single call, so that a request is one packet on the wire
+    std::string frame;
+    frame.reserve(4 + payload.size());
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+        frame.push_back(static_cast<char>((length >> shift) & 0xFFU));
+    }
+    frame.append(payload);
+    return write_exactly(fd, frame.data(), frame.size());
+}
+
+std::string daemon_error(const std::string& message) {
+    std::string out = "{\"error\":";
+    append_json_string(out, message);
+    out += '}';
+    return out;
+}
+
+int connect_daemon(const std::string& socket_path) {
+    sockaddr_un address = make_address(socket_path);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {  // NOLINT
+        std::cerr << "\033[31mError: could not connect to daemon at " << socket_path << ": " << std::strerror(errno)
+                  << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    return fd;
+}
+
+SolverDaemon::SolverDaemon(const std::string& socket_path, std::size_t threads, Handler handler)
+    : socket_path(socket_path), handler(std::move(handler)), pool(threads) {
+    sockaddr_un address = make_address(socket_path);
+    // non-blocking: a client giving up between poll and accept must not block serve
+    this->listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (this->listen_fd < 0 || ::pipe2(this->wake.data(), O_CLOEXEC | O_NONBLOCK) != 0) {
+        std::cerr << "\033[31mSolverDaemon: failed to create socket: " << std::strerror(errno) << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    // a socket file left behind by a previous daemon would make bind fail
+    ::unlink(socket_path.c_str());
+    if (::bind(this->listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||  // NOLINT
+        ::listen(this->listen_fd, SOMAXCONN) != 0) {
+        std::cerr << "\033[31mSolverDaemon: failed to listen on " << socket_path << ": " << std::strerror(errno)
+                  << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+SolverDaemon::~SolverDaemon() {
+    this->stop();
+    ::close(this->listen_fd);
+    ::close(this->wake[0]);
+    ::close(this->wake[1]);
+    ::unlink(this->socket_path.c_str());
+}
+
+void SolverDaemon::serve() {
+    std::vector<pollfd> polled;
+    while (!this->stopping) {
+        polled.assign({{this->listen_fd, POLLIN, 0}, {this->wake[0], POLLIN, 0}});
+        {
+            std::lock_guard lock(this->connections_mutex);
+            for (int fd : this->idle) {
+                polled.push_back({fd, POLLIN, 0});
+            }
+        }
+        if (::poll(polled.data(), polled.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (polled[1].revents != 0) {
+            std::array<char, 64> bytes{};
+            while (::read(this->wake[0], bytes.data(), bytes.size()) > 0) {
+            }
+        }
+        if (polled[0].revents != 0 && !this->stopping) {
+            int fd = ::accept4(this->listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0) {
+                std::lock_guard lock(this->connections_mutex);
+                this->connections.insert(fd);
+                this->idle.insert(fd);
+            } else if (errno != EINTR && errno != ECONNABORTED && errno != EAGAIN) {
+                break;
+            }
+        }
+        // a readable connection has a request (or its end) waiting: it is not polled again until answered
+        for (std::size_t i = 2; i < polled.size(); ++i) {
+            if (polled[i].revents == 0) {
+                continue;
+            }
+            int fd = polled[i].fd;
+            {
+                std::lock_guard lock(this->connections_mutex);
+                this->idle.erase(fd);
+                ++this->in_flight;
+            }
+            this->pool.submit([this, fd] { this->serve_request(fd); });
+        }
+    }
+    std::unique_lock lock(this->connections_mutex);
+    this->settled.wait(lock, [this] { return this->in_flight == 0; });
+    for (int fd : this->idle) {
+        this->connections.erase(fd);
+        ::close(fd);
+    }
+    this->idle.clear();
+}
+
+void SolverDaemon::stop() {
+    if (this->stopping.exchange(true)) {
+        return;
+    }
+    ::shutdown(this->listen_fd, SHUT_RDWR);
+    // wake up the workers blocked on a connection, they close the sockets themselves, and serve
+    std::lock_guard lock(this->connections_mutex);
+    for (int fd : this->connections) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+    this->wake_up();
+}
+
+void SolverDaemon::serve_request(int fd) {
+    std::string request;
+    bool open = !this->stopping && read_frame(fd, request);
+    if (open && request.empty()) {
+        this->stop();
+        open = false;
+    }
+    if (open) {
+        open = write_frame(fd, this->handler(request));
+    }
+    std::lock_guard lock(this->connections_mutex);
+    if (open && !this->stopping) {
+        this->idle.insert(fd);
+    } else {
+        this->connections.erase(fd);
+        ::close(fd);
+    }
+    // serve waits for in_flight to drop to zero before returning, so the pipe is still open here
+    this->wake_up();
+    --this->in_flight;
+    this->settled.notify_all();
+}
+
+void SolverDaemon::wake_up() const {
+    char byte = 0;
+    // a full pipe already wakes serve up, so a failed write is harmless
+    [[maybe_unused]] ssize_t written = ::write(this->wake[1], &byte, 1);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file daemon.hpp
+ * @brief Persistent solver daemon serving framed requests over a Unix domain socket.
+ *
+ * Every message exchanged with the daemon is a frame: a 4-byte little-endian payload length followed by the
+ * payload. A request payload holds one problem as a flat JSON object (the JSON Lines input format), and the
+ * daemon answers every request with exactly one frame, in request order, holding either the result object written
+ * by the JSON Lines printer or an `{"error": ...}` object. An empty request frame asks the daemon to shut down.
+ *
+ * The daemon keeps its state (e.g. the cache of parsed functions and the thread pool) alive between requests, so
+ * that a request only pays for the solve itself. Requests rather than connections are scheduled on the worker threads
+ * of the pool: serve polls the idle connections and queues one task per request received, so that any number of
+ * clients can stay connected while at most `threads` requests are answered at once. Every connection can send any
+ * number of requests, answered one at a time and in order.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef DAEMON_HPP
+#define DAEMON_HPP
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include "thread_pool.hpp"
+
+/** @brief Largest payload accepted in a single frame (1 MiB). */
+constexpr std::uint32_t daemon_max_frame = 1U << 20;
+
+/**
+ * @brief Read a whole frame from a socket.
+ *
+ * @param fd The socket to read from.
+ * @param payload A reference to store the payload of the frame.
+ * @return true if a frame was read, false if the peer closed the connection or sent an oversized frame.
+ */
+bool read_frame(int fd, std::string& payload);
+
+/**
+ * @brief Write a whole frame on a socket.
+ *
+ * @param fd The socket to write on.
+ * @param payload The payload of the frame.
+ * @return true if the frame was written, false if the peer closed the connection.
+ */
+bool write_frame(int fd, std::string_view payload);
+
+/**
+ * @brief Build the error object sent back for a rejected request.
+ *
+ * @param message The reason why the request was rejected.
+ * @return The JSON object `{"error": message}`.
+ */
+std::string daemon_error(const std::string& message);
+
+/**
+ * @brief Connect to a running daemon.
+ *
+ * @param socket_path The path of the Unix domain socket the daemon listens on.
+ * @return The connected socket.
+ */
+int connect_daemon(const std::string& socket_path);
+
+/**
+ * @brief Daemon listening on a Unix domain socket and answering requests with a handler.
+ *
+ */
+class SolverDaemon {
+  public:
+    /**
+     * @brief Type of the function turning a request payload into a response payload.
+     *
+     * The handler is called concurrently from the worker threads.
+     */
+    using Handler = std::function<std::string(const std::string&)>;
+    /**
+     * @brief Bind and listen on a Unix domain socket (an existing socket file is replaced).
+     *
+     * @param socket_path The path of the socket.
+     * @param threads The number of worker threads, i.e. of requests answered concurrently.
+     * @param handler The function answering every request.
+     */
+    SolverDaemon(const std::string& socket_path, std::size_t threads, Handler handler);
+    /**
+     * @brief Close the socket and remove the socket file.
+     *
+     */
+    ~SolverDaemon();
+    SolverDaemon(const SolverDaemon&) = delete;
+    SolverDaemon& operator=(const SolverDaemon&) = delete;
+    /**
+     * @brief Accept connections and dispatch their requests to the pool until the daemon is stopped.
+     *
+     * Returns once the requests already dispatched have been answered.
+     */
+    void serve();
+    /**
+     * @brief Stop accepting connections and close the open ones (safe to call from any thread).
+     *
+     */
+    void stop();
+
+  private:
+    friend class SolverDaemonTester;      //!< Friend test fixture class for unit testing.
+    std::string socket_path;              //!< The path of the socket file.
+    Handler handler;                      //!< The function answering every request.
+    int listen_fd = -1;                   //!< The listening socket.
+    std::array<int, 2> wake{-1, -1};      //!< Pipe waking serve up when a connection is idle again or on stop.
+    std::atomic<bool> stopping = false;   //!< Set once the daemon has been asked to stop.
+    std::mutex connections_mutex;         //!< Guards connections, idle and in_flight.
+    std::condition_variable settled;      //!< Notified whenever a request has been answered.
+    std::unordered_set<int> connections;  //!< The open connections, closed when the daemon stops.
+    std::unordered_set<int> idle;         //!< The connections waiting for their next request, polled by serve.
+    std::size_t in_flight = 0;            //!< The requests queued on or being answered by the pool.
+    ThreadPool pool;                      //!< Worker threads answering the requests, joined first on destruction.
+    /**
+     * @brief Answer one request of a connection and hand the connection back to serve (or close it).
+     *
+     * @param fd The connected socket, readable.
+     */
+    void serve_request(int fd);
+    /**
+     * @brief Wake serve up from its poll.
+     *
+     */
+    void wake_up() const;
+};
+
+#endif  // DAEMON_HPP
@@ -3,23 +3,53 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <complex>
 #include <functional>
 #include <iostream>
+#include <libROOT/scalar.hpp>
+#include <mutex>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
-FunctionParserBase::FunctionParserBase(std::string function_str) : function_str(std::move(function_str)) {}
+namespace {
+
+/** @brief Raise x to a non-negative integer power; complex powers are computed by repeated squaring, since std::pow
+ * goes through a logarithm for them and leaves an imaginary residue on the real line. */
+template <typename Scalar>
+Scalar integerPower(const Scalar& var, int power) {
+    if constexpr (is_complex_v<Scalar>) {
+        Scalar result = 1.0;
+        Scalar square = var;
+        for (unsigned n = static_cast<unsigned>(power); n != 0; n >>= 1) {
+            if (n & 1U) {
+                result *= square;
+            }
+            square *= square;
+        }
+        return result;
+    } else {
+        using std::pow;
+        return pow(var, power);
+    }
+}
 
-inline bool FunctionParserBase::isPolynomial(const std::string& expression) {
+}  // namespace
+
+FunctionParserBase::FunctionParserBase(std::string function_str, FunctionParameters parameters)
+    : function_str(std::move(function_str)), parameters(std::move(parameters)) {}
+
+bool FunctionParserBase::isPolynomial(const std::string& expression) {
     if (expression.empty()) {
         return false;
     }
     return icontains(expression, "x") && !icontains(expression, "sin") && !icontains(expression, "cos");
 }
 
-inline bool FunctionParserBase::isTrigonometric(const std::string& expression) {
+bool FunctionParserBase::isTrigonometric(const std::string& expression) {
     if (expression.empty()) {
         return false;
     }
@@ -63,21 +93,99 @@ std::vector<std::string> FunctionParserBase::splitSignTokens(const std::string&
     return tokens;
 }
 
-std::pair<double, std::string> FunctionParserBase::parseOptionalCoefficient(const std::string& token) {
+template <typename Scalar>
+Scalar FunctionParserBase::parseNumber(const std::string& text) {
+    if constexpr (std::is_same_v<Scalar, float>) {
+        return std::stof(text);
+    } else if constexpr (std::is_same_v<Scalar, double>) {
+        return std::stod(text);
+    } else if constexpr (is_complex_v<Scalar>) {
+        return Scalar(parseNumber<typename Scalar::value_type>(text));
+    } else if constexpr (std::is_same_v<Scalar, DoubleDouble>) {
+        // a long double only holds 64 of the 106 bits of a DoubleDouble: the digits are accumulated in DoubleDouble
+        // arithmetic instead (exactly, up to 31 of them) and the fraction is applied by dividing by a power of ten
+        Scalar value = 0.0;
+        int decimals = 0;
+        bool fraction = false;
+        for (char character : text) {
+            if (character == '.') {
+                fraction = true;
+            } else if (std::isdigit(static_cast<unsigned char>(character)) != 0) {
+                value = value * 10.0 + (character - '0');
+                decimals += fraction ? 1 : 0;
+            } else if (character != '+' && character != '-') {
+                throw std::invalid_argument("parseNumber: not a decimal number: " + text);
+            }
+        }
+        value = decimals > 0 ? value / pow(Scalar(10.0), decimals) : value;
+        return text.starts_with('-') ? -value : value;
+    } else {
+        // long double is read directly, its 64-bit mantissa holds every coefficient written with 19 digits
+        return std::stold(text);
+    }
+}
+
+template <typename Scalar>
+std::pair<Scalar, std::string> FunctionParserBase::parseOptionalCoefficient(const std::string& token) {
     std::regex coeff_regex(R"(^([+-]?[0-9]*\.?[0-9]+)\*?(.*)$)");
     std::smatch match;
 
     if (std::regex_match(token, match, coeff_regex)) {
-        double coeff = std::stod(match[1]);
+        Scalar coeff = parseNumber<Scalar>(match[1]);
         std::string rest = match[2];
         return {coeff, rest};
     }
-    return {1.0, token};
+    return {Scalar(1), token};
+}
+
+template <typename Scalar>
+bool FunctionParserBase::parseParameterTerm(const std::string& token, TokenParser<Scalar> parse_token,
+                                            std::function<Scalar(Scalar)>& out_term) const {
+    if (token.empty()) {
+        return false;
+    }
+    std::string sign = token[0] == '+' || token[0] == '-' ? token.substr(0, 1) : "";
+
+    // split the factors of the term between the parameters and the rest of the term
+    std::vector<std::shared_ptr<double>> factors;
+    std::string rest;
+    std::stringstream body(token.substr(sign.size()));
+    for (std::string factor; std::getline(body, factor, '*');) {
+        auto parameter = this->parameters.find(factor);
+        if (parameter != this->parameters.end()) {
+            factors.push_back(parameter->second);
+        } else {
+            rest += rest.empty() ? factor : "*" + factor;
+        }
+    }
+    if (factors.empty()) {
+        return parse_token(token, out_term);
+    }
+
+    std::function<Scalar(Scalar)> term;
+    std::regex num_regex(R"(^([0-9]*\.?[0-9]+)$)");
+    if (rest.empty() || std::regex_match(rest, num_regex)) {
+        Scalar constant = (rest.empty() ? Scalar(1) : parseNumber<Scalar>(rest));
+        constant = sign == "-" ? -constant : constant;
+        term = [constant](Scalar) { return constant; };
+    } else if (!parse_token(sign + rest, term)) {
+        return false;
+    }
+    out_term = [term, factors](Scalar var) {
+        Scalar value = term(var);
+        for (const auto& factor : factors) {
+            value *= static_cast<Scalar>(*factor);
+        }
+        return value;
+    };
+    return true;
 }
 
-PolynomialParser ::PolynomialParser(std::string function_str) : FunctionParserBase(function_str) {}
+PolynomialParser ::PolynomialParser(std::string function_str, FunctionParameters parameters)
+    : FunctionParserBase(std::move(function_str), std::move(parameters)) {}
 
-bool PolynomialParser::parseTokenAsPolyTerm(const std::string& raw_token, std::function<double(double)>& out_term) {
+template <typename Scalar>
+bool PolynomialParser::parseTokenAsPolyTerm(const std::string& raw_token, std::function<Scalar(Scalar)>& out_term) {
     if (raw_token.empty()) {
         return false;
     }
@@ -102,60 +210,87 @@ bool PolynomialParser::parseTokenAsPolyTerm(const std::string& raw_token, std::f
     // Match 3*x^2, 3x^2, x^2, x, 3x, 3*x
     std::regex poly_regex(R"(^([0-9]*\.?[0-9]+)?\*?x(?:\^([0-9]+))?$)");
     if (std::regex_match(token, match, poly_regex)) {
-        double coeff = match[1].matched ? std::stod(match[1]) : 1.0;
+        Scalar coeff = match[1].matched ? parseNumber<Scalar>(match[1]) : Scalar(1);
         int power = match[2].matched ? std::stoi(match[2]) : 1;
 
-        out_term = [coeff = sign * coeff, power = power](double var) { return coeff * std::pow(var, power); };
+        out_term = [coeff = Scalar(sign) * coeff, power = power](Scalar var) -> Scalar {
+            return coeff * integerPower(var, power);
+        };
         return true;
     }
 
     // Numeric constant
     std::regex num_regex(R"(^([0-9]*\.?[0-9]+)$)");
     if (std::regex_match(token, match, num_regex)) {
-        double constant = std::stod(token);
-        out_term = [out = sign * constant](double) { return out; };
+        Scalar constant = parseNumber<Scalar>(token);
+        out_term = [out = Scalar(sign) * constant](Scalar) { return out; };
         return true;
     }
 
     // Try coefficient-first: 2*x^2, 4*x
-    auto [coeff_guess, rest] = parseOptionalCoefficient(token);
+    auto [coeff_guess, rest] = parseOptionalCoefficient<Scalar>(token);
     std::regex power_only(R"(^x(?:\^([0-9]+))?$)");
     if (std::regex_match(rest, match, power_only)) {
         int power = match[1].matched ? std::stoi(match[1]) : 1;
-        out_term = [coeff = sign * coeff_guess, power = power](double var) { return coeff * std::pow(var, power); };
+        out_term = [coeff = Scalar(sign) * coeff_guess, power = power](Scalar var) -> Scalar {
+            return coeff * integerPower(var, power);
+        };
         return true;
     }
 
     return false;
 }
 
-std::function<double(double)> PolynomialParser::parse() {
+std::function<double(double)> PolynomialParser::parse() { return this->parseAs<double>(); }
+
+template <typename Scalar>
+std::function<Scalar(Scalar)> PolynomialParser::parseAs() const {
+    std::function<Scalar(Scalar)> function;
+    std::string error;
+    if (!this->tryParseAs<Scalar>(function, error)) {
+        std::cerr << "\033[31m" << error << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    return function;
+}
+
+template <typename Scalar>
+bool PolynomialParser::tryParseAs(std::function<Scalar(Scalar)>& out, std::string& error) const {
     std::string function_str_no_spaces = removeSpaces(this->function_str);
 
     auto tokens = splitSignTokens(function_str_no_spaces);
-    std::vector<std::function<double(double)>> terms;
+    std::vector<std::function<Scalar(Scalar)>> terms;
 
     for (const auto& token : tokens) {
-        std::function<double(double)> term;
-        if (!parseTokenAsPolyTerm(token, term)) {
-            std::cerr << "\033[31mUnsupported polynomial token: '" << token << "'\033[0m\n";
-            std::exit(EXIT_FAILURE);
+        std::function<Scalar(Scalar)> term;
+        bool parsed = false;
+        try {
+            parsed = parseParameterTerm<Scalar>(token, parseTokenAsPolyTerm<Scalar>, term);
+        } catch (const std::out_of_range&) {
+            // a coefficient or a power which does not fit in its type
+        }
+        if (!parsed) {
+            error = "Unsupported polynomial token: '" + token + "'";
+            return false;
         }
         terms.push_back(term);
     }
 
-    return [terms](double var) {
-        double sum = 0;
+    out = [terms](Scalar var) {
+        Scalar sum = 0;
         for (const auto& term : terms) {
             sum += term(var);
         }
         return sum;
     };
+    return true;
 }
 
-TrigonometricParser ::TrigonometricParser(std::string function_str) : FunctionParserBase(function_str) {}
+TrigonometricParser ::TrigonometricParser(std::string function_str, FunctionParameters parameters)
+    : FunctionParserBase(std::move(function_str), std::move(parameters)) {}
 
-bool TrigonometricParser::parseTokenAsTrigTerm(const std::string& raw_token, std::function<double(double)>& out_term) {
+template <typename Scalar>
+bool TrigonometricParser::parseTokenAsTrigTerm(const std::string& raw_token, std::function<Scalar(Scalar)>& out_term) {
     if (raw_token.empty()) {
         return false;
     }
@@ -180,26 +315,38 @@ bool TrigonometricParser::parseTokenAsTrigTerm(const std::string& raw_token, std
     // Match: 3*sin(x), sin(x), 2cos(x), cos(x), etc.
     std::regex trig_regex(R"(^([0-9]*\.?[0-9]+)?\*?(sin|cos)\(x\)$)");
     if (std::regex_match(token, match, trig_regex)) {
-        double coeff = match[1].matched ? std::stod(match[1]) : 1.0;
+        Scalar coeff = match[1].matched ? parseNumber<Scalar>(match[1]) : Scalar(1);
         std::string type = match[2];
 
         if (type == "sin") {
-            out_term = [coeff = sign * coeff](double var) { return coeff * std::sin(var); };
+            out_term = [coeff = Scalar(sign) * coeff](Scalar var) -> Scalar {
+                using std::sin;
+                return coeff * sin(var);
+            };
         } else {
-            out_term = [coeff = sign * coeff](double var) { return coeff * std::cos(var); };
+            out_term = [coeff = Scalar(sign) * coeff](Scalar var) -> Scalar {
+                using std::cos;
+                return coeff * cos(var);
+            };
         }
 
         return true;
     }
 
     // Try coefficient-first: 2sin(x)
-    auto [coeff_guess, rest] = parseOptionalCoefficient(token);
+    auto [coeff_guess, rest] = parseOptionalCoefficient<Scalar>(token);
     std::regex core(R"(^sin\(x\)$|^cos\(x\)$)");
     if (std::regex_match(rest, core)) {
         if (rest.find("sin") != std::string::npos) {
-            out_term = [coeff = sign * coeff_guess](double var) { return coeff * std::sin(var); };
+            out_term = [coeff = Scalar(sign) * coeff_guess](Scalar var) -> Scalar {
+                using std::sin;
+                return coeff * sin(var);
+            };
         } else {
-            out_term = [coeff = sign * coeff_guess](double var) { return coeff * std::cos(var); };
+            out_term = [coeff = Scalar(sign) * coeff_guess](Scalar var) -> Scalar {
+                using std::cos;
+                return coeff * cos(var);
+            };
         }
         return true;
     }
@@ -207,40 +354,127 @@ bool TrigonometricParser::parseTokenAsTrigTerm(const std::string& raw_token, std
     return false;
 }
 
-std::function<double(double)> TrigonometricParser::parse() {
+std::function<double(double)> TrigonometricParser::parse() { return this->parseAs<double>(); }
+
+template <typename Scalar>
+std::function<Scalar(Scalar)> TrigonometricParser::parseAs() const {
+    std::function<Scalar(Scalar)> function;
+    std::string error;
+    if (!this->tryParseAs<Scalar>(function, error)) {
+        std::cerr << "\033[31m" << error << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    return function;
+}
+
+template <typename Scalar>
+bool TrigonometricParser::tryParseAs(std::function<Scalar(Scalar)>& out, std::string& error) const {
     std::string function_str_no_spaces = removeSpaces(function_str);
 
     auto tokens = splitSignTokens(function_str_no_spaces);
-    std::vector<std::function<double(double)>> terms;
+    std::vector<std::function<Scalar(Scalar)>> terms;
 
     for (const auto& token : tokens) {
-        std::function<double(double)> term;
-        if (!parseTokenAsTrigTerm(token, term)) {
-            std::cerr << "\033[31mUnsupported trig token: '" << token << "'\033[0m\n";
-            std::exit(EXIT_FAILURE);
+        std::function<Scalar(Scalar)> term;
+        bool parsed = false;
+        try {
+            parsed = parseParameterTerm<Scalar>(token, parseTokenAsTrigTerm<Scalar>, term);
+        } catch (const std::out_of_range&) {
+            // a coefficient or a power which does not fit in its type
+        }
+        if (!parsed) {
+            error = "Unsupported trig token: '" + token + "'";
+            return false;
         }
         terms.push_back(term);
     }
 
-    return [terms](double var) {
-        double sum = 0;
+    out = [terms](Scalar var) {
+        Scalar sum = 0;
         for (const auto& term : terms) {
             sum += term(var);
         }
         return sum;
     };
+    return true;
+}
+
+template <typename Scalar>
+std::function<Scalar(Scalar)> FunctionParserBase::parseFunction(const std::string& function_str,
+                                                                const FunctionParameters& parameters) {
+    std::function<Scalar(Scalar)> function;
+    std::string error;
+    if (!tryParseFunction<Scalar>(function_str, function, error, parameters)) {
+        std::cerr << "\033[31m" << error << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    return function;
 }
 
-std::function<double(double)> FunctionParserBase::parseFunction(const std::string& function_str) {
-    std::unique_ptr<FunctionParserBase> parser;
+template <typename Scalar>
+bool FunctionParserBase::tryParseFunction(const std::string& function_str, std::function<Scalar(Scalar)>& out,
+                                          std::string& error, const FunctionParameters& parameters) {
+    // parse() is virtual and cannot be templated, so the parsers are dispatched on their concrete type
     if (isPolynomial(function_str)) {
-        parser = std::make_unique<PolynomialParser>(function_str);
-    } else if (isTrigonometric(function_str)) {
-        parser = std::make_unique<TrigonometricParser>(function_str);
-    } else {
-        std::cerr << "\033[31mUnsupported function type: '" << function_str << "'\033[0m\n";
+        return PolynomialParser(function_str, parameters).tryParseAs<Scalar>(out, error);
+    }
+    if (isTrigonometric(function_str)) {
+        return TrigonometricParser(function_str, parameters).tryParseAs<Scalar>(out, error);
+    }
+    error = "Unsupported function type: '" + function_str + "'";
+    return false;
+}
+
+// the scalar types a Solver can work with
+template std::function<float(float)> FunctionParserBase::parseFunction<float>(const std::string&,
+                                                                              const FunctionParameters&);
+template std::function<double(double)> FunctionParserBase::parseFunction<double>(const std::string&,
+                                                                                 const FunctionParameters&);
+template std::function<long double(long double)> FunctionParserBase::parseFunction<long double>(
+    const std::string&, const FunctionParameters&);
+template std::function<DoubleDouble(DoubleDouble)> FunctionParserBase::parseFunction<DoubleDouble>(
+    const std::string&, const FunctionParameters&);
+template std::function<std::complex<double>(std::complex<double>)>
+FunctionParserBase::parseFunction<std::complex<double>>(const std::string&, const FunctionParameters&);
+template bool FunctionParserBase::tryParseFunction<double>(const std::string&, std::function<double(double)>&,
+                                                           std::string&, const FunctionParameters&);
+template std::pair<double, std::string> FunctionParserBase::parseOptionalCoefficient<double>(const std::string&);
+template bool PolynomialParser::parseTokenAsPolyTerm<double>(const std::string&, std::function<double(double)>&);
+template bool TrigonometricParser::parseTokenAsTrigTerm<double>(const std::string&, std::function<double(double)>&);
+
+std::function<double(double)> FunctionCache::get(const std::string& function_str) {
+    std::function<double(double)> function;
+    std::string error;
+    if (!this->try_get(function_str, function, error)) {
+        std::cerr << "\033[31m" << error << "\033[0m\n";
         std::exit(EXIT_FAILURE);
     }
+    return function;
+}
+
+bool FunctionCache::try_get(const std::string& function_str, std::function<double(double)>& out,
+                            std::string& error) {
+    {
+        std::shared_lock lock(this->mutex);
+        auto it = this->functions.find(function_str);
+        if (it != this->functions.end()) {
+            out = it->second;
+            return true;
+        }
+    }
+
+    // parse outside of the lock, two threads racing on a new expression simply parse it twice; expressions which
+    // cannot be parsed are not cached
+    std::function<double(double)> function;
+    if (!FunctionParserBase::tryParseFunction(function_str, function, error)) {
+        return false;
+    }
+    std::unique_lock lock(this->mutex);
+    out = this->functions.try_emplace(function_str, std::move(function)).first->second;
+    return true;
+}
 
-    return parser->parse();
+size_t FunctionCache::size() const {
+    std::shared_lock lock(this->mutex);
+    return this->functions.size();
 }
@@ -6,6 +6,13 @@
  * including polynomial and trigonometric functions. The parsers convert string representations
  * of functions into callable std::function<double(double)> objects.
  *
+ * Expressions can also hold named parameters (e.g. "x^2-p" or "a*sin(x)"), appearing as factors of a term; the
+ * parsed function reads their current value on every call.
+ *
+ * The same expression can be parsed into a function of float, double, long double or DoubleDouble: the coefficients
+ * are read from the string in the precision of the scalar, and the terms are evaluated in that precision. Parsed
+ * into a function of std::complex<double>, it can be evaluated off the real line to look for complex roots.
+ *
  * This file was written with constant LLM assistance (vibe coded). I built
  * the structure and logic, and the LLM helped fill in the details.
  *
@@ -15,7 +22,17 @@
 #define FUNCTION_HPP
 
 #include <functional>
+#include <memory>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Named parameters of parsed functions, each one bound to a value which can change between calls.
+ *
+ */
+using FunctionParameters = std::unordered_map<std::string, std::shared_ptr<double>>;
 
 /**
  * @brief Base class for function parsers.
@@ -41,9 +58,27 @@ class FunctionParserBase {
      * and delegates parsing to the appropriate subclass parser.
      *
      * @param function_str The string representation of the function to be parsed.
-     * @return A std::function<double(double)> representing the parsed function.
+     * @param parameters The named parameters which can appear as factors of the terms of the function.
+     * @return A std::function<Scalar(Scalar)> representing the parsed function, Scalar being float, double, long
+     * double, DoubleDouble or std::complex<double>.
      */
-    static std::function<double(double)> parseFunction(const std::string& function_str);
+    template <typename Scalar = double>
+    static std::function<Scalar(Scalar)> parseFunction(const std::string& function_str,
+                                                       const FunctionParameters& parameters = {});
+    /**
+     * @brief Static method to parse a function string without stopping the program if it is not supported.
+     *
+     * Long-lived processes (e.g. the solver daemon) use it to reject an expression instead of exiting.
+     *
+     * @param function_str The string representation of the function to be parsed.
+     * @param out A reference to store the parsed function.
+     * @param error A reference to store the reason why the expression was rejected.
+     * @param parameters The named parameters which can appear as factors of the terms of the function.
+     * @return true if parsing was successful, false otherwise.
+     */
+    template <typename Scalar = double>
+    static bool tryParseFunction(const std::string& function_str, std::function<Scalar(Scalar)>& out,
+                                 std::string& error, const FunctionParameters& parameters = {});
 
     /**
      * @brief Static method to check if the expression is a polynomial.
@@ -63,11 +98,38 @@ class FunctionParserBase {
      * @brief Constructor for FunctionParserBase.
      *
      * @param function_str The string representation of the function to be parsed.
+     * @param parameters The named parameters which can appear as factors of the terms of the function.
      */
-    FunctionParserBase(std::string function_str);
+    FunctionParserBase(std::string function_str, FunctionParameters parameters = {});
 
   protected:
-    std::string function_str;  //!< The function string to be parsed.
+    std::string function_str;       //!< The function string to be parsed.
+    FunctionParameters parameters;  //!< The named parameters of the function.
+    /** @brief Parser of a single token without parameters into a term function (e.g. parseTokenAsPolyTerm). */
+    template <typename Scalar>
+    using TokenParser = bool (*)(const std::string&, std::function<Scalar(Scalar)>&);
+    /**
+     * @brief Helper method to parse a term holding parameter factors (e.g. "-2*p*x^2" or "p").
+     *
+     * The parameter factors are removed from the token; what remains is parsed with parse_token (unless it is a
+     * plain coefficient), and the resulting term is multiplied by the current value of the parameters.
+     *
+     * @param token The token string to parse, starting with its sign.
+     * @param parse_token The parser of the token without its parameter factors.
+     * @param out_term A reference to store the resulting term function.
+     * @return true if the token was successfully parsed, false otherwise.
+     */
+    template <typename Scalar>
+    bool parseParameterTerm(const std::string& token, TokenParser<Scalar> parse_token,
+                            std::function<Scalar(Scalar)>& out_term) const;
+    /**
+     * @brief Helper static method to read a number in the precision of a scalar type.
+     *
+     * @param text The decimal representation of the number.
+     * @return The number, rounded once to the scalar type (for DoubleDouble, within a few units of its last place).
+     */
+    template <typename Scalar>
+    static Scalar parseNumber(const std::string& text);
     /**
      * @brief Helper static method to check if a string contains a substring (case-insensitive).
      *
@@ -96,7 +158,8 @@ class FunctionParserBase {
      * @param token The token string to parse.
      * @return A pair containing the coefficient and the remaining string.
      */
-    static std::pair<double, std::string> parseOptionalCoefficient(const std::string& token);
+    template <typename Scalar = double>
+    static std::pair<Scalar, std::string> parseOptionalCoefficient(const std::string& token);
 
   private:
     friend class FunctionParserBaseTester;  //!< Friend test fixture class for unit testing.
@@ -113,14 +176,31 @@ class PolynomialParser : public FunctionParserBase {
      * @brief Constructor for PolynomialParser.
      *
      * @param function_str The string representation of the polynomial function to be parsed.
+     * @param parameters The named parameters which can appear as factors of the terms of the function.
      */
-    PolynomialParser(std::string function_str);
+    PolynomialParser(std::string function_str, FunctionParameters parameters = {});
     /**
      * @brief Parse the polynomial function string.
      *
      * @return A std::function<double(double)> representing the parsed polynomial function.
      */
     std::function<double(double)> parse() override;
+    /**
+     * @brief Parse the polynomial function string into a function of the given scalar type.
+     *
+     * @return A std::function<Scalar(Scalar)> representing the parsed polynomial function.
+     */
+    template <typename Scalar>
+    std::function<Scalar(Scalar)> parseAs() const;
+    /**
+     * @brief Parse the polynomial function string, reporting an unsupported token instead of stopping the program.
+     *
+     * @param out A reference to store the parsed function.
+     * @param error A reference to store the reason why the expression was rejected.
+     * @return true if every token was parsed, false otherwise.
+     */
+    template <typename Scalar>
+    bool tryParseAs(std::function<Scalar(Scalar)>& out, std::string& error) const;
 
   private:
     friend class PolynomialParserTester;  //!< Friend test fixture class for unit testing.
@@ -131,7 +211,8 @@ class PolynomialParser : public FunctionParserBase {
      * @param out_term A reference to store the resulting polynomial term function.
      * @return true if the token was successfully parsed as a polynomial term, false otherwise.
      */
-    static bool parseTokenAsPolyTerm(const std::string& raw_token, std::function<double(double)>& out_term);
+    template <typename Scalar>
+    static bool parseTokenAsPolyTerm(const std::string& raw_token, std::function<Scalar(Scalar)>& out_term);
 };
 
 /**
@@ -145,14 +226,31 @@ class TrigonometricParser : public FunctionParserBase {
      * @brief Constructor for TrigonometricParser.
      *
      * @param function_str The string representation of the trigonometric function to be parsed.
+     * @param parameters The named parameters which can appear as factors of the terms of the function.
      */
-    TrigonometricParser(std::string function_str);
+    TrigonometricParser(std::string function_str, FunctionParameters parameters = {});
     /**
      * @brief Parse the trigonometric function string.
      *
      * @return A std::function<double(double)> representing the parsed trigonometric function.
      */
     std::function<double(double)> parse() override;
+    /**
+     * @brief Parse the trigonometric function string into a function of the given scalar type.
+     *
+     * @return A std::function<Scalar(Scalar)> representing the parsed trigonometric function.
+     */
+    template <typename Scalar>
+    std::function<Scalar(Scalar)> parseAs() const;
+    /**
+     * @brief Parse the trigonometric function string, reporting an unsupported token instead of stopping the program.
+     *
+     * @param out A reference to store the parsed function.
+     * @param error A reference to store the reason why the expression was rejected.
+     * @return true if every token was parsed, false otherwise.
+     */
+    template <typename Scalar>
+    bool tryParseAs(std::function<Scalar(Scalar)>& out, std::string& error) const;
 
   private:
     friend class TrigonometricParserTester;  //!< Friend test fixture class for unit testing.
@@ -163,7 +261,46 @@ class TrigonometricParser : public FunctionParserBase {
      * @param out_term A reference to store the resulting trigonometric term function.
      * @return true if the token was successfully parsed as a trigonometric term, false otherwise.
      */
-    static bool parseTokenAsTrigTerm(const std::string& raw_token, std::function<double(double)>& out_term);
+    template <typename Scalar>
+    static bool parseTokenAsTrigTerm(const std::string& raw_token, std::function<Scalar(Scalar)>& out_term);
+};
+
+/**
+ * @brief Thread-safe cache of parsed functions, keyed by their string representation.
+ *
+ * Long-lived processes (e.g. the solver daemon) see the same expressions over and over again; the cache parses
+ * each expression once and hands out copies of the resulting callable. Parsed functions only capture their
+ * coefficients by value, so the copies can be called concurrently from several threads.
+ */
+class FunctionCache {
+  public:
+    /**
+     * @brief Return the parsed function for an expression, parsing it on the first request.
+     *
+     * @param function_str The string representation of the function.
+     * @return A std::function<double(double)> representing the parsed function.
+     */
+    std::function<double(double)> get(const std::string& function_str);
+    /**
+     * @brief Return the parsed function for an expression, reporting an unsupported expression instead of stopping.
+     *
+     * @param function_str The string representation of the function.
+     * @param out A reference to store the parsed function.
+     * @param error A reference to store the reason why the expression was rejected.
+     * @return true if the expression was found in the cache or parsed, false otherwise.
+     */
+    bool try_get(const std::string& function_str, std::function<double(double)>& out, std::string& error);
+    /**
+     * @brief Number of distinct expressions parsed so far.
+     *
+     * @return The number of cached functions.
+     */
+    size_t size() const;
+
+  private:
+    friend class FunctionCacheTester;  //!< Friend test fixture class for unit testing.
+    mutable std::shared_mutex mutex;   //!< Guards functions; lookups take a shared lock, insertions a unique one.
+    std::unordered_map<std::string, std::function<double(double)>> functions;  //!< Parsed function per expression.
 };
 
 #endif  // FUNCTION_HPP
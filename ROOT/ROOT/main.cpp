@@ -1,16 +1,285 @@
 #include <CLI/CLI.hpp>
 #include <Eigen/Dense>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <libROOT/solver.hpp>
 #include <memory>
+#include <new>
+#include <sstream>
+#include <stop_token>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include <unistd.h>
+
+#include "async_writer.hpp"
+#include "batch.hpp"
+#include "binary_format.hpp"
 #include "config.hpp"
+#include "daemon.hpp"
 #include "function_parser.hpp"
+#include "npy.hpp"
+#include "plot.hpp"
+#include "portfolio.hpp"
 #include "reader.hpp"
+#include "result_archive.hpp"
+#include "shm_ring.hpp"
+#include "sweep.hpp"
+#include "text_format.hpp"
 #include "writer.hpp"
 
+/**
+ * @brief Run the Solver matching the method stored in a configuration.
+ *
+ * Every thread runs its processes in its own SolveContext, reused from one problem to the next, so that a batch
+ * stops allocating once the context fits its largest problem. Verbose configurations run the process that writes
+ * its iterations on the console instead.
+ *
+ * @param config The configuration (read by one of the Reader classes) describing the problem.
+ * @param stop Ends the solving process before its next iteration once a stop is requested.
+ * @return The results of the Solver, with its status and number of function evaluations.
+ */
+static Solution solve_config(const ConfigBase& config, std::stop_token stop = {}) {
+    thread_local SolveContext context;
+    auto run = [&config, &stop](auto& solver, const auto& initial_guess) -> Solution {
+        solver.set_limits(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::duration<double>(config.time_limit)),
+                          config.max_evaluations);
+        if (!config.verbose) {
+            Solution solution = solver.solve(initial_guess, context, stop).to_solution();
+            if (solution.status == SolverStatus::MAX_ITERATIONS) {
+                std::cerr << "\033[31mThe solution did not converge in " << config.max_iterations
+                          << " iterations\033[0m\n";
+            }
+            return solution;
+        }
+        solver.set_stop_token(stop);
+        Eigen::MatrixX2d results = solver.solve();
+        return {std::move(results), solver.get_status(), solver.get_evaluations(), solver.get_best_estimate()};
+    };
+    switch (config.method) {
+        case Method::BISECTION: {
+            const auto& bisection_config = dynamic_cast<const BisectionConfig&>(config);
+            Eigen::Vector2d interval = {bisection_config.initial_point, bisection_config.final_point};
+            Solver solver(config.function, interval, config.method, config.max_iterations, config.tolerance,
+                          config.aitken, config.verbose);
+            return run(solver, interval);
+        }
+        case Method::NEWTON: {
+            const auto& newton_config = dynamic_cast<const NewtonConfig&>(config);
+            Solver solver(config.function, newton_config.initial_guess, config.method, config.max_iterations,
+                          config.tolerance, config.aitken, config.verbose, newton_config.derivative);
+            return run(solver, newton_config.initial_guess);
+        }
+        case Method::CHORDS: {
+            const auto& chords_config = dynamic_cast<const ChordsConfig&>(config);
+            Eigen::Vector2d interval = {chords_config.initial_point1, chords_config.initial_point2};
+            Solver solver(config.function, interval, config.method, config.max_iterations, config.tolerance,
+                          config.aitken, config.verbose);
+            return run(solver, interval);
+        }
+        case Method::FIXED_POINT: {
+            const auto& fixed_point_config = dynamic_cast<const FixedPointConfig&>(config);
+            Solver solver(config.function, fixed_point_config.initial_guess, config.method, config.max_iterations,
+                          config.tolerance, config.aitken, config.verbose, fixed_point_config.g_function);
+            return run(solver, fixed_point_config.initial_guess);
+        }
+        default:
+            return {Eigen::MatrixX2d(0, 2), SolverStatus::DIVERGED, 0, Eigen::Vector2d::Zero()};
+    }
+}
+
+/**
+ * @brief Run solve_config for a server, which answers a problem asking for more memory than there is instead of
+ * stopping.
+ *
+ * @param config The configuration describing the problem.
+ * @param solution A reference to store the results of the Solver.
+ * @return true if the problem was solved, false if its process ran out of memory.
+ */
+static bool try_solve_config(const ConfigBase& config, Solution& solution) {
+    try {
+        solution = solve_config(config);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Build the configuration of a problem whose function and starting points are given on the command line.
+ *
+ * @param method The method solving the problem.
+ * @param tolerance The tolerance for convergence.
+ * @param max_iterations The maximum number of iterations allowed.
+ * @param aitken Indicates whether Aitken acceleration is enabled.
+ * @param function The function for which the root is to be found.
+ * @param auxiliary The derivative (Newton) or the g function (Fixed Point), unused by the other methods.
+ * @param x0 The initial guess, or the first point of the interval.
+ * @param x1 The second point of the interval (Chords and Bisection).
+ * @param verbose Indicates whether the Solver writes its iterations.
+ * @return The configuration, or nullptr for the Bisection method when f(x0) and f(x1) have the same sign.
+ */
+static std::unique_ptr<ConfigBase> make_config(Method method, double tolerance, int max_iterations, bool aitken,
+                                               const std::function<double(double)>& function,
+                                               const std::function<double(double)>& auxiliary, double x0, double x1,
+                                               bool verbose) {
+    switch (method) {
+        case Method::NEWTON:
+            return std::make_unique<NewtonConfig>(tolerance, max_iterations, aitken, function, auxiliary, x0, verbose);
+        case Method::FIXED_POINT:
+            return std::make_unique<FixedPointConfig>(tolerance, max_iterations, aitken, function, x0, auxiliary,
+                                                      verbose);
+        case Method::CHORDS:
+            return std::make_unique<ChordsConfig>(tolerance, max_iterations, aitken, function, x0, x1, verbose);
+        default:
+            // checked here, since the configuration ends the program on an interval without a sign change
+            if (function(x0) * function(x1) > 0.0) {
+                return nullptr;
+            }
+            return std::make_unique<BisectionConfig>(tolerance, max_iterations, aitken, function, x0, x1, verbose);
+    }
+}
+
+/**
+ * @brief Answer one daemon request: read the problem, solve it and write the result as a JSON object.
+ *
+ * @param request The request payload, holding one problem as a flat JSON object.
+ * @param cache The cache of parsed functions shared by every request of the daemon.
+ * @param apply_limits Sets the time and evaluation limits of the daemon on the problem.
+ * @return The result object, with the trajectory, the root, f(root), the iterations and the status of the solving
+ * process, or an error object.
+ */
+static std::string answer_request(const std::string& request, FunctionCache& cache,
+                                  const std::function<void(ConfigBase&)>& apply_limits) {
+    std::unique_ptr<ConfigBase> config;
+    std::string error;
+    if (!ReaderJSONL::try_read_line(request, config, error, &cache)) {
+        return daemon_error(error);
+    }
+    apply_limits(*config);
+    Solution solution;
+    if (!try_solve_config(*config, solution)) {
+        return daemon_error("out of memory");
+    }
+
+    const Eigen::MatrixX2d& results = solution.results;
+    if (results.rows() == 0) {
+        return daemon_error("the solver produced no iterations");
+    }
+    // the keys of a JSON Lines result object, except that a solving process ended by a limit reports its best
+    // iterate as the root, followed by the status
+    std::string response = "{\"trajectory\":[";
+    for (Eigen::Index i = 0; i < results.rows(); ++i) {
+        response += i == 0 ? "[" : ",[";
+        append_json_number(response, results(i, 0));
+        response += ',';
+        append_json_number(response, results(i, 1));
+        response += ']';
+    }
+    Eigen::Vector2d estimate = solution.estimate();
+    response += "],\"root\":";
+    append_json_number(response, estimate(0));
+    response += ",\"f_root\":";
+    append_json_number(response, estimate(1));
+    response += ",\"iterations\":" + std::to_string(results.rows() - 1);
+    response += ",\"status\":";
+    append_json_string(response, solver_status_name(solution.status));
+    response += '}';
+    return response;
+}
+
+/**
+ * @brief Answer one shared-memory request: build the problem from the record, solve it and fill the result.
+ *
+ * @param request The fixed-layout request.
+ * @param cache The cache of parsed functions shared by every request of the server.
+ * @param apply_limits Sets the time and evaluation limits of the server on the problem.
+ * @return The fixed-layout result, rejected if the request does not describe a valid problem.
+ */
+static ShmResult answer_shm_request(const ShmRequest& request, FunctionCache& cache,
+                                    const std::function<void(ConfigBase&)>& apply_limits) {
+    ShmResult result{request.id, 0.0, 0.0, 0, ShmStatus::SHM_REJECTED};
+    // the fields are filled by another process, never trust them to be null-terminated
+    std::string function_str(request.function, strnlen(request.function, shm_expression_size));
+    std::string auxiliary_str(request.auxiliary, strnlen(request.auxiliary, shm_expression_size));
+    // a server must not stop on a malformed request, every failure is reported as SHM_REJECTED
+    std::string error;
+    std::function<double(double)> function;
+    if (request.max_iterations <= 0 || !(request.tolerance > 0) || !cache.try_get(function_str, function, error)) {
+        return result;
+    }
+
+    bool aitken = request.aitken != 0;
+    std::unique_ptr<ConfigBase> config;
+    std::function<double(double)> auxiliary;
+    switch (request.method) {
+        case Method::BISECTION:
+            // BisectionConfig stops the process on an invalid interval
+            if (function(request.first) * function(request.second) > 0) {
+                return result;
+            }
+            config = std::make_unique<BisectionConfig>(request.tolerance, request.max_iterations, aitken, function,
+                                                       request.first, request.second, false);
+            break;
+        case Method::CHORDS:
+            config = std::make_unique<ChordsConfig>(request.tolerance, request.max_iterations, aitken, function,
+                                                    request.first, request.second, false);
+            break;
+        case Method::NEWTON:
+        case Method::FIXED_POINT:
+            if (!cache.try_get(auxiliary_str, auxiliary, error)) {
+                return result;
+            }
+            if (request.method == Method::NEWTON) {
+                config = std::make_unique<NewtonConfig>(request.tolerance, request.max_iterations, aitken, function,
+                                                        auxiliary, request.first, false);
+            } else {
+                config = std::make_unique<FixedPointConfig>(request.tolerance, request.max_iterations, aitken,
+                                                            function, request.first, auxiliary, false);
+            }
+            break;
+        default:
+            return result;
+    }
+
+    apply_limits(*config);
+    Solution solution;
+    if (!try_solve_config(*config, solution)) {
+        return result;
+    }
+    Eigen::Vector2d estimate = solution.estimate();
+    result.root = estimate(0);
+    result.f_root = estimate(1);
+    result.iterations = static_cast<std::int32_t>(solution.results.rows() - 1);
+    switch (solution.status) {
+        case SolverStatus::CONVERGED:
+            result.status = ShmStatus::SHM_SOLVED;
+            break;
+        case SolverStatus::MAX_ITERATIONS:
+            result.status = ShmStatus::SHM_MAX_ITERATIONS;
+            break;
+        case SolverStatus::TIMED_OUT:
+            result.status = ShmStatus::SHM_TIMED_OUT;
+            break;
+        case SolverStatus::BUDGET_EXHAUSTED:
+            result.status = ShmStatus::SHM_BUDGET_EXHAUSTED;
+            break;
+        default:
+            // the server never cancels a solving process
+            result.status = ShmStatus::SHM_DIVERGED;
+    }
+    return result;
+}
+
 int main(int argc, char** argv) {
     // ------------------------------------------------------------
     // Command-line interface
@@ -40,6 +309,24 @@ int main(int argc, char** argv) {
 
     std::string write_to_dat;
     auto* wdat = app.add_option("--wdat,--write-to-dat", write_to_dat, "Path for writing results to DAT file");
+    std::string write_to_jsonl;
+    app.add_option("--wjsonl,--write-to-jsonl", write_to_jsonl,
+                   "Path for writing results to JSON Lines file (one object per problem)");
+    std::string write_to_npy;
+    app.add_option("--wnpy,--write-to-npy", write_to_npy,
+                   "Path for writing results to NumPy .npy file (.npz archive when solving several problems)");
+    std::string write_to_svg;
+    app.add_option("--wsvg,--write-to-svg", write_to_svg,
+                   "Path for plotting the iterations of every problem in a single SVG file");
+    std::string write_to_png;
+    app.add_option("--wpng,--write-to-png", write_to_png,
+                   "Path for plotting the iterations of every problem in a single PNG file");
+    std::string write_to_archive;
+    app.add_option("--warchive,--write-to-archive", write_to_archive,
+                   "Path for writing the status, root and counters of every problem to an indexed binary archive "
+                   "(appended to with --ofmode a)");
+    bool archive_trajectories = false;
+    app.add_flag("--archive-trajectories", archive_trajectories, "Store every iteration in the archive records");
     bool write_with_gnuplot = false;
     app.add_flag("--wgnuplot,--write-to-gnuplot", write_with_gnuplot, "Write results to Gnuplot file")->needs(wdat);
 
@@ -49,6 +336,25 @@ int main(int argc, char** argv) {
         ->check(CLI::IsMember({'a', 'o'}))
         ->capture_default_str();
 
+    size_t write_queue = 64;
+    app.add_option("--wqueue,--write-queue", write_queue,
+                   "Number of solved problems which can wait to be written on files by the background writer thread "
+                   "(0 writes every problem before solving the next one)")
+        ->capture_default_str();
+
+    double time_limit = 0.0;
+    app.add_option("--time-limit", time_limit,
+                   "Wall-clock seconds allowed to the solving process of every problem, which then ends with the "
+                   "timed_out status and its best estimate (0 for no limit)")
+        ->check(CLI::NonNegativeNumber)
+        ->capture_default_str();
+    long max_evaluations = 0;
+    app.add_option("--max-evaluations", max_evaluations,
+                   "Function evaluations allowed to the solving process of every problem, which then ends with the "
+                   "budget_exhausted status and its best estimate (0 for no limit)")
+        ->check(CLI::NonNegativeNumber)
+        ->capture_default_str();
+
     // Subcommands for different input methods
     // CSV
     auto* csv = app.add_subcommand("csv", "Use CSV input");
@@ -63,7 +369,191 @@ int main(int argc, char** argv) {
     // DAT
     auto* dat = app.add_subcommand("dat", "Use DAT input");
     std::string dat_file;
-    dat->add_option("--file", dat_file, "Path to DAT file containing input data")->required()->check(CLI::ExistingFile);
+    dat->add_option("--file", dat_file, "Path to DAT file containing input data (one problem per [section])")
+        ->required()
+        ->check(CLI::ExistingFile);
+
+    // Columnar binary
+    auto* bin = app.add_subcommand("bin", "Use columnar binary input (batch of problems)");
+    std::string bin_file;
+    bin->add_option("--file", bin_file, "Path to columnar binary file containing input data")
+        ->required()
+        ->check(CLI::ExistingFile);
+
+    // JSON Lines
+    auto* jsonl = app.add_subcommand("jsonl", "Use JSON Lines input (one problem per line)");
+    std::string jsonl_file;
+    jsonl->add_option("--file", jsonl_file, "Path to JSON Lines file containing input data")
+        ->required()
+        ->check(CLI::ExistingFile);
+
+    // Pipe (standard input to standard output)
+    auto* pipe = app.add_subcommand("pipe", "Read problems from standard input and write results to standard output");
+    std::string pipe_format = "jsonl";
+    pipe->add_option("--format", pipe_format, "Format of the input stream: csv (with a header line), dat or jsonl")
+        ->check(CLI::IsMember({"csv", "dat", "jsonl"}))
+        ->capture_default_str();
+    std::string pipe_output = "jsonl";
+    pipe->add_option("--output-format", pipe_output, "Format of the results written on standard output")
+        ->check(CLI::IsMember({"csv", "dat", "jsonl"}))
+        ->capture_default_str();
+    char pipe_sep = ',';
+    pipe->add_option("--sep", pipe_sep, "Separator character for CSV input")->capture_default_str();
+    char pipe_quote = '"';
+    pipe->add_option("--quote", pipe_quote, "Quote/delimiter character for CSV input")->capture_default_str();
+    int flush_every = 1;
+    pipe->add_option("--flush-every", flush_every,
+                     "Flush standard output after every N solved problems (0 flushes only at the end of the stream)")
+        ->check(CLI::NonNegativeNumber)
+        ->capture_default_str();
+
+    // Daemon (Unix domain socket)
+    auto* daemon = app.add_subcommand("daemon", "Serve framed JSON requests on a Unix domain socket");
+    std::string daemon_socket;
+    daemon->add_option("--socket", daemon_socket, "Path of the Unix domain socket to listen on")->required();
+    unsigned int daemon_threads = std::max(1U, std::thread::hardware_concurrency());
+    daemon->add_option("--threads", daemon_threads, "Number of worker threads (requests answered concurrently)")
+        ->check(CLI::PositiveNumber)
+        ->capture_default_str();
+
+    // Client of the daemon
+    auto* client = app.add_subcommand("client", "Send JSON Lines problems to a running daemon");
+    std::string client_socket;
+    client->add_option("--socket", client_socket, "Path of the Unix domain socket of the daemon")->required();
+    std::string client_file;
+    client->add_option("--file", client_file, "Path to JSON Lines file containing input data (default: stdin)")
+        ->check(CLI::ExistingFile);
+    bool client_stop = false;
+    client->add_flag("--stop", client_stop, "Ask the daemon to shut down once the problems are answered");
+
+    // Shared-memory server
+    auto* shm = app.add_subcommand("shm", "Serve fixed-layout requests from a shared-memory ring");
+    std::string shm_name;
+    shm->add_option("--name", shm_name, "POSIX shared-memory name of the segment (e.g. /root-ring)")->required();
+    std::uint32_t shm_capacity = 1024;
+    shm->add_option("--capacity", shm_capacity, "Number of slots of the request and result rings")
+        ->check(CLI::PositiveNumber)
+        ->capture_default_str();
+
+    // Batch (scheduler entry point)
+    auto* batch = app.add_subcommand("batch", "Solve a shard of a batch of problems in parallel, with a summary row "
+                                              "per problem");
+    std::string batch_file;
+    batch->add_option("--file", batch_file, "Path to the batch, in any input format holding several problems")
+        ->required()
+        ->check(CLI::ExistingFile);
+    std::string batch_format = "auto";
+    batch->add_option("--format", batch_format, "Format of the batch (auto picks it from the file extension)")
+        ->check(CLI::IsMember({"auto", "csv", "dat", "jsonl", "bin"}))
+        ->capture_default_str();
+    char batch_sep = ',';
+    batch->add_option("--sep", batch_sep, "Separator character for CSV input")->capture_default_str();
+    char batch_quote = '"';
+    batch->add_option("--quote", batch_quote, "Quote/delimiter character for CSV input")->capture_default_str();
+    unsigned int batch_jobs = std::max(1U, std::thread::hardware_concurrency());
+    batch->add_option("--jobs", batch_jobs, "Number of threads solving problems")
+        ->check(CLI::PositiveNumber)
+        ->capture_default_str();
+    std::string batch_shard = "0/1";
+    batch->add_option("--shard", batch_shard,
+                      "Solve only shard i of N (i/N, from 0/N to N-1/N): the problems whose index modulo N is i")
+        ->capture_default_str();
+    std::string batch_summary;
+    batch->add_option("--summary", batch_summary, "Path of the summary file (default: standard output)");
+    std::string batch_summary_format = "csv";
+    batch->add_option("--summary-format", batch_summary_format, "Format of the summary rows")
+        ->check(CLI::IsMember({"csv", "jsonl"}))
+        ->capture_default_str();
+
+    // Result archives
+    auto* archive = app.add_subcommand("archive", "Inspect or merge indexed binary result archives");
+    std::string archive_file;
+    archive->add_option("--file", archive_file, "Path to the result archive (created if merging into a new one)")
+        ->required();
+    std::vector<std::string> archive_merge;
+    archive->add_option("--merge", archive_merge, "Archives whose records are appended to the archive, in order")
+        ->check(CLI::ExistingFile);
+    std::vector<std::size_t> archive_records;
+    archive->add_option("--record", archive_records, "Positions of the records to print as JSON objects");
+
+    // Parameter sweeps
+    auto* sweep = app.add_subcommand("sweep", "Solve a problem over a range of values of a parameter, seeding every "
+                                              "solve with the roots of the previous values");
+    std::string sweep_function;
+    sweep->add_option("-f,--function", sweep_function,
+                      "Function to find root of, whose terms may be multiplied by named parameters (e.g. x^2 - p)")
+        ->required();
+    std::string sweep_range;
+    sweep->add_option("--range", sweep_range,
+                      "Swept parameter and its values, as name=start:stop:step (e.g. p=0:10:0.1)")
+        ->required();
+    std::vector<std::string> sweep_set;
+    sweep->add_option("--set", sweep_set, "Values of the other parameters, as name=value");
+    std::string sweep_method = "newton";
+    sweep->add_option("--method", sweep_method, "Method solving every value of the parameter")
+        ->check(CLI::IsMember({"newton", "chords", "fixed_point", "bisection"}))
+        ->capture_default_str();
+    std::string sweep_derivative;
+    sweep->add_option("--derivative", sweep_derivative, "Derivative of the function (newton)");
+    std::string sweep_g_function;
+    sweep->add_option("--g-function", sweep_g_function, "g(x) for fixed-point iteration (fixed_point)");
+    double sweep_x0 = 0.0;
+    sweep->add_option("--x0", sweep_x0, "Initial guess, or first point of the interval (chords and bisection)")
+        ->capture_default_str();
+    double sweep_x1 = 1.0;
+    sweep->add_option("--x1", sweep_x1, "Second point of the interval (chords and bisection)")->capture_default_str();
+    double sweep_tolerance = 1e-5;
+    sweep->add_option("-t,--tolerance", sweep_tolerance, "Tolerance for convergence")
+        ->check(CLI::PositiveNumber)
+        ->capture_default_str();
+    int sweep_max_iterations = 100;
+    sweep->add_option("-n,--max-iterations", sweep_max_iterations, "Maximum number of iterations of every solve")
+        ->check(CLI::PositiveNumber)
+        ->capture_default_str();
+    bool sweep_aitken = false;
+    sweep->add_flag("-a,--aitken", sweep_aitken, "Enable Aitken acceleration")->capture_default_str();
+    unsigned int sweep_jobs = 1;
+    sweep->add_option("--jobs", sweep_jobs,
+                      "Number of threads, each continuing a contiguous sub-range from the initial guess")
+        ->check(CLI::PositiveNumber)
+        ->capture_default_str();
+    bool sweep_cold = false;
+    sweep->add_flag("--no-warm-start", sweep_cold, "Start every solve from the initial guess or interval");
+    std::string sweep_summary;
+    sweep->add_option("--summary", sweep_summary, "Path of the CSV rows (default: standard output)");
+
+    // Method portfolios
+    auto* portfolio = app.add_subcommand("portfolio", "Race several methods on the same problem and keep the first one "
+                                                      "to converge");
+    std::string portfolio_function;
+    portfolio->add_option("-f,--function", portfolio_function,
+                          "Function to find root of (only polynomial and simple trig expressions)")
+        ->required();
+    std::vector<std::string> portfolio_methods;
+    portfolio->add_option("--methods", portfolio_methods,
+                          "Methods racing on separate threads (default: chords, bisection, and newton and fixed_point "
+                          "when their functions are given)")
+        ->check(CLI::IsMember({"newton", "chords", "fixed_point", "bisection"}));
+    std::string portfolio_derivative;
+    portfolio->add_option("--derivative", portfolio_derivative, "Derivative of the function (newton)");
+    std::string portfolio_g_function;
+    portfolio->add_option("--g-function", portfolio_g_function, "g(x) for fixed-point iteration (fixed_point)");
+    double portfolio_x0 = 0.0;
+    portfolio->add_option("--x0", portfolio_x0, "Initial guess, and first point of the interval (chords and bisection)")
+        ->capture_default_str();
+    double portfolio_x1 = 1.0;
+    portfolio->add_option("--x1", portfolio_x1, "Second point of the interval (chords and bisection)")
+        ->capture_default_str();
+    double portfolio_tolerance = 1e-5;
+    portfolio->add_option("-t,--tolerance", portfolio_tolerance, "Tolerance for convergence")
+        ->check(CLI::PositiveNumber)
+        ->capture_default_str();
+    int portfolio_max_iterations = 100;
+    portfolio->add_option("-n,--max-iterations", portfolio_max_iterations, "Maximum number of iterations")
+        ->check(CLI::PositiveNumber)
+        ->capture_default_str();
+    bool portfolio_aitken = false;
+    portfolio->add_flag("-a,--aitken", portfolio_aitken, "Enable Aitken acceleration")->capture_default_str();
 
     // CLI
     auto* cli = app.add_subcommand("cli", "Use CLI input");
@@ -124,84 +614,657 @@ int main(int argc, char** argv) {
     // options and subcommands.
     // !!!!!!!!!!!!!!!!!!!!!! IMPORTANT !!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
+    // the limits of the command line bound the solving process of every problem, whatever its input
+    auto apply_limits = [time_limit, max_evaluations](ConfigBase& config) {
+        config.time_limit = time_limit;
+        config.max_evaluations = max_evaluations;
+    };
+
+    // ------------------------------------------------------------
+    // Pipe mode: solve and write every problem as soon as it is read
+    // ------------------------------------------------------------
+    if (*pipe) {
+        // results own standard output, every other message is sent to standard error
+        std::ostream results_stream(std::cout.rdbuf());
+        std::cout.rdbuf(std::cerr.rdbuf());
+
+        WritingMethod output_method = WritingMethod::JSONL;
+        if (pipe_output == "csv") {
+            output_method = WritingMethod::CSV;
+        } else if (pipe_output == "dat") {
+            output_method = WritingMethod::DAT;
+        }
+
+        ReaderPipe pipe_reader(std::cin);
+        int solved = 0;
+        while (true) {
+            std::unique_ptr<ConfigBase> config;
+            std::string error;
+            Solution solution;
+            // a malformed problem is answered with an error record, and the stream goes on with the next one
+            bool solved_problem = pipe_reader.try_read(pipe, verbose, config, error);
+            if (solved_problem && !config) {
+                break;
+            }
+            if (solved_problem) {
+                apply_limits(*config);
+                if (!try_solve_config(*config, solution)) {
+                    solved_problem = false;
+                    error = "out of memory";
+                }
+            }
+            if (!solved_problem) {
+                std::cerr << "\033[31mReaderPipe: " << error << "\033[0m\n";
+                if (output_method == WritingMethod::JSONL) {
+                    results_stream << daemon_error(error) << '\n';
+                } else {
+                    results_stream << "# error: " << error << "\n\n";
+                }
+            } else {
+                {
+                    Writer<Eigen::MatrixX2d> writer(solution.results, output_method, results_stream.rdbuf(),
+                                                    w_csv_sep);
+                    writer.write();
+                }
+                // JSON Lines are self-delimiting, the other formats separate problems with an empty line
+                if (output_method != WritingMethod::JSONL) {
+                    results_stream << '\n';
+                }
+            }
+            if (flush_every > 0 && ++solved % flush_every == 0) {
+                results_stream.flush();
+            }
+        }
+        results_stream.flush();
+        std::cout.rdbuf(results_stream.rdbuf());
+        return 0;
+    }
+
+    // ------------------------------------------------------------
+    // Daemon mode: answer requests from a warm process
+    // ------------------------------------------------------------
+    if (*daemon) {
+        // results are sent back on the socket, solver messages are only useful when debugging
+        if (!verbose) {
+            std::cout.setstate(std::ios::badbit);
+        }
+        FunctionCache cache;
+        SolverDaemon server(daemon_socket, daemon_threads,
+                            [&cache, &apply_limits](const std::string& request) {
+                                return answer_request(request, cache, apply_limits);
+                            });
+        std::cerr << "Listening on " << daemon_socket << " with " << daemon_threads << " worker threads\n";
+        server.serve();
+        return 0;
+    }
+
+    if (*shm) {
+        if (!verbose) {
+            std::cout.setstate(std::ios::badbit);
+        }
+        FunctionCache cache;
+        ShmServer server(shm_name, shm_capacity,
+                         [&cache, &apply_limits](const ShmRequest& request) {
+                             return answer_shm_request(request, cache, apply_limits);
+                         });
+        std::cerr << "Serving shared-memory segment " << shm_name << "\n";
+        server.serve();
+        return 0;
+    }
+
+    // ------------------------------------------------------------
+    // Batch mode: solve a shard of a batch on a pool of threads
+    // ------------------------------------------------------------
+    if (*batch) {
+        BatchShard shard;
+        if (!parse_batch_shard(batch_shard, shard)) {
+            std::cerr << "\033[31mError: invalid shard " << batch_shard << ", expected i/N with 0 <= i < N\033[0m\n";
+            return EXIT_FAILURE;
+        }
+        std::string format = batch_format;
+        if (format == "auto") {
+            format = std::filesystem::path(batch_file).extension().string();
+            format = format.empty() ? format : format.substr(1);
+        }
+
+        std::unique_ptr<ReaderBase> batch_reader;
+        if (format == "csv") {
+            batch_reader = std::make_unique<ReaderCSV>();
+        } else if (format == "dat") {
+            batch_reader = std::make_unique<ReaderDAT>();
+        } else if (format == "jsonl") {
+            batch_reader = std::make_unique<ReaderJSONL>();
+        } else if (format != "bin") {
+            std::cerr << "\033[31mError: cannot infer the format of " << batch_file << ", use --format\033[0m\n";
+            return EXIT_FAILURE;
+        }
+
+        // the summary owns standard output (unless written on a file), and the messages of the solvers, which would
+        // interleave across threads, are only written on standard error when verbose
+        std::ostream summary(std::cout.rdbuf());
+        std::ofstream summary_file;
+        // a summary appended to an existing one does not repeat its header
+        bool header = batch_summary.empty() || append_or_overwrite == 'o' || !std::filesystem::exists(batch_summary) ||
+                      std::filesystem::file_size(batch_summary) == 0;
+        if (!batch_summary.empty()) {
+            summary_file.open(batch_summary, append_or_overwrite == 'a' ? std::ios::app : std::ios::trunc);
+            if (!summary_file.is_open()) {
+                std::cerr << "\033[31mError: could not open file " << batch_summary << " for writing.\033[0m\n";
+                return EXIT_FAILURE;
+            }
+            summary.rdbuf(summary_file.rdbuf());
+        }
+        std::streambuf* console = std::cout.rdbuf();
+        if (verbose) {
+            std::cout.rdbuf(std::cerr.rdbuf());
+        } else {
+            std::cout.setstate(std::ios::badbit);
+        }
+
+        // a binary batch is solved straight from the mapped columns: the configuration of a problem only exists while
+        // it is solved, and none is built for the problems of other shards
+        std::unique_ptr<BinaryBatchView> batch_view;
+        std::vector<std::function<double(double)>> batch_functions;
+        std::vector<std::unique_ptr<ConfigBase>> batch_configs;
+        if (batch_reader) {
+            batch_configs = batch_reader->read_all(batch, verbose);
+            for (auto& config : batch_configs) {
+                apply_limits(*config);
+            }
+        } else {
+            batch_view = std::make_unique<BinaryBatchView>(batch_file);
+            batch_functions = ReaderBIN::parse_batch(*batch_view);
+        }
+        std::size_t problems = batch_view ? batch_view->size() : batch_configs.size();
+        std::unique_ptr<ResultArchiveWriter> batch_archive;
+        if (!write_to_archive.empty()) {
+            batch_archive =
+                std::make_unique<ResultArchiveWriter>(write_to_archive + ".rra", append_or_overwrite == 'a');
+        }
+
+        // rows are written in blocks rather than one by one, and only the summary of every problem is kept
+        std::string rows;
+        if (batch_summary_format == "csv" && header) {
+            rows = batch_csv_header(w_csv_sep);
+        }
+        std::size_t converged = 0;
+        auto start = std::chrono::steady_clock::now();
+        auto solve_problem = [keep_results = batch_archive != nullptr](const ConfigBase& config, std::size_t id) {
+            auto begin = std::chrono::steady_clock::now();
+            Solution solution = solve_config(config);
+
+            BatchRow row;
+            row.id = id;
+            row.name = config.name;
+            row.status = solution.status;
+            row.evaluations = solution.evaluations;
+            if (solution.results.rows() > 0) {
+                Eigen::Vector2d estimate = solution.estimate();
+                row.root = estimate(0);
+                row.residual = std::abs(estimate(1));
+                row.iterations = static_cast<int>(solution.results.rows() - 1);
+            }
+            row.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            if (keep_results) {
+                row.results = std::move(solution.results);
+            }
+            return row;
+        };
+        auto solve = [&](std::size_t id) {
+            if (!batch_view) {
+                return solve_problem(*batch_configs[id], id);
+            }
+            BatchRow row;
+            ReaderBIN::visit_row(*batch_view, batch_functions, id, verbose, [&](ConfigBase& config) {
+                apply_limits(config);
+                row = solve_problem(config, id);
+            });
+            return row;
+        };
+        auto emit = [&](BatchRow& row) {
+            if (batch_summary_format == "csv") {
+                append_batch_csv(rows, row, w_csv_sep);
+            } else {
+                append_batch_jsonl(rows, row);
+            }
+            if (rows.size() >= 65536) {
+                summary << rows;
+                rows.clear();
+            }
+            if (batch_archive) {
+                batch_archive->add(row.id, row.name, row.status, row.evaluations, row.results, archive_trajectories);
+            }
+            converged += row.status == SolverStatus::CONVERGED ? 1 : 0;
+        };
+        std::size_t solved = run_batch(problems, shard, batch_jobs, solve, emit);
+        summary << rows;
+        summary.flush();
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cerr << "Solved " << solved << " problems of shard " << batch_shard << " in " << elapsed.count()
+                  << " s (" << converged << " converged)\n";
+        std::cout.rdbuf(console);
+        return 0;
+    }
+
+    if (*archive) {
+        if (!archive_merge.empty()) {
+            merge_result_archives(archive_file, archive_merge);
+        }
+        ResultArchiveReader reader(archive_file);
+        for (std::size_t position : archive_records) {
+            if (position >= reader.size()) {
+                std::cerr << "\033[31mError: the archive holds " << reader.size() << " records, there is no record "
+                          << position << "\033[0m\n";
+                return EXIT_FAILURE;
+            }
+            std::cout << result_record_json(reader.record(position)) << '\n';
+        }
+        if (archive_records.empty()) {
+            std::cout << reader.size() << " records in " << archive_file << std::endl;
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------
+    // Sweep mode: continue the roots over a range of a parameter
+    // ------------------------------------------------------------
+    if (*sweep) {
+        SweepRange range;
+        if (!parse_sweep_range(sweep_range, range)) {
+            std::cerr << "\033[31mError: invalid range " << sweep_range
+                      << ", expected name=start:stop:step with a step going from start towards stop\033[0m\n";
+            return EXIT_FAILURE;
+        }
+        std::vector<std::pair<std::string, double>> fixed_parameters;
+        for (const auto& assignment : sweep_set) {
+            std::pair<std::string, double> parameter;
+            if (!parse_sweep_parameter(assignment, parameter.first, parameter.second) ||
+                parameter.first == range.name) {
+                std::cerr << "\033[31mError: invalid parameter " << assignment << ", expected name=value\033[0m\n";
+                return EXIT_FAILURE;
+            }
+            fixed_parameters.push_back(parameter);
+        }
+        Method method = Method::NEWTON;
+        if (sweep_method == "chords") {
+            method = Method::CHORDS;
+        } else if (sweep_method == "fixed_point") {
+            method = Method::FIXED_POINT;
+        } else if (sweep_method == "bisection") {
+            method = Method::BISECTION;
+        }
+        if ((method == Method::NEWTON && sweep_derivative.empty()) ||
+            (method == Method::FIXED_POINT && sweep_g_function.empty())) {
+            std::cerr << "\033[31mError: the " << sweep_method << " method needs "
+                      << (method == Method::NEWTON ? "--derivative" : "--g-function") << "\033[0m\n";
+            return EXIT_FAILURE;
+        }
+
+        std::ostream summary(std::cout.rdbuf());
+        std::ofstream summary_file;
+        if (!sweep_summary.empty()) {
+            summary_file.open(sweep_summary, std::ios::trunc);
+            if (!summary_file.is_open()) {
+                std::cerr << "\033[31mError: could not open file " << sweep_summary << " for writing.\033[0m\n";
+                return EXIT_FAILURE;
+            }
+            summary.rdbuf(summary_file.rdbuf());
+        }
+
+        // every chunk of the range parses its own functions, bound to its own copy of the parameters
+        auto make_problem = [&]() {
+            SweepProblem problem;
+            problem.parameter = std::make_shared<double>(range.start);
+            FunctionParameters parameters{{range.name, problem.parameter}};
+            for (const auto& [name, value] : fixed_parameters) {
+                parameters[name] = std::make_shared<double>(value);
+            }
+            problem.function = FunctionParserBase::parseFunction(sweep_function, parameters);
+            std::function<double(double)> auxiliary;
+            if (method == Method::NEWTON) {
+                auxiliary = FunctionParserBase::parseFunction(sweep_derivative, parameters);
+            } else if (method == Method::FIXED_POINT) {
+                auxiliary = FunctionParserBase::parseFunction(sweep_g_function, parameters);
+            }
+            problem.solve = [&, function = problem.function, auxiliary](const SweepSeed& seed) {
+                SweepPoint point;
+                auto config = make_config(method, sweep_tolerance, sweep_max_iterations, sweep_aitken, function,
+                                          auxiliary, seed.first, seed.second, verbose);
+                if (config) {
+                    apply_limits(*config);
+                } else {
+                    // a value of the parameter without a root in the interval does not end the whole sweep
+                    point.status = SolverStatus::DIVERGED;
+                    point.root = std::numeric_limits<double>::quiet_NaN();
+                    point.residual = std::numeric_limits<double>::quiet_NaN();
+                    point.evaluations = 2;
+                    return point;
+                }
+                Solution solution = solve_config(*config);
+                point.status = solution.status;
+                point.evaluations = solution.evaluations;
+                if (solution.results.rows() > 0) {
+                    Eigen::Vector2d estimate = solution.estimate();
+                    point.root = estimate(0);
+                    point.residual = std::abs(estimate(1));
+                    point.iterations = static_cast<int>(solution.results.rows() - 1);
+                }
+                return point;
+            };
+            return problem;
+        };
+        // the expressions are parsed once on this thread first, so that errors are reported before any solve
+        make_problem();
+
+        std::streambuf* console = std::cout.rdbuf();
+        if (verbose) {
+            std::cout.rdbuf(std::cerr.rdbuf());
+        } else {
+            std::cout.setstate(std::ios::badbit);
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::vector<SweepPoint> points =
+            run_sweep(range, method, {sweep_x0, sweep_x1}, !sweep_cold, sweep_jobs, make_problem);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::string rows = sweep_csv_header(range.name, w_csv_sep);
+        std::size_t converged = 0;
+        long iterations = 0;
+        for (const auto& point : points) {
+            append_sweep_csv(rows, point, w_csv_sep);
+            converged += point.status == SolverStatus::CONVERGED ? 1 : 0;
+            iterations += point.iterations;
+        }
+        summary << rows;
+        summary.flush();
+
+        std::cerr << "Swept " << points.size() << " values of " << range.name << " in " << elapsed.count() << " s ("
+                  << converged << " converged, " << iterations << " iterations)\n";
+        std::cout.rdbuf(console);
+        return 0;
+    }
+
+    // ------------------------------------------------------------
+    // Portfolio mode: race several methods on the same problem
+    // ------------------------------------------------------------
+    if (*portfolio) {
+        std::vector<Method> methods;
+        if (portfolio_methods.empty()) {
+            if (!portfolio_derivative.empty()) {
+                methods.push_back(Method::NEWTON);
+            }
+            methods.push_back(Method::CHORDS);
+            if (!portfolio_g_function.empty()) {
+                methods.push_back(Method::FIXED_POINT);
+            }
+            methods.push_back(Method::BISECTION);
+        }
+        for (const auto& name : portfolio_methods) {
+            Method method = Method::NEWTON;
+            parse_portfolio_method(name, method);
+            if ((method == Method::NEWTON && portfolio_derivative.empty()) ||
+                (method == Method::FIXED_POINT && portfolio_g_function.empty())) {
+                std::cerr << "\033[31mError: the " << name << " method needs "
+                          << (method == Method::NEWTON ? "--derivative" : "--g-function") << "\033[0m\n";
+                return EXIT_FAILURE;
+            }
+            methods.push_back(method);
+        }
+
+        // the functions are parsed once and shared by the racing threads, which only call them
+        auto function = FunctionParserBase::parseFunction(portfolio_function);
+        std::function<double(double)> derivative;
+        std::function<double(double)> g_function;
+        if (!portfolio_derivative.empty()) {
+            derivative = FunctionParserBase::parseFunction(portfolio_derivative);
+        }
+        if (!portfolio_g_function.empty()) {
+            g_function = FunctionParserBase::parseFunction(portfolio_g_function);
+        }
+
+        std::streambuf* console = std::cout.rdbuf();
+        std::ostream summary(console);
+        if (verbose) {
+            std::cout.rdbuf(std::cerr.rdbuf());
+        } else {
+            std::cout.setstate(std::ios::badbit);
+        }
+        PortfolioResult result = race_portfolio(methods, [&](Method method, std::stop_token stop) {
+            PortfolioEntry entry;
+            auto config = make_config(method, portfolio_tolerance, portfolio_max_iterations, portfolio_aitken,
+                                      function, method == Method::NEWTON ? derivative : g_function, portfolio_x0,
+                                      portfolio_x1, verbose);
+            if (config) {
+                apply_limits(*config);
+            } else {
+                // bisection cannot run without a sign change, it simply drops out of the race
+                entry.status = SolverStatus::DIVERGED;
+                entry.root = std::numeric_limits<double>::quiet_NaN();
+                entry.residual = std::numeric_limits<double>::quiet_NaN();
+                entry.evaluations = 2;
+                return entry;
+            }
+            Solution solution = solve_config(*config, stop);
+            entry.status = solution.status;
+            entry.evaluations = solution.evaluations;
+            if (solution.results.rows() > 0) {
+                Eigen::Vector2d estimate = solution.estimate();
+                entry.root = estimate(0);
+                entry.residual = std::abs(estimate(1));
+                entry.iterations = static_cast<int>(solution.results.rows() - 1);
+            }
+            return entry;
+        });
+
+        std::string rows = portfolio_csv_header(w_csv_sep);
+        for (std::size_t i = 0; i < result.entries.size(); ++i) {
+            append_portfolio_csv(rows, result.entries[i], result.winner == i, w_csv_sep);
+        }
+        summary << rows;
+        summary.flush();
+        if (result.winner) {
+            const PortfolioEntry& winner = result.entries[*result.winner];
+            std::cerr << "The found root is " << winner.root << " (" << portfolio_method_name(winner.method) << ", "
+                      << winner.iterations << " iterations)\n";
+        } else {
+            std::cerr << "\033[31mNo method of the portfolio converged\033[0m\n";
+        }
+        std::cout.rdbuf(console);
+        return result.winner ? 0 : EXIT_FAILURE;
+    }
+
+    if (*client) {
+        std::ifstream client_input;
+        if (!client_file.empty()) {
+            client_input.open(client_file);
+        }
+        std::istream& requests = client_file.empty() ? std::cin : client_input;
+        int fd = connect_daemon(client_socket);
+        std::string response;
+        for (std::string line; std::getline(requests, line);) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            if (!write_frame(fd, line) || !read_frame(fd, response)) {
+                std::cerr << "\033[31mError: connection to the daemon closed\033[0m\n";
+                return EXIT_FAILURE;
+            }
+            std::cout << response << '\n';
+        }
+        if (client_stop) {
+            write_frame(fd, "");
+        }
+        std::cout.flush();
+        ::close(fd);
+        return 0;
+    }
+
     // ------------------------------------------------------------
     // Initialise pointers nand variables
     // ------------------------------------------------------------
-    std::unique_ptr<ConfigBase> config;
+    std::vector<std::unique_ptr<ConfigBase>> configs;
     std::unique_ptr<ReaderBase> reader;
-    Eigen::MatrixX2d results;
+    // a JSON Lines file is read one line at a time, each problem being solved before the next line is read
+    ReaderJSONL jsonl_reader;
+    // only compared with 1: a JSON Lines file is not read to the end upfront, it may be a pipe
+    size_t problems = 0;
 
     // ------------------------------------------------------------
     // Reader execution
     // ------------------------------------------------------------
     if (*csv) {
         reader = std::make_unique<ReaderCSV>();
-        config = reader->read(csv, verbose);
+        configs = reader->read_all(csv, verbose);
     } else if (*dat) {
         reader = std::make_unique<ReaderDAT>();
-        config = reader->read(dat, verbose);
+        configs = reader->read_all(dat, verbose);
+    } else if (*bin) {
+        reader = std::make_unique<ReaderBIN>();
+        configs = reader->read_all(bin, verbose);
+    } else if (*jsonl) {
+        problems = jsonl_reader.open(jsonl);
     } else if (*cli) {
         reader = std::make_unique<ReaderCLI>();
-        config = reader->read(cli, verbose);
+        configs = reader->read_all(cli, verbose);
+    }
+    if (!*jsonl) {
+        problems = configs.size();
     }
+    auto next_config = [&, position = size_t{0}]() mutable -> std::unique_ptr<ConfigBase> {
+        if (*jsonl) {
+            return jsonl_reader.read_next(verbose);
+        }
+        return position < configs.size() ? std::move(configs[position++]) : nullptr;
+    };
 
     // ------------------------------------------------------------
-    // Solver execution
+    // Output selection
     // ------------------------------------------------------------
-    switch (config->method) {
-        case Method::BISECTION: {
-            Eigen::Vector2d interval = {dynamic_cast<BisectionConfig*>(config.get())->initial_point,
-                                        dynamic_cast<BisectionConfig*>(config.get())->final_point};
-            Solver solver(config->function, interval, config->method, config->max_iterations, config->tolerance,
-                          config->aitken, config->verbose);
-            results = solver.solve();
-            break;
+    // every requested output is written in the same pass over the results
+    std::vector<WriterSink> sinks;
+    if (write_to_cli) {
+        sinks.push_back({WritingMethod::CONSOLE});
+    }
+    if (!write_to_csv.empty()) {
+        sinks.push_back({WritingMethod::CSV, write_to_csv, w_csv_sep});
+    }
+    if (!write_to_jsonl.empty()) {
+        sinks.push_back({WritingMethod::JSONL, write_to_jsonl});
+    }
+    if (!write_to_dat.empty()) {
+        sinks.push_back({write_with_gnuplot ? WritingMethod::GNUPLOT : WritingMethod::DAT, write_to_dat});
+    }
+
+    // several problems are gathered in a single .npz archive: the trajectory of each problem as two arrays
+    // (x_<name> and f_<name>, named after the section or the index of the problem) and the final root, f(root) and
+    // number of iterations of every problem as three more arrays
+    std::unique_ptr<NpzWriter> npz;
+    std::vector<double> npz_roots, npz_f_roots;
+    std::vector<std::int32_t> npz_iterations;
+    if (!write_to_npy.empty() && problems > 1) {
+        npz = std::make_unique<NpzWriter>(write_to_npy + ".npz");
+    } else if (!write_to_npy.empty()) {
+        sinks.push_back({WritingMethod::NPY, write_to_npy});
+    }
+
+    // the archive is extended rather than rewritten when appending, so that the records of earlier runs stay indexed
+    std::unique_ptr<ResultArchiveWriter> result_archive;
+    if (!write_to_archive.empty()) {
+        result_archive = std::make_unique<ResultArchiveWriter>(write_to_archive + ".rra", append_or_overwrite == 'a');
+    }
+
+    // the iteration paths of every problem are drawn on the same plot, written once every problem is solved
+    std::unique_ptr<ConvergencePlot> plot;
+    if (!write_to_svg.empty() || !write_to_png.empty()) {
+        plot = std::make_unique<ConvergencePlot>();
+    }
+
+    // when several problems are written on files, the files are written by a background thread while the next
+    // problems are solved; the root of every problem is still reported right after it is solved, and the command
+    // line is always written by the solving thread
+    std::unique_ptr<AsyncWriter> async_writer;
+    if ((npz || plot || result_archive || !sinks.empty()) && !write_to_cli && problems > 1 && write_queue > 0) {
+        async_writer = std::make_unique<AsyncWriter>(write_queue);
+    }
+
+    for (size_t i = 0; auto config = next_config(); ++i) {
+        apply_limits(*config);
+        if (!config->name.empty()) {
+            std::cout << "Problem [" << config->name << "]" << std::endl;
         }
-        case Method::NEWTON: {
-            Solver solver(config->function, dynamic_cast<NewtonConfig*>(config.get())->initial_guess, config->method,
-                          config->max_iterations, config->tolerance, config->aitken, config->verbose,
-                          dynamic_cast<NewtonConfig*>(config.get())->derivative);
-            results = solver.solve();
-            break;
+
+        // ------------------------------------------------------------
+        // Solver execution
+        // ------------------------------------------------------------
+        // the results are shared by the write jobs, which only borrow them until they are written
+        Solution solution = solve_config(*config);
+        auto results = std::make_shared<const Eigen::MatrixX2d>(std::move(solution.results));
+
+        // ------------------------------------------------------------
+        // Writer execution
+        // ------------------------------------------------------------
+        // every problem after the first one is appended to the same output file
+        bool overwrite = append_or_overwrite == 'o' && i == 0;
+        std::function<void()> job;
+        if (!sinks.empty()) {
+            Writer<Eigen::MatrixX2d> writer(*results, sinks, overwrite);
+            writer.print_root();
+            job = [results, writer]() mutable { writer.write_rows(); };
+        } else if (npz || plot || result_archive) {
+            std::cout << "The found root is " << (*results)(results->rows() - 1, 0) << std::endl;
         }
-        case Method::CHORDS: {
-            Eigen::Vector2d interval = {dynamic_cast<ChordsConfig*>(config.get())->initial_point1,
-                                        dynamic_cast<ChordsConfig*>(config.get())->initial_point2};
-            Solver solver(config->function, interval, config->method, config->max_iterations, config->tolerance,
-                          config->aitken, config->verbose);
-            results = solver.solve();
-            break;
+        if (npz || plot || result_archive) {
+            std::string key = config->name.empty() ? std::to_string(i) : config->name;
+            std::string label = problems > 1 ? key : config->name;
+            job = [&npz, &npz_roots, &npz_f_roots, &npz_iterations, &plot, &result_archive, archive_trajectories, i,
+                   name = config->name, status = solution.status, evaluations = solution.evaluations, key, label,
+                   results, write_sinks = job] {
+                if (write_sinks) {
+                    write_sinks();
+                }
+                if (result_archive) {
+                    result_archive->add(i, name, status, evaluations, *results, archive_trajectories);
+                }
+                if (plot) {
+                    plot->add(label, *results);
+                }
+                if (!npz) {
+                    return;
+                }
+                // Eigen stores the matrix column by column, so each column is written straight from its memory
+                const auto rows = static_cast<size_t>(results->rows());
+                const std::string header = npy_header("<f8", {rows}, false);
+                npz->add("x_" + key, header, results->col(0).data(), rows * sizeof(double));
+                npz->add("f_" + key, header, results->col(1).data(), rows * sizeof(double));
+                npz_roots.push_back((*results)(rows - 1, 0));
+                npz_f_roots.push_back((*results)(rows - 1, 1));
+                npz_iterations.push_back(static_cast<std::int32_t>(rows - 1));
+            };
         }
-        case Method::FIXED_POINT: {
-            Solver solver(config->function, dynamic_cast<FixedPointConfig*>(config.get())->initial_guess,
-                          config->method, config->max_iterations, config->tolerance, config->aitken, config->verbose,
-                          dynamic_cast<FixedPointConfig*>(config.get())->g_function);
-            results = solver.solve();
-            break;
+
+        if (async_writer) {
+            async_writer->submit(std::move(job));
+        } else if (job) {
+            job();
         }
-        default:
-            break;
     }
 
-    // ------------------------------------------------------------
-    // Writer execution
-    // ------------------------------------------------------------
-    if (write_to_cli) {
-        Writer<Eigen::MatrixX2d> writer(results, WritingMethod::CONSOLE);
-        writer.write();
-    } else if (!write_to_csv.empty()) {
-        Writer<Eigen::MatrixX2d> writer(results, WritingMethod::CSV, write_to_csv, w_csv_sep,
-                                        append_or_overwrite == 'o');
-        writer.write();
-    } else if (!write_to_dat.empty()) {
-        if (write_with_gnuplot) {
-            Writer<Eigen::MatrixX2d> writer(results, WritingMethod::GNUPLOT, write_to_dat, ' ',
-                                            append_or_overwrite == 'o');
-            writer.write();
-        } else {
-            Writer<Eigen::MatrixX2d> writer(results, WritingMethod::DAT, write_to_dat, ' ', append_or_overwrite == 'o');
-            writer.write();
-        }
+    // wait for the background writer before closing the archives and drawing the plots
+    async_writer.reset();
+    result_archive.reset();
+    if (npz) {
+        npz->add("root", npz_roots);
+        npz->add("f_root", npz_f_roots);
+        npz->add("iterations", npz_iterations);
+    }
+    if (plot && !write_to_svg.empty()) {
+        plot->write_svg(write_to_svg + ".svg");
+        std::cout << "Plot generated: " << write_to_svg << ".svg" << std::endl;
+    }
+    if (plot && !write_to_png.empty()) {
+        plot->write_png(write_to_png + ".png");
+        std::cout << "Plot generated: " << write_to_png << ".png" << std::endl;
     }
 
     return 0;
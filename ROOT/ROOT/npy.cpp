@@ -0,0 +1,159 @@
+/**
+ * @file npy.cpp
+ * @brief Implementation of the .npy header builder and of the .npz archive writer.
+ *
+ * The ZIP records are written field by field in little-endian order, following the PKWARE APPNOTE; only the
+ * "stored" method is used, so no compression library is needed.
+ *
+ * @author Saransh-cpp
+ */
+#include "npy.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdlib>
+#include <iostream>
+
+static_assert(std::endian::native == std::endian::little, "the .npy writer assumes a little-endian host");
+
+namespace {
+
+constexpr std::uint32_t zip_local_header = 0x04034b50;
+constexpr std::uint32_t zip_central_header = 0x02014b50;
+constexpr std::uint32_t zip_end_of_directory = 0x06054b50;
+constexpr std::uint16_t zip_version = 20;  // 2.0, the minimum version for plain stored members
+
+std::array<std::uint32_t, 256> make_crc_table() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+void put16(std::string& out, std::uint16_t value) {
+    out += static_cast<char>(value & 0xFF);
+    out += static_cast<char>(value >> 8);
+}
+
+void put32(std::string& out, std::uint32_t value) {
+    put16(out, static_cast<std::uint16_t>(value & 0xFFFF));
+    put16(out, static_cast<std::uint16_t>(value >> 16));
+}
+
+}  // namespace
+
+std::string npy_header(const std::string& descr, const std::vector<std::size_t>& shape, bool fortran_order) {
+    std::string dict = "{'descr': '" + descr + "', 'fortran_order': " + (fortran_order ? "True" : "False") +
+                       ", 'shape': (";
+    for (std::size_t i = 0; i < shape.size(); ++i) {
+        dict += std::to_string(shape[i]);
+        dict += (shape.size() == 1 || i + 1 < shape.size()) ? "," : "";
+        dict += i + 1 < shape.size() ? " " : "";
+    }
+    dict += "), }";
+
+    // magic (6 bytes), version (2 bytes) and header length (2 bytes) come before the dictionary, which is padded
+    // with spaces and terminated by a newline so that the data is aligned on 64 bytes
+    const std::size_t preamble = 10;
+    std::size_t total = preamble + dict.size() + 1;
+    total = (total + 63) / 64 * 64;
+    dict.append(total - preamble - dict.size() - 1, ' ');
+    dict += '\n';
+
+    std::string header("\x93NUMPY\x01\x00", 8);
+    put16(header, static_cast<std::uint16_t>(dict.size()));
+    return header + dict;
+}
+
+std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc) {
+    static const std::array<std::uint32_t, 256> table = make_crc_table();
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+NpzWriter::NpzWriter(const std::string& filename) : filename(filename), file(filename, std::ios::binary) {
+    if (!file.is_open()) {
+        std::cerr << "\033[31mError: could not open file " << filename << " for writing.\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+NpzWriter::~NpzWriter() {
+    std::string directory;
+    for (const Entry& entry : entries) {
+        put32(directory, zip_central_header);
+        put16(directory, zip_version);  // version made by
+        put16(directory, zip_version);  // version needed to extract
+        put16(directory, 0);            // flags
+        put16(directory, 0);            // method: stored
+        put16(directory, 0);            // modification time
+        put16(directory, 0x21);         // modification date (1980-01-01)
+        put32(directory, entry.crc);
+        put32(directory, entry.size);  // compressed size
+        put32(directory, entry.size);  // uncompressed size
+        put16(directory, static_cast<std::uint16_t>(entry.name.size()));
+        put16(directory, 0);  // extra field length
+        put16(directory, 0);  // comment length
+        put16(directory, 0);  // disk number
+        put16(directory, 0);  // internal attributes
+        put32(directory, 0);  // external attributes
+        put32(directory, entry.offset);
+        directory += entry.name;
+    }
+    const auto directory_offset = static_cast<std::uint32_t>(file.tellp());
+    const auto directory_size = static_cast<std::uint32_t>(directory.size());
+
+    put32(directory, zip_end_of_directory);
+    put16(directory, 0);  // disk number
+    put16(directory, 0);  // disk with the central directory
+    put16(directory, static_cast<std::uint16_t>(entries.size()));
+    put16(directory, static_cast<std::uint16_t>(entries.size()));
+    put32(directory, directory_size);
+    put32(directory, directory_offset);
+    put16(directory, 0);  // comment length
+    file.write(directory.data(), static_cast<std::streamsize>(directory.size()));
+}
+
+void NpzWriter::add(const std::string& name, const std::vector<double>& values) {
+    add(name, npy_header("<f8", {values.size()}, false), values.data(), values.size() * sizeof(double));
+}
+
+void NpzWriter::add(const std::string& name, const std::vector<std::int32_t>& values) {
+    add(name, npy_header("<i4", {values.size()}, false), values.data(), values.size() * sizeof(std::int32_t));
+}
+
+void NpzWriter::add(const std::string& name, const std::string& header, const void* data, std::size_t size) {
+    Entry entry;
+    entry.name = name + ".npy";
+    entry.crc = crc32(data, size, crc32(header.data(), header.size()));
+    entry.size = static_cast<std::uint32_t>(header.size() + size);
+    entry.offset = static_cast<std::uint32_t>(file.tellp());
+
+    std::string local;
+    put32(local, zip_local_header);
+    put16(local, zip_version);
+    put16(local, 0);     // flags
+    put16(local, 0);     // method: stored
+    put16(local, 0);     // modification time
+    put16(local, 0x21);  // modification date (1980-01-01)
+    put32(local, entry.crc);
+    put32(local, entry.size);
+    put32(local, entry.size);
+    put16(local, static_cast<std::uint16_t>(entry.name.size()));
+    put16(local, 0);  // extra field length
+    local += entry.name;
+    local += header;
+
+    file.write(local.data(), static_cast<std::streamsize>(local.size()));
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    entries.push_back(entry);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file npy.hpp
+ * @brief Helpers to write NumPy .npy arrays and uncompressed .npz archives.
+ *
+ * An .npy file is a small text header describing the array (dtype, memory order and shape) followed by the raw
+ * little-endian data, so that numpy.load only has to copy the data. An .npz file is a ZIP archive of .npy files;
+ * the archives written here use the "stored" method (no compression), so every array can still be read with a
+ * single copy.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef NPY_HPP
+#define NPY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Build the header of an .npy (version 1.0) file, padded so that the data starts at a 64-byte boundary.
+ *
+ * @param descr The NumPy type descriptor of the elements (e.g. "<f8" for little-endian doubles).
+ * @param shape The dimensions of the array.
+ * @param fortran_order Whether the data is stored column by column (true) or row by row (false).
+ * @return The header bytes, to be written right before the data.
+ */
+std::string npy_header(const std::string& descr, const std::vector<std::size_t>& shape, bool fortran_order);
+
+/**
+ * @brief Compute the CRC-32 (as used by ZIP) of a block of bytes.
+ *
+ * @param data The bytes.
+ * @param size The number of bytes.
+ * @param crc The CRC of the preceding bytes, to compute the CRC of a sequence of blocks.
+ * @return The CRC-32 of the bytes.
+ */
+std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc = 0);
+
+/**
+ * @brief Writer of uncompressed .npz archives, adding one .npy array at a time.
+ *
+ * The central directory of the archive is written when the writer is destroyed. Archives are limited to 4 GiB
+ * (ZIP64 is not supported).
+ */
+class NpzWriter {
+  public:
+    /**
+     * @brief Create (or overwrite) an archive.
+     *
+     * @param filename The path of the archive, including its extension.
+     */
+    explicit NpzWriter(const std::string& filename);
+    /**
+     * @brief Write the central directory and close the archive.
+     *
+     */
+    ~NpzWriter();
+    NpzWriter(const NpzWriter&) = delete;
+    NpzWriter& operator=(const NpzWriter&) = delete;
+    /**
+     * @brief Add a 1-dimensional array of doubles.
+     *
+     * @param name The name of the array (the archive member is called name + ".npy").
+     * @param values The elements of the array.
+     */
+    void add(const std::string& name, const std::vector<double>& values);
+    /**
+     * @brief Add a 1-dimensional array of 32-bit integers.
+     *
+     * @param name The name of the array (the archive member is called name + ".npy").
+     * @param values The elements of the array.
+     */
+    void add(const std::string& name, const std::vector<std::int32_t>& values);
+    /**
+     * @brief Add an array from raw little-endian data.
+     *
+     * @param name The name of the array (the archive member is called name + ".npy").
+     * @param header The .npy header describing the data (see npy_header).
+     * @param data The raw data.
+     * @param size The size of the data in bytes.
+     */
+    void add(const std::string& name, const std::string& header, const void* data, std::size_t size);
+
+  private:
+    friend class NpyTester;  //!< Friend test fixture class for unit testing.
+    /**
+     * @brief Central directory record of an archive member.
+     *
+     */
+    struct Entry {
+        std::string name;      //!< Name of the member.
+        std::uint32_t crc;     //!< CRC-32 of the member.
+        std::uint32_t size;    //!< Size of the member in bytes.
+        std::uint32_t offset;  //!< Offset of the local header of the member.
+    };
+    std::string filename;        //!< The path of the archive.
+    std::ofstream file;          //!< The archive being written.
+    std::vector<Entry> entries;  //!< The members written so far.
+};
+
+#endif  // NPY_HPP
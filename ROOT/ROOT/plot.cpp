@@ -0,0 +1,344 @@
+#include "plot.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "npy.hpp"
+
+namespace {
+
+// colours of the paths, cycled through when there are more paths than colours
+constexpr std::array<std::array<std::uint8_t, 3>, 10> series_colours = {{
+    {31, 119, 180}, {255, 127, 14}, {44, 160, 44}, {214, 39, 40}, {148, 103, 189},
+    {140, 86, 75}, {227, 119, 194}, {127, 127, 127}, {188, 189, 34}, {23, 190, 207},
+}};
+constexpr std::uint8_t white = 0;
+constexpr std::uint8_t black = 1;
+constexpr std::uint8_t grey = 2;
+constexpr std::uint8_t first_series_colour = 3;
+constexpr int ticks = 5;
+constexpr std::size_t max_legend_entries = 10;
+
+void put32be(std::string& out, std::uint32_t value) {
+    out += static_cast<char>(value >> 24);
+    out += static_cast<char>((value >> 16) & 0xFF);
+    out += static_cast<char>((value >> 8) & 0xFF);
+    out += static_cast<char>(value & 0xFF);
+}
+
+void put_chunk(std::string& out, const char* type, const std::string& data) {
+    put32be(out, static_cast<std::uint32_t>(data.size()));
+    std::string body = std::string(type, 4) + data;
+    out += body;
+    put32be(out, crc32(body.data(), body.size()));
+}
+
+std::string number(double value, int precision) {
+    std::array<char, 32> digits{};
+    auto [end, ec] = std::to_chars(digits.data(), digits.data() + digits.size(), value, std::chars_format::general,
+                                   precision);
+    return std::string(digits.data(), end);
+}
+
+std::string colour(std::size_t index) {
+    const auto& rgb = series_colours[index % series_colours.size()];
+    std::ostringstream out;
+    out << "rgb(" << int(rgb[0]) << ',' << int(rgb[1]) << ',' << int(rgb[2]) << ')';
+    return out.str();
+}
+
+std::string escape_xml(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        switch (c) {
+            case '<':
+                escaped += "&lt;";
+                break;
+            case '>':
+                escaped += "&gt;";
+                break;
+            case '&':
+                escaped += "&amp;";
+                break;
+            case '"':
+                escaped += "&quot;";
+                break;
+            default:
+                escaped += c;
+        }
+    }
+    return escaped;
+}
+
+void write_file(const std::string& filename, const std::string& content) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "\033[31mError: could not open file " << filename << " for writing.\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+/**
+ * @brief Palette image with the few drawing primitives needed by the PNG plots.
+ *
+ */
+struct Canvas {
+    int width;                         //!< Width in pixels.
+    int height;                        //!< Height in pixels.
+    std::vector<std::uint8_t> pixels;  //!< Palette index of every pixel, row by row.
+    void set(int x, int y, std::uint8_t colour) {
+        if (x >= 0 && x < width && y >= 0 && y < height) {
+            pixels[static_cast<std::size_t>(y) * width + x] = colour;
+        }
+    }
+    // Bresenham's line, two pixels thick
+    void line(double x0, double y0, double x1, double y1, std::uint8_t colour) {
+        int ax = static_cast<int>(std::lround(x0)), ay = static_cast<int>(std::lround(y0));
+        int bx = static_cast<int>(std::lround(x1)), by = static_cast<int>(std::lround(y1));
+        int dx = std::abs(bx - ax), dy = -std::abs(by - ay);
+        int sx = ax < bx ? 1 : -1, sy = ay < by ? 1 : -1;
+        int error = dx + dy;
+        while (true) {
+            set(ax, ay, colour);
+            set(ax + 1, ay, colour);
+            set(ax, ay + 1, colour);
+            if (ax == bx && ay == by) {
+                break;
+            }
+            int doubled = 2 * error;
+            if (doubled >= dy) {
+                error += dy;
+                ax += sx;
+            }
+            if (doubled <= dx) {
+                error += dx;
+                ay += sy;
+            }
+        }
+    }
+    void dot(double x, double y, std::uint8_t colour) {
+        int cx = static_cast<int>(std::lround(x)), cy = static_cast<int>(std::lround(y));
+        for (int i = -2; i <= 2; ++i) {
+            for (int j = -2; j <= 2; ++j) {
+                set(cx + i, cy + j, colour);
+            }
+        }
+    }
+};
+
+}  // namespace
+
+std::string png_encode(const std::vector<std::uint8_t>& pixels, int width, int height,
+                       const std::vector<std::uint8_t>& palette) {
+    std::string png("\x89PNG\r\n\x1a\n", 8);
+
+    std::string header;
+    put32be(header, static_cast<std::uint32_t>(width));
+    put32be(header, static_cast<std::uint32_t>(height));
+    header += std::string("\x08\x03\x00\x00\x00", 5);  // 8-bit palette indices, no interlacing
+    put_chunk(png, "IHDR", header);
+    put_chunk(png, "PLTE", std::string(palette.begin(), palette.end()));
+
+    // every scanline starts with its filter type (0: none)
+    std::string raw;
+    raw.reserve(static_cast<std::size_t>(height) * (width + 1));
+    for (int y = 0; y < height; ++y) {
+        raw += '\0';
+        raw.append(reinterpret_cast<const char*>(pixels.data()) + static_cast<std::size_t>(y) * width, width);
+    }
+
+    // zlib stream made of stored deflate blocks, followed by the Adler-32 checksum of the raw data
+    std::string zlib("\x78\x01", 2);
+    const std::size_t max_block = 65535;
+    for (std::size_t start = 0; start == 0 || start < raw.size(); start += max_block) {
+        std::size_t size = std::min(max_block, raw.size() - start);
+        bool last = start + size == raw.size();
+        zlib += static_cast<char>(last ? 1 : 0);
+        zlib += static_cast<char>(size & 0xFF);
+        zlib += static_cast<char>(size >> 8);
+        zlib += static_cast<char>(~size & 0xFF);
+        zlib += static_cast<char>((~size >> 8) & 0xFF);
+        zlib.append(raw, start, size);
+        if (last) {
+            break;
+        }
+    }
+    std::uint32_t a = 1, b = 0;
+    for (unsigned char byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    put32be(zlib, (b << 16) | a);
+    put_chunk(png, "IDAT", zlib);
+    put_chunk(png, "IEND", "");
+    return png;
+}
+
+bool executable_on_path(const std::string& name) {
+    const char* path = std::getenv("PATH");
+    if (path == nullptr) {
+        return false;
+    }
+    std::stringstream directories(path);
+    for (std::string directory; std::getline(directories, directory, ':');) {
+        std::string candidate = (directory.empty() ? "." : directory) + "/" + name;
+        if (access(candidate.c_str(), X_OK) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ConvergencePlot::ConvergencePlot(int width, int height) : width(width), height(height) {}
+
+void ConvergencePlot::add(const std::string& name, const Eigen::Ref<const Eigen::MatrixX2d>& path) {
+    Series path_series;
+    path_series.name = name;
+    for (Eigen::Index i = 0; i < path.rows(); ++i) {
+        if (std::isfinite(path(i, 0)) && std::isfinite(path(i, 1))) {
+            path_series.x.push_back(path(i, 0));
+            path_series.y.push_back(path(i, 1));
+        }
+    }
+    this->series.push_back(std::move(path_series));
+}
+
+ConvergencePlot::Frame ConvergencePlot::frame() const {
+    Frame frame{};
+    frame.x_min = frame.y_min = INFINITY;
+    frame.x_max = frame.y_max = -INFINITY;
+    for (const auto& path : this->series) {
+        for (std::size_t i = 0; i < path.x.size(); ++i) {
+            frame.x_min = std::min(frame.x_min, path.x[i]);
+            frame.x_max = std::max(frame.x_max, path.x[i]);
+            frame.y_min = std::min(frame.y_min, path.y[i]);
+            frame.y_max = std::max(frame.y_max, path.y[i]);
+        }
+    }
+    if (frame.x_min > frame.x_max) {
+        frame.x_min = frame.y_min = -1;
+        frame.x_max = frame.y_max = 1;
+    }
+    // pad the ranges by 5%, and give a width to the ranges of constant paths
+    for (auto [low, high] : {std::pair{&frame.x_min, &frame.x_max}, std::pair{&frame.y_min, &frame.y_max}}) {
+        double padding = (*high - *low) * 0.05;
+        if (padding == 0) {
+            padding = std::max(1.0, std::abs(*low)) * 0.05;
+        }
+        *low -= padding;
+        *high += padding;
+    }
+    frame.left = 90;
+    frame.right = this->width - 30;
+    frame.top = 50;
+    frame.bottom = this->height - 70;
+    return frame;
+}
+
+void ConvergencePlot::write_svg(const std::string& filename) const {
+    const Frame frame = this->frame();
+    std::ostringstream svg;
+    svg << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << this->width << "\" height=\"" << this->height
+        << "\" viewBox=\"0 0 " << this->width << ' ' << this->height << "\" font-family=\"Arial\" font-size=\"12\">\n"
+        << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n"
+        << "<text x=\"" << this->width / 2 << "\" y=\"30\" text-anchor=\"middle\" font-size=\"16\">"
+        << "Root-Finding Iterations</text>\n";
+
+    // grid, tick labels and axes
+    svg << "<g stroke=\"rgb(220,220,220)\">\n";
+    for (int i = 0; i <= ticks; ++i) {
+        double x = frame.left + (frame.right - frame.left) * i / ticks;
+        double y = frame.bottom - (frame.bottom - frame.top) * i / ticks;
+        svg << "<line x1=\"" << number(x, 6) << "\" y1=\"" << frame.top << "\" x2=\"" << number(x, 6) << "\" y2=\""
+            << frame.bottom << "\"/>\n"
+            << "<line x1=\"" << frame.left << "\" y1=\"" << number(y, 6) << "\" x2=\"" << frame.right << "\" y2=\""
+            << number(y, 6) << "\"/>\n";
+    }
+    svg << "</g>\n";
+    for (int i = 0; i <= ticks; ++i) {
+        double x = frame.left + (frame.right - frame.left) * i / ticks;
+        double y = frame.bottom - (frame.bottom - frame.top) * i / ticks;
+        svg << "<text x=\"" << number(x, 6) << "\" y=\"" << frame.bottom + 20 << "\" text-anchor=\"middle\">"
+            << number(frame.x_min + (frame.x_max - frame.x_min) * i / ticks, 4) << "</text>\n"
+            << "<text x=\"" << frame.left - 8 << "\" y=\"" << number(y + 4, 6) << "\" text-anchor=\"end\">"
+            << number(frame.y_min + (frame.y_max - frame.y_min) * i / ticks, 4) << "</text>\n";
+    }
+    svg << "<rect x=\"" << frame.left << "\" y=\"" << frame.top << "\" width=\"" << frame.right - frame.left
+        << "\" height=\"" << frame.bottom - frame.top << "\" fill=\"none\" stroke=\"black\"/>\n"
+        << "<text x=\"" << (frame.left + frame.right) / 2 << "\" y=\"" << this->height - 25
+        << "\" text-anchor=\"middle\">x</text>\n"
+        << "<text x=\"20\" y=\"" << (frame.top + frame.bottom) / 2
+        << "\" text-anchor=\"middle\" transform=\"rotate(-90 20 " << (frame.top + frame.bottom) / 2
+        << ")\">f(x)</text>\n";
+
+    // one polyline with its points per iteration path
+    for (std::size_t s = 0; s < this->series.size(); ++s) {
+        const auto& path = this->series[s];
+        std::string points;
+        for (std::size_t i = 0; i < path.x.size(); ++i) {
+            points += number(frame.column(path.x[i]), 6) + ',' + number(frame.row(path.y[i]), 6) + ' ';
+        }
+        svg << "<g stroke=\"" << colour(s) << "\" fill=\"" << colour(s) << "\">\n"
+            << "<polyline fill=\"none\" stroke-width=\"2\" points=\"" << points << "\"/>\n";
+        for (std::size_t i = 0; i < path.x.size(); ++i) {
+            svg << "<circle cx=\"" << number(frame.column(path.x[i]), 6) << "\" cy=\""
+                << number(frame.row(path.y[i]), 6) << "\" r=\"3\"/>\n";
+        }
+        svg << "</g>\n";
+    }
+
+    // a legend is only readable for a handful of paths
+    if (this->series.size() <= max_legend_entries) {
+        for (std::size_t s = 0; s < this->series.size(); ++s) {
+            double y = frame.top + 20 + 18 * static_cast<double>(s);
+            svg << "<line x1=\"" << frame.right - 170 << "\" y1=\"" << y - 4 << "\" x2=\"" << frame.right - 145
+                << "\" y2=\"" << y - 4 << "\" stroke=\"" << colour(s) << "\" stroke-width=\"2\"/>\n"
+                << "<text x=\"" << frame.right - 140 << "\" y=\"" << y << "\">"
+                << escape_xml(this->series[s].name.empty() ? "Iteration Path" : this->series[s].name) << "</text>\n";
+        }
+    }
+    svg << "</svg>\n";
+    write_file(filename, svg.str());
+}
+
+void ConvergencePlot::write_png(const std::string& filename) const {
+    const Frame frame = this->frame();
+    Canvas canvas{this->width, this->height,
+                  std::vector<std::uint8_t>(static_cast<std::size_t>(this->width) * this->height, white)};
+
+    for (int i = 0; i <= ticks; ++i) {
+        double x = frame.left + (frame.right - frame.left) * i / ticks;
+        double y = frame.bottom - (frame.bottom - frame.top) * i / ticks;
+        canvas.line(x, frame.top, x, frame.bottom, grey);
+        canvas.line(frame.left, y, frame.right, y, grey);
+    }
+    canvas.line(frame.left, frame.bottom, frame.right, frame.bottom, black);
+    canvas.line(frame.left, frame.top, frame.left, frame.bottom, black);
+
+    for (std::size_t s = 0; s < this->series.size(); ++s) {
+        const auto& path = this->series[s];
+        auto path_colour = static_cast<std::uint8_t>(first_series_colour + s % series_colours.size());
+        for (std::size_t i = 0; i < path.x.size(); ++i) {
+            if (i > 0) {
+                canvas.line(frame.column(path.x[i - 1]), frame.row(path.y[i - 1]), frame.column(path.x[i]),
+                            frame.row(path.y[i]), path_colour);
+            }
+            canvas.dot(frame.column(path.x[i]), frame.row(path.y[i]), path_colour);
+        }
+    }
+
+    std::vector<std::uint8_t> palette = {255, 255, 255, 0, 0, 0, 220, 220, 220};
+    for (const auto& rgb : series_colours) {
+        palette.insert(palette.end(), rgb.begin(), rgb.end());
+    }
+    write_file(filename, png_encode(canvas.pixels, this->width, this->height, palette));
+}
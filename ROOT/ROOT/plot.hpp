@@ -0,0 +1,111 @@
+/**
+ * @file plot.hpp
+ * @brief Native renderer of convergence plots, writing SVG and PNG files without spawning gnuplot.
+ *
+ * A plot gathers the iteration paths (x(i), f(x(i))) of one or more problems and draws them on the same axes, so
+ * that the paths of a whole batch cost a single file write. SVG files hold the full figure (axes, tick labels and a
+ * legend); PNG files are encoded by a small embedded encoder (palette colours, uncompressed deflate blocks) and hold
+ * the axes and the paths without any text.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef PLOT_HPP
+#define PLOT_HPP
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Encode an image as a PNG file, with 8-bit palette indices and uncompressed deflate blocks.
+ *
+ * @param pixels The palette index of every pixel, row by row from the top.
+ * @param width The width of the image in pixels.
+ * @param height The height of the image in pixels.
+ * @param palette The RGB components of every palette colour.
+ * @return The bytes of the PNG file.
+ */
+std::string png_encode(const std::vector<std::uint8_t>& pixels, int width, int height,
+                       const std::vector<std::uint8_t>& palette);
+
+/**
+ * @brief Check whether an executable can be found in one of the directories of the PATH environment variable.
+ *
+ * @param name The name of the executable.
+ * @return true if the executable exists, false otherwise.
+ */
+bool executable_on_path(const std::string& name);
+
+/**
+ * @brief Convergence plot of the iteration paths of one or more problems.
+ *
+ */
+class ConvergencePlot {
+  public:
+    /**
+     * @brief Create an empty plot.
+     *
+     * @param width The width of the figure in pixels.
+     * @param height The height of the figure in pixels.
+     */
+    explicit ConvergencePlot(int width = 1000, int height = 800);
+    /**
+     * @brief Add the iteration path of a problem; points which are not finite are skipped.
+     *
+     * @param name The name of the problem, shown in the legend of SVG files.
+     * @param path Matrix storing in the first column x(i) for each iteration i, in the second column f(x(i)).
+     */
+    void add(const std::string& name, const Eigen::Ref<const Eigen::MatrixX2d>& path);
+    /** @brief Number of iteration paths in the plot. */
+    std::size_t size() const { return this->series.size(); }
+    /**
+     * @brief Write the plot as an SVG file.
+     *
+     * @param filename The path of the file, including its extension.
+     */
+    void write_svg(const std::string& filename) const;
+    /**
+     * @brief Write the plot as a PNG file.
+     *
+     * @param filename The path of the file, including its extension.
+     */
+    void write_png(const std::string& filename) const;
+
+  private:
+    friend class ConvergencePlotTester;  //!< Friend test fixture class for unit testing.
+    /**
+     * @brief Iteration path of one problem.
+     *
+     */
+    struct Series {
+        std::string name;       //!< Name of the problem.
+        std::vector<double> x;  //!< x(i) of every finite point.
+        std::vector<double> y;  //!< f(x(i)) of every finite point.
+    };
+    /**
+     * @brief Ranges of the axes and position of the plotting area in the figure.
+     *
+     */
+    struct Frame {
+        double x_min, x_max;  //!< Range of the horizontal axis.
+        double y_min, y_max;  //!< Range of the vertical axis.
+        double left, right;   //!< Horizontal pixel bounds of the plotting area.
+        double top, bottom;   //!< Vertical pixel bounds of the plotting area.
+        /** @brief Pixel column of a value of x. */
+        double column(double x) const { return left + (x - x_min) / (x_max - x_min) * (right - left); }
+        /** @brief Pixel row of a value of f(x). */
+        double row(double y) const { return bottom - (y - y_min) / (y_max - y_min) * (bottom - top); }
+    };
+    std::vector<Series> series;  //!< The iteration paths.
+    int width;                   //!< Width of the figure in pixels.
+    int height;                  //!< Height of the figure in pixels.
+    /**
+     * @brief Compute the ranges of the axes (padded, and never empty) from the points of every path.
+     *
+     * @return The frame of the figure.
+     */
+    Frame frame() const;
+};
+
+#endif  // PLOT_HPP
@@ -0,0 +1,97 @@
+/**
+ * @file portfolio.cpp
+ * @brief Implementation of the method portfolios and of their rows.
+ *
+ * @author Saransh-cpp
+ */
+#include "portfolio.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "text_format.hpp"
+
+bool parse_portfolio_method(const std::string& name, Method& method) {
+    for (Method candidate : {Method::NEWTON, Method::CHORDS, Method::FIXED_POINT, Method::BISECTION}) {
+        if (name == portfolio_method_name(candidate)) {
+            method = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* portfolio_method_name(Method method) {
+    switch (method) {
+        case Method::NEWTON:
+            return "newton";
+        case Method::CHORDS:
+            return "chords";
+        case Method::FIXED_POINT:
+            return "fixed_point";
+        case Method::BISECTION:
+            return "bisection";
+        default:
+            return "unknown";
+    }
+}
+
+PortfolioResult race_portfolio(const std::vector<Method>& methods,
+                               const std::function<PortfolioEntry(Method, std::stop_token)>& solve) {
+    PortfolioResult result;
+    result.entries.resize(methods.size());
+    std::stop_source source;
+    std::mutex mutex;
+    auto start = std::chrono::steady_clock::now();
+
+    // a thread per method rather than a pool: every method must run from the start for the race to be fair
+    std::vector<std::jthread> racers;
+    racers.reserve(methods.size());
+    for (std::size_t i = 0; i < methods.size(); ++i) {
+        racers.emplace_back([&, i] {
+            PortfolioEntry entry = solve(methods[i], source.get_token());
+            entry.method = methods[i];
+            entry.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::lock_guard lock(mutex);
+            if (entry.status == SolverStatus::CONVERGED && !result.winner) {
+                result.winner = i;
+                source.request_stop();
+            }
+            result.entries[i] = entry;
+        });
+    }
+    racers.clear();
+    return result;
+}
+
+std::string portfolio_csv_header(char separator) {
+    std::string header;
+    for (const char* column :
+         {"method", "status", "root", "residual", "iterations", "evaluations", "seconds", "winner"}) {
+        if (!header.empty()) {
+            header += separator;
+        }
+        header += column;
+    }
+    return header + '\n';
+}
+
+void append_portfolio_csv(std::string& out, const PortfolioEntry& entry, bool winner, char separator) {
+    out += portfolio_method_name(entry.method);
+    out += separator;
+    out += solver_status_name(entry.status);
+    out += separator;
+    append_number(out, entry.root);
+    out += separator;
+    append_number(out, entry.residual);
+    out += separator;
+    out += std::to_string(entry.iterations);
+    out += separator;
+    out += std::to_string(entry.evaluations);
+    out += separator;
+    append_number(out, entry.seconds);
+    out += separator;
+    out += winner ? "true" : "false";
+    out += '\n';
+}
@@ -0,0 +1,91 @@
+/**
+ * @file portfolio.hpp
+ * @brief Racing several methods on the same problem, keeping the first one to converge.
+ *
+ * Every method of the portfolio is solved on its own thread. The first method to converge wins and requests a stop
+ * on the shared stop source, which the other Solver objects check before each of their iterations: the losers end
+ * after at most one more iteration instead of running up to their maximum number of iterations.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef PORTFOLIO_HPP
+#define PORTFOLIO_HPP
+
+#include <cstddef>
+#include <functional>
+#include <libROOT/method.hpp>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Summary of one method of a portfolio.
+ *
+ */
+struct PortfolioEntry {
+    Method method = Method::NEWTON;                 //!< The method.
+    SolverStatus status = SolverStatus::CONVERGED;  //!< How the solving process ended (CANCELLED for the losers).
+    double root = 0.0;                              //!< The last estimate of the root.
+    double residual = 0.0;                          //!< The absolute value of the function at the root.
+    int iterations = 0;                             //!< Number of iterations performed.
+    long evaluations = 0;                           //!< Number of function evaluations performed.
+    double seconds = 0.0;                           //!< Wall-clock time from the start of the race to the end.
+};
+
+/**
+ * @brief The outcome of a race.
+ *
+ */
+struct PortfolioResult {
+    std::vector<PortfolioEntry> entries;  //!< One entry per method, in the order of the portfolio.
+    std::optional<std::size_t> winner;    //!< Position of the first method to converge, if any did.
+};
+
+/**
+ * @brief Parse the name of a method, as written on the command line.
+ *
+ * @param name One of newton, chords, fixed_point or bisection.
+ * @param method The parsed method, left untouched if the name is unknown.
+ * @return true if the name is known, false otherwise.
+ */
+bool parse_portfolio_method(const std::string& name, Method& method);
+
+/**
+ * @brief Name of a method, as written on the command line.
+ *
+ * @param method The method.
+ * @return One of newton, chords, fixed_point or bisection.
+ */
+const char* portfolio_method_name(Method method);
+
+/**
+ * @brief Solve the same problem with every method at once, and cancel the others when one converges.
+ *
+ * @param methods The methods of the portfolio, each solved on its own thread.
+ * @param solve Solves the problem with a method, stopping cooperatively once the token is stopped; called
+ * concurrently by the threads (the time is measured by the race).
+ * @return The entries of every method and the winner.
+ */
+PortfolioResult race_portfolio(const std::vector<Method>& methods,
+                               const std::function<PortfolioEntry(Method, std::stop_token)>& solve);
+
+/**
+ * @brief The header line of a CSV portfolio summary.
+ *
+ * @param separator The separator character of the columns.
+ * @return The header, ended by a newline.
+ */
+std::string portfolio_csv_header(char separator);
+
+/**
+ * @brief Append an entry to a CSV portfolio summary.
+ *
+ * @param out The text to append to.
+ * @param entry The entry to write, ended by a newline.
+ * @param winner Whether the entry is the winner of the race.
+ * @param separator The separator character of the columns.
+ */
+void append_portfolio_csv(std::string& out, const PortfolioEntry& entry, bool winner, char separator);
+
+#endif  // PORTFOLIO_HPP
@@ -6,7 +6,9 @@
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 #include "config.hpp"
 #include "function_parser.hpp"
@@ -79,21 +81,41 @@ bool ReaderBase::parseMethod(const std::string& method_str, Method& out) {
         out = Method::FIXED_POINT;
         return true;
     }
+    if (method_str_copy == "muller" || method_str_copy == "mullermethod") {
+        out = Method::MULLER;
+        return true;
+    }
     return false;
 }
 
 std::unique_ptr<ConfigBase> ReaderBase::make_config_from_map(
-    const std::unordered_map<std::string, std::string>& config_map) {
+    const std::unordered_map<std::string, std::string>& config_map, FunctionCache* cache) {
+    std::unique_ptr<ConfigBase> config;
+    std::string error;
+    if (!try_make_config_from_map(config_map, config, error, cache)) {
+        std::cerr << "\033[31mmake_config_from_map: " << error << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    return config;
+}
+
+bool ReaderBase::try_make_config_from_map(const std::unordered_map<std::string, std::string>& config_map,
+                                          std::unique_ptr<ConfigBase>& out, std::string& error, FunctionCache* cache) {
+    auto parse_function = [cache, &error](const std::string& function_str, std::function<double(double)>& function) {
+        return cache != nullptr ? cache->try_get(function_str, function, error)
+                                : FunctionParserBase::tryParseFunction(function_str, function, error);
+    };
+
     // method is required
     auto itm = config_map.find("method");
     if (itm == config_map.end()) {
-        std::cerr << "\033[31mmake_config_from_map: required field 'method' missing\033[0m\n";
-        std::exit(EXIT_FAILURE);
+        error = "required field 'method' missing";
+        return false;
     }
     Method method;  // NOLINT(cppcoreguidelines-init-variables)
     if (!parseMethod(itm->second, method)) {
-        std::cerr << "\033[31mmake_config_from_map: unknown method: " << itm->second << "\033[0m\n";
-        std::exit(EXIT_FAILURE);
+        error = "unknown method: " + itm->second;
+        return false;
     }
 
     // shared optional params
@@ -101,8 +123,8 @@ std::unique_ptr<ConfigBase> ReaderBase::make_config_from_map(
     auto it_tol = config_map.find("tolerance");
     if (it_tol != config_map.end()) {
         if (!parseDouble(it_tol->second, tolerance)) {
-            std::cerr << "\033[31mmake_config_from_map: invalid tolerance: " << it_tol->second << "\033[0m\n";
-            std::exit(EXIT_FAILURE);
+            error = "invalid tolerance: " + it_tol->second;
+            return false;
         }
     }
 
@@ -110,8 +132,8 @@ std::unique_ptr<ConfigBase> ReaderBase::make_config_from_map(
     auto it_max = config_map.find("max-iterations");
     if (it_max != config_map.end()) {
         if (!parseInt(it_max->second, max_iter)) {
-            std::cerr << "\033[31mmake_config_from_map: invalid max-iterations: " << it_max->second << "\033[0m\n";
-            std::exit(EXIT_FAILURE);
+            error = "invalid max-iterations: " + it_max->second;
+            return false;
         }
     }
 
@@ -119,27 +141,29 @@ std::unique_ptr<ConfigBase> ReaderBase::make_config_from_map(
     auto it_ait = config_map.find("aitken");
     if (it_ait != config_map.end()) {
         if (!parseBool(it_ait->second, aitken)) {
-            std::cerr << "\033[31mmake_config_from_map: invalid aitken: " << it_ait->second << "\033[0m\n";
-            std::exit(EXIT_FAILURE);
+            error = "invalid aitken: " + it_ait->second;
+            return false;
         }
     }
 
     // functions
     auto it_fun = config_map.find("function");
     if (it_fun == config_map.end()) {
-        std::cerr << "\033[31mmake_config_from_map: required field 'function' missing\033[0m\n";
-        std::exit(EXIT_FAILURE);
+        error = "required field 'function' missing";
+        return false;
+    }
+    std::function<double(double)> function;
+    if (!parse_function(it_fun->second, function)) {
+        return false;
     }
-    std::string function_str = it_fun->second;
-    auto function = FunctionParserBase::parseFunction(function_str);
 
     // verbose
     auto it_verb = config_map.find("verbose");
     bool verbose = false;
     if (it_verb != config_map.end()) {
         if (!parseBool(it_verb->second, verbose)) {
-            std::cerr << "\033[31mmake_config_from_map: invalid verbose: " << it_verb->second << "\033[0m\n";
-            std::exit(EXIT_FAILURE);
+            error = "invalid verbose: " + it_verb->second;
+            return false;
         }
     }
 
@@ -149,76 +173,103 @@ std::unique_ptr<ConfigBase> ReaderBase::make_config_from_map(
             auto it_a = config_map.find("interval_a");
             auto it_b = config_map.find("interval_b");
             if (it_a == config_map.end() || it_b == config_map.end()) {
-                std::cerr << "\033[31mmake_config_from_map: bisection requires interval_a and interval_b\033[0m\n";
-                std::exit(EXIT_FAILURE);
+                error = "bisection requires interval_a and interval_b";
+                return false;
             }
             double interval_a = 0.0;
             double interval_b = 0.0;
             if (!parseDouble(it_a->second, interval_a) || !parseDouble(it_b->second, interval_b)) {
-                std::cerr << "\033[31mmake_config_from_map: invalid bisection endpoints\033[0m\n";
-                std::exit(EXIT_FAILURE);
+                error = "invalid bisection endpoints";
+                return false;
             }
-            return std::make_unique<BisectionConfig>(tolerance, max_iter, aitken, function, interval_a, interval_b,
-                                                     verbose);
+            // BisectionConfig stops the program on an interval without a sign change
+            if (function(interval_a) * function(interval_b) > 0) {
+                error = "For Bisection method, function values at initial points must have opposite signs.";
+                return false;
+            }
+            out = std::make_unique<BisectionConfig>(tolerance, max_iter, aitken, function, interval_a, interval_b,
+                                                    verbose);
+            return true;
         }
 
         case Method::NEWTON: {
             auto it_x0 = config_map.find("initial");
             if (it_x0 == config_map.end()) {
-                std::cerr << "\033[31mmake_config_from_map: newton requires initial\033[0m\n";
-                std::exit(EXIT_FAILURE);
+                error = "newton requires initial";
+                return false;
             }
             double initial = 0.0;
             if (!parseDouble(it_x0->second, initial)) {
-                std::cerr << "\033[31mmake_config_from_map: invalid initial\033[0m\n";
-                std::exit(EXIT_FAILURE);
+                error = "invalid initial";
+                return false;
             }
             auto it_df = config_map.find("derivative");
             if (it_df == config_map.end()) {
-                std::cerr << "\033[31mmake_config_from_map: newton requires derivative function\033[0m\n";
-                std::exit(EXIT_FAILURE);
+                error = "newton requires derivative function";
+                return false;
             }
-            std::function<double(double)> function_derivative = FunctionParserBase::parseFunction(it_df->second);
-            return std::make_unique<NewtonConfig>(tolerance, max_iter, aitken, function, function_derivative, initial,
-                                                  verbose);
+            std::function<double(double)> function_derivative;
+            if (!parse_function(it_df->second, function_derivative)) {
+                return false;
+            }
+            out = std::make_unique<NewtonConfig>(tolerance, max_iter, aitken, function, function_derivative, initial,
+                                                 verbose);
+            return true;
         }
 
         case Method::CHORDS: {
             auto it_x0 = config_map.find("x0");
             auto it_x1 = config_map.find("x1");
             if (it_x0 == config_map.end() || it_x1 == config_map.end()) {
-                std::cerr << "\033[31mmake_config_from_map: chords requires two initial points\033[0m\n";
-                std::exit(EXIT_FAILURE);
+                error = "chords requires two initial points";
+                return false;
             }
             double initial_point1 = 0.0;
             double initial_point2 = 0.0;
             if (!parseDouble(it_x0->second, initial_point1) || !parseDouble(it_x1->second, initial_point2)) {
-                std::cerr << "\033[31mmake_config_from_map: invalid chords initial points\033[0m\n";
-                std::exit(EXIT_FAILURE);
+                error = "invalid chords initial points";
+                return false;
             }
-            return std::make_unique<ChordsConfig>(tolerance, max_iter, aitken, function, initial_point1, initial_point2,
-                                                  verbose);
+            out = std::make_unique<ChordsConfig>(tolerance, max_iter, aitken, function, initial_point1, initial_point2,
+                                                 verbose);
+            return true;
         }
 
         case Method::FIXED_POINT: {
             auto it_x0 = config_map.find("initial");
             auto it_g = config_map.find("g-function");
             if (it_x0 == config_map.end() || it_g == config_map.end()) {
-                std::cerr << "\033[31mmake_config_from_map: fixed_point requires initial and g-function\033[0m\n";
-                std::exit(EXIT_FAILURE);
+                error = "fixed_point requires initial and g-function";
+                return false;
             }
             double initial = 0.0;
             if (!parseDouble(it_x0->second, initial)) {
-                std::cerr << "\033[31mmake_config_from_map: invalid initial\033[0m\n";
-                std::exit(EXIT_FAILURE);
+                error = "invalid initial";
+                return false;
+            }
+            std::function<double(double)> g_function;
+            if (!parse_function(it_g->second, g_function)) {
+                return false;
             }
-            auto g_function = FunctionParserBase::parseFunction(it_g->second);
-            return std::make_unique<FixedPointConfig>(tolerance, max_iter, aitken, function, initial, g_function,
-                                                      verbose);
+            out = std::make_unique<FixedPointConfig>(tolerance, max_iter, aitken, function, initial, g_function,
+                                                     verbose);
+            return true;
         }
+
+        case Method::MULLER:
+            // Muller's method finds complex roots, which no configuration or writer of the CLI holds
+            error = "method " + itm->second + " is not available from the CLI";
+            return false;
     }  // switch
 
-    return nullptr;  // unreachable
+    error = "unknown method: " + itm->second;
+    return false;
+}
+
+std::vector<std::unique_ptr<ConfigBase>> ReaderBase::read_all(CLI::App* app, bool verbose) {
+    std::vector<std::unique_ptr<ConfigBase>> configs;
+    configs.push_back(this->read(app, verbose));
+    return configs;
 }
 
 std::vector<std::string> ReaderCSV::splitCsvLine(const std::string& line) const {
@@ -255,59 +306,57 @@ std::vector<std::string> ReaderCSV::splitCsvLine(const std::string& line) const
     return fields;
 }
 
-std::unique_ptr<ConfigBase> ReaderCSV::read(CLI::App* app, bool verbose) {
-    this->filename = app->get_option("--file")->as<std::string>();
-    this->sep = app->get_option("--sep")->as<char>();
-    this->quote = app->get_option("--quote")->as<char>();
-    std::ifstream ifs(filename);
-    if (!ifs) {
-        std::cerr << "\033[31mReaderCSV: failed to open file: " << filename << "\033[0m\n";
-        std::exit(EXIT_FAILURE);
-    }
-
-    std::string headerLine;
-    std::string valueLine;
-
-    if (!std::getline(ifs, headerLine)) {
-        std::cerr << "\033[31mReaderCSV: empty file (expecting header)\033[0m\n";
-        std::exit(EXIT_FAILURE);
+std::vector<std::string> ReaderCSV::read_header(const std::string& line) const {
+    std::vector<std::string> headers = splitCsvLine(line);
+    for (auto& header : headers) {
+        header = trim(header);
+        std::transform(header.begin(), header.end(), header.begin(),
+                       [](unsigned char character) { return std::tolower(character); });
     }
-    if (!std::getline(ifs, valueLine)) {
-        std::cerr << "\033[31mReaderCSV: missing value row\033[0m\n";
+    if (headers.size() == 1 && headers.front().empty()) {
+        std::cerr << "\033[31mReaderCSV: empty header row\033[0m\n";
         std::exit(EXIT_FAILURE);
     }
+    return headers;
+}
 
-    std::vector<std::string> headers;
-    headers = splitCsvLine(headerLine);
-    for (auto& header : headers) {
-        header = trim(header);
+std::unique_ptr<ConfigBase> ReaderCSV::read_row(const std::vector<std::string>& headers, const std::string& line,
+                                                size_t lineno, bool verbose) const {
+    std::unique_ptr<ConfigBase> config;
+    std::string error;
+    if (!try_read_row(headers, line, verbose, config, error)) {
+        std::cerr << "\033[31mReaderCSV: " << error << " on line " << lineno << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
     }
+    return config;
+}
 
-    auto values = splitCsvLine(valueLine);
+bool ReaderCSV::try_read_row(const std::vector<std::string>& headers, const std::string& line, bool verbose,
+                             std::unique_ptr<ConfigBase>& out, std::string& error) const {
+    auto values = splitCsvLine(line);
     for (auto& value : values) {
         value = trim(value);
     }
 
+    if (headers.size() != values.size()) {
+        error = "header/value columns mismatch";
+        return false;
+    }
     std::unordered_map<std::string, std::string> config_map;
-    if (!headers.empty()) {
-        if (headers.size() != values.size()) {
-            std::cerr << "\033[31mReaderCSV: header/value columns mismatch\033[0m\n";
-            std::exit(EXIT_FAILURE);
-        }
-        for (size_t i = 0; i < headers.size(); ++i) {
-            std::string key = headers[i];
-            std::transform(key.begin(), key.end(), key.begin(),
-                           [](unsigned char character) { return std::tolower(character); });
-            config_map[key] = values[i];
-        }
-    } else {
-        std::cerr << "\033[31mReaderCSV: empty header row\033[0m\n";
-        std::exit(EXIT_FAILURE);
+    for (size_t i = 0; i < headers.size(); ++i) {
+        config_map[headers[i]] = values[i];
+    }
+
+    std::string name;
+    auto it_name = config_map.find("name");
+    if (it_name != config_map.end()) {
+        name = it_name->second;
+        config_map.erase(it_name);
     }
 
     if (verbose) {
         config_map["verbose"] = "true";
-        std::cout << "ReaderCSV: read configuration:\n";
+        std::cout << "ReaderCSV: read configuration" << (name.empty() ? "" : " [" + name + "]") << ":\n";
         for (const auto& item : config_map) {
             std::cout << "  " << item.first << " = " << item.second << "\n";
         }
@@ -315,21 +364,86 @@ std::unique_ptr<ConfigBase> ReaderCSV::read(CLI::App* app, bool verbose) {
         config_map["verbose"] = "false";
     }
 
-    return make_config_from_map(config_map);
+    if (!try_make_config_from_map(config_map, out, error)) {
+        return false;
+    }
+    out->name = name;
+    return true;
+}
+
+std::unique_ptr<ConfigBase> ReaderCSV::read(CLI::App* app, bool verbose) {
+    auto configs = this->read_all(app, verbose);
+    return std::move(configs.front());
 }
 
-std::unique_ptr<ConfigBase> ReaderDAT::read(CLI::App* app, bool verbose) {
+std::vector<std::unique_ptr<ConfigBase>> ReaderCSV::read_all(CLI::App* app, bool verbose) {
     this->filename = app->get_option("--file")->as<std::string>();
+    this->sep = app->get_option("--sep")->as<char>();
+    this->quote = app->get_option("--quote")->as<char>();
     std::ifstream ifs(filename);
     if (!ifs) {
-        std::cerr << "\033[31mReaderDAT: failed to open file: " << filename << "\033[0m\n";
+        std::cerr << "\033[31mReaderCSV: failed to open file: " << filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::string headerLine;
+    if (!std::getline(ifs, headerLine)) {
+        std::cerr << "\033[31mReaderCSV: empty file (expecting header)\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    auto headers = read_header(headerLine);
+
+    std::vector<std::unique_ptr<ConfigBase>> configs;
+    std::string valueLine;
+    size_t lineno = 1;
+    while (std::getline(ifs, valueLine)) {
+        ++lineno;
+        if (trim(valueLine).empty()) {
+            continue;
+        }
+        configs.push_back(read_row(headers, valueLine, lineno, verbose));
+    }
+    if (configs.empty()) {
+        std::cerr << "\033[31mReaderCSV: missing value row\033[0m\n";
         std::exit(EXIT_FAILURE);
     }
+    return configs;
+}
 
+std::vector<std::pair<std::string, std::unordered_map<std::string, std::string>>> ReaderDAT::parseSections(
+    std::istream& input) {
+    ReaderDAT reader;
+    std::vector<std::pair<std::string, std::unordered_map<std::string, std::string>>> sections;
+    std::string name;
     std::unordered_map<std::string, std::string> config_map;
-    std::string line;
+    std::string error;
     size_t lineno = 0;
-    while (std::getline(ifs, line)) {
+    while (reader.read_section(input, lineno, name, config_map, error)) {
+        if (!error.empty()) {
+            std::cerr << "\033[31mReaderDAT: " << error << "\033[0m\n";
+            std::exit(EXIT_FAILURE);
+        }
+        sections.emplace_back(std::move(name), std::move(config_map));
+    }
+
+    if (sections.empty()) {
+        sections.emplace_back("", std::unordered_map<std::string, std::string>());
+    }
+    return sections;
+}
+
+bool ReaderDAT::read_section(std::istream& input, size_t& lineno, std::string& name,
+                             std::unordered_map<std::string, std::string>& config_map, std::string& error) {
+    bool in_section = this->pending_section.has_value();
+    name = in_section ? std::move(*this->pending_section) : std::string();
+    error = std::move(this->pending_error);
+    this->pending_section.reset();
+    this->pending_error.clear();
+    // every section starts from the global defaults read so far
+    config_map = in_section ? this->global_map : std::unordered_map<std::string, std::string>();
+
+    std::string line;
+    while (std::getline(input, line)) {
         ++lineno;
         line = trim(line);
         if (line.empty()) {
@@ -339,21 +453,171 @@ std::unique_ptr<ConfigBase> ReaderDAT::read(CLI::App* app, bool verbose) {
             continue;
         }
 
+        if (line.front() == '[') {
+            std::string header_error;
+            std::string section;
+            if (line.back() != ']') {
+                header_error = "malformed section header on line " + std::to_string(lineno) + " (no ']')";
+                section = trim(line.substr(1));
+            } else {
+                section = trim(line.substr(1, line.size() - 2));
+            }
+            this->sectioned = true;
+            // the header ends the current section, and is kept for the next call
+            if (in_section) {
+                this->pending_section = std::move(section);
+                this->pending_error = std::move(header_error);
+                return true;
+            }
+            in_section = true;
+            name = std::move(section);
+            config_map = this->global_map;
+            error = std::move(header_error);
+            continue;
+        }
+
         auto equals = line.find('=');
         if (equals == std::string::npos) {
-            std::cerr << "\033[31mReaderDAT: malformed line " << lineno << " (no '=')\033[0m\n";
-            std::exit(EXIT_FAILURE);
+            std::string line_error = "malformed line " + std::to_string(lineno) + " (no '=')";
+            if (!in_section) {
+                error = std::move(line_error);
+                return true;
+            }
+            if (error.empty()) {
+                error = std::move(line_error);
+            }
+            continue;
         }
         std::string key = trim(line.substr(0, equals));
         std::string val = trim(line.substr(equals + 1));
         std::transform(key.begin(), key.end(), key.begin(),
                        [](unsigned char character) { return std::tolower(character); });
-        config_map[key] = val;
+        if (in_section) {
+            config_map[key] = val;
+        } else {
+            this->global_map[key] = val;
+        }
+    }
+
+    if (in_section) {
+        return true;
+    }
+    // a stream without headers describes a single problem
+    if (!this->sectioned && !this->global_map.empty()) {
+        this->sectioned = true;
+        config_map = std::move(this->global_map);
+        this->global_map.clear();
+        return true;
+    }
+    return false;
+}
+
+std::unique_ptr<ConfigBase> ReaderDAT::read(CLI::App* app, bool verbose) {
+    auto configs = this->read_all(app, verbose);
+    return std::move(configs.front());
+}
+
+std::vector<std::unique_ptr<ConfigBase>> ReaderDAT::read_all(CLI::App* app, bool verbose) {
+    this->filename = app->get_option("--file")->as<std::string>();
+    std::ifstream ifs(filename);
+    if (!ifs) {
+        std::cerr << "\033[31mReaderDAT: failed to open file: " << filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    auto sections = parseSections(ifs);
+
+    std::vector<std::unique_ptr<ConfigBase>> configs;
+    configs.reserve(sections.size());
+    for (auto& [name, config_map] : sections) {
+        if (verbose) {
+            config_map["verbose"] = "true";
+            std::cout << "ReaderDAT: read configuration" << (name.empty() ? "" : " [" + name + "]") << ":\n";
+            for (const auto& item : config_map) {
+                std::cout << "  " << item.first << " = " << item.second << "\n";
+            }
+        } else {
+            config_map["verbose"] = "false";
+        }
+
+        auto config = make_config_from_map(config_map);
+        config->name = name;
+        configs.push_back(std::move(config));
+    }
+
+    return configs;
+}
+
+std::vector<std::function<double(double)>> ReaderBIN::parse_batch(const BinaryBatchView& batch) {
+    auto functions = batch.function();
+    auto auxiliaries = batch.auxiliary();
+    std::vector<std::function<double(double)>> parsed(batch.strings());
+    auto parse = [&batch, &parsed](std::uint32_t index) {
+        if (!parsed[index]) {
+            parsed[index] = FunctionParserBase::parseFunction(std::string(batch.expression(index)));
+        }
+    };
+    std::string error;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!batch.check_row(i, error)) {
+            std::cerr << "\033[31mReaderBIN: problem " << i << " " << error << "\033[0m\n";
+            std::exit(EXIT_FAILURE);
+        }
+        parse(functions[i]);
+        if (auxiliaries[i] != binary_batch_no_function) {
+            parse(auxiliaries[i]);
+        }
+    }
+    return parsed;
+}
+
+std::vector<std::unique_ptr<ConfigBase>> ReaderBIN::make_configs_from_batch(const BinaryBatchView& batch,
+                                                                            bool verbose) {
+    auto parsed = parse_batch(batch);
+    std::vector<std::unique_ptr<ConfigBase>> configs;
+    configs.reserve(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        visit_row(batch, parsed, i, verbose, [&configs](auto& config) {
+            configs.push_back(std::make_unique<std::decay_t<decltype(config)>>(std::move(config)));
+        });
+    }
+    return configs;
+}
+
+std::unique_ptr<ConfigBase> ReaderBIN::read(CLI::App* app, bool verbose) {
+    auto configs = this->read_all(app, verbose);
+    if (configs.empty()) {
+        std::cerr << "\033[31mReaderBIN: empty batch file: " << this->filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    return std::move(configs.front());
+}
+
+std::vector<std::unique_ptr<ConfigBase>> ReaderBIN::read_all(CLI::App* app, bool verbose) {
+    this->filename = app->get_option("--file")->as<std::string>();
+    BinaryBatchView batch(this->filename);
+    if (verbose) {
+        std::cout << "ReaderBIN: read " << batch.size() << " problems (" << batch.strings()
+                  << " distinct expressions)\n";
+    }
+    return make_configs_from_batch(batch, verbose);
+}
+
+bool ReaderDAT::try_read_section(std::istream& input, size_t& lineno, bool verbose, std::unique_ptr<ConfigBase>& out,
+                                 std::string& error) {
+    out.reset();
+    std::string name;
+    std::unordered_map<std::string, std::string> config_map;
+    if (!this->read_section(input, lineno, name, config_map, error)) {
+        return true;
+    }
+    if (!error.empty()) {
+        return false;
     }
 
     if (verbose) {
         config_map["verbose"] = "true";
-        std::cout << "ReaderDAT: read configuration:\n";
+        std::cout << "ReaderDAT: read configuration" << (name.empty() ? "" : " [" + name + "]") << ":\n";
         for (const auto& item : config_map) {
             std::cout << "  " << item.first << " = " << item.second << "\n";
         }
@@ -361,7 +625,344 @@ std::unique_ptr<ConfigBase> ReaderDAT::read(CLI::App* app, bool verbose) {
         config_map["verbose"] = "false";
     }
 
-    return make_config_from_map(config_map);
+    if (!try_make_config_from_map(config_map, out, error)) {
+        error = (name.empty() ? "problem" : "section [" + name + "]") + ": " + error;
+        return false;
+    }
+    out->name = name;
+    return true;
+}
+
+bool ReaderJSONL::parseJsonObject(const std::string& line, std::unordered_map<std::string, std::string>& out) {
+    size_t pos = 0;
+    auto skip_whitespace = [&line, &pos]() {
+        while (pos < line.size() && (std::isspace(static_cast<unsigned char>(line[pos]))) != 0) {
+            ++pos;
+        }
+    };
+    auto append_utf8 = [](std::string& str, unsigned int code_point) {
+        if (code_point < 0x80) {
+            str.push_back(static_cast<char>(code_point));
+        } else if (code_point < 0x800) {
+            str.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+            str.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } else if (code_point < 0x10000) {
+            str.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+            str.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            str.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } else {
+            str.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+            str.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+            str.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            str.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        }
+    };
+    auto parse_hex4 = [&line, &pos](unsigned int& code_unit) {
+        if (pos + 4 > line.size()) {
+            return false;
+        }
+        code_unit = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            char digit = line[pos++];
+            code_unit <<= 4;
+            if (digit >= '0' && digit <= '9') {
+                code_unit |= static_cast<unsigned int>(digit - '0');
+            } else if (digit >= 'a' && digit <= 'f') {
+                code_unit |= static_cast<unsigned int>(digit - 'a' + 10);
+            } else if (digit >= 'A' && digit <= 'F') {
+                code_unit |= static_cast<unsigned int>(digit - 'A' + 10);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    };
+    // parses a string starting at the opening quote, leaving pos after the closing quote
+    auto parse_string = [&](std::string& str) {
+        ++pos;
+        while (pos < line.size() && line[pos] != '"') {
+            char character = line[pos++];
+            if (character != '\\') {
+                str.push_back(character);
+                continue;
+            }
+            if (pos >= line.size()) {
+                return false;
+            }
+            char escape = line[pos++];
+            switch (escape) {
+                case '"':
+                case '\\':
+                case '/':
+                    str.push_back(escape);
+                    break;
+                case 'b':
+                    str.push_back('\b');
+                    break;
+                case 'f':
+                    str.push_back('\f');
+                    break;
+                case 'n':
+                    str.push_back('\n');
+                    break;
+                case 'r':
+                    str.push_back('\r');
+                    break;
+                case 't':
+                    str.push_back('\t');
+                    break;
+                case 'u': {
+                    unsigned int code_point = 0;
+                    if (!parse_hex4(code_point)) {
+                        return false;
+                    }
+                    // combine UTF-16 surrogate pairs
+                    if (code_point >= 0xD800 && code_point <= 0xDBFF && pos + 1 < line.size() && line[pos] == '\\' &&
+                        line[pos + 1] == 'u') {
+                        pos += 2;
+                        unsigned int low = 0;
+                        if (!parse_hex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                            return false;
+                        }
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    append_utf8(str, code_point);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        if (pos >= line.size()) {
+            return false;
+        }
+        ++pos;
+        return true;
+    };
+
+    skip_whitespace();
+    if (pos >= line.size() || line[pos] != '{') {
+        return false;
+    }
+    ++pos;
+    skip_whitespace();
+    if (pos < line.size() && line[pos] == '}') {
+        ++pos;
+    } else {
+        while (true) {
+            std::string key;
+            if (pos >= line.size() || line[pos] != '"' || !parse_string(key)) {
+                return false;
+            }
+            skip_whitespace();
+            if (pos >= line.size() || line[pos] != ':') {
+                return false;
+            }
+            ++pos;
+            skip_whitespace();
+            if (pos >= line.size()) {
+                return false;
+            }
+
+            std::string value;
+            bool is_null = false;
+            if (line[pos] == '"') {
+                if (!parse_string(value)) {
+                    return false;
+                }
+            } else {
+                // numbers and literals are kept verbatim and validated
+                size_t start = pos;
+                while (pos < line.size() && line[pos] != ',' && line[pos] != '}' &&
+                       (std::isspace(static_cast<unsigned char>(line[pos]))) == 0) {
+                    ++pos;
+                }
+                value = line.substr(start, pos - start);
+                double number = 0.0;
+                is_null = value == "null";
+                if (!is_null && value != "true" && value != "false" && !parseDouble(value, number)) {
+                    return false;
+                }
+            }
+
+            std::transform(key.begin(), key.end(), key.begin(),
+                           [](unsigned char character) { return std::tolower(character); });
+            if (!is_null) {
+                out[key] = value;
+            }
+
+            skip_whitespace();
+            if (pos < line.size() && line[pos] == ',') {
+                ++pos;
+                skip_whitespace();
+                continue;
+            }
+            if (pos < line.size() && line[pos] == '}') {
+                ++pos;
+                break;
+            }
+            return false;
+        }
+    }
+    skip_whitespace();
+    return pos == line.size();
+}
+
+bool ReaderJSONL::try_read_line(const std::string& line, std::unique_ptr<ConfigBase>& out, std::string& error,
+                                FunctionCache* cache, bool verbose) {
+    std::unordered_map<std::string, std::string> config_map;
+    if (!parseJsonObject(line, config_map)) {
+        error = "malformed JSON object";
+        return false;
+    }
+
+    std::string name;
+    auto it_name = config_map.find("name");
+    if (it_name != config_map.end()) {
+        name = it_name->second;
+        config_map.erase(it_name);
+    }
+
+    if (verbose) {
+        config_map["verbose"] = "true";
+        std::cout << "ReaderJSONL: read configuration" << (name.empty() ? "" : " [" + name + "]") << ":\n";
+        for (const auto& item : config_map) {
+            std::cout << "  " << item.first << " = " << item.second << "\n";
+        }
+    } else {
+        config_map["verbose"] = "false";
+    }
+
+    if (!try_make_config_from_map(config_map, out, error, cache)) {
+        return false;
+    }
+    out->name = name;
+    return true;
+}
+
+std::unique_ptr<ConfigBase> ReaderJSONL::read_line(const std::string& line, size_t lineno, bool verbose,
+                                                   FunctionCache* cache) {
+    std::unique_ptr<ConfigBase> config;
+    std::string error;
+    if (!try_read_line(line, config, error, cache, verbose)) {
+        std::cerr << "\033[31mReaderJSONL: " << error << " on line " << lineno << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    return config;
+}
+
+std::unique_ptr<ConfigBase> ReaderJSONL::read(CLI::App* app, bool verbose) {
+    this->open(app);
+    auto config = this->read_next(verbose);
+    if (!config) {
+        std::cerr << "\033[31mReaderJSONL: no problem found in file: " << this->filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    return config;
+}
+
+std::vector<std::unique_ptr<ConfigBase>> ReaderJSONL::read_all(CLI::App* app, bool verbose) {
+    std::vector<std::unique_ptr<ConfigBase>> configs;
+    this->open(app);
+    while (auto config = this->read_next(verbose)) {
+        configs.push_back(std::move(config));
+    }
+    return configs;
+}
+
+size_t ReaderJSONL::open(CLI::App* app, size_t lookahead) {
+    this->filename = app->get_option("--file")->as<std::string>();
+    this->input = std::ifstream(this->filename);
+    if (!this->input) {
+        std::cerr << "\033[31mReaderJSONL: failed to open file: " << filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    this->lineno = 0;
+    this->pending.clear();
+
+    // only the problems read ahead are kept, read_next goes on from them without rewinding the file
+    std::string line;
+    while (this->pending.size() < lookahead && std::getline(this->input, line)) {
+        ++this->lineno;
+        if (!trim(line).empty()) {
+            this->pending.emplace_back(this->lineno, std::move(line));
+        }
+    }
+    return this->pending.size();
+}
+
+std::unique_ptr<ConfigBase> ReaderJSONL::read_next(bool verbose) {
+    if (!this->pending.empty()) {
+        auto [lineno, line] = std::move(this->pending.front());
+        this->pending.pop_front();
+        return read_line(line, lineno, verbose);
+    }
+    std::string line;
+    while (std::getline(this->input, line)) {
+        ++this->lineno;
+        if (!trim(line).empty()) {
+            return read_line(line, this->lineno, verbose);
+        }
+    }
+    return nullptr;
+}
+
+ReaderPipe::ReaderPipe(std::istream& input) : input(input) {}
+
+bool ReaderPipe::try_read_next(const std::string& format, bool verbose, std::unique_ptr<ConfigBase>& out,
+                               std::string& error) {
+    out.reset();
+    if (format == "dat") {
+        return this->dat_reader.try_read_section(this->input, this->lineno, verbose, out, error);
+    }
+
+    std::string line;
+    while (std::getline(this->input, line)) {
+        ++this->lineno;
+        if (trim(line).empty()) {
+            continue;
+        }
+        bool read = false;
+        if (format == "jsonl") {
+            read = ReaderJSONL::try_read_line(line, out, error, nullptr, verbose);
+        } else if (this->headers.empty()) {
+            // the first line of a CSV stream holds the column names
+            this->headers = this->csv_reader.read_header(line);
+            continue;
+        } else {
+            read = this->csv_reader.try_read_row(this->headers, line, verbose, out, error);
+        }
+        if (!read) {
+            error = "line " + std::to_string(this->lineno) + ": " + error;
+        }
+        return read;
+    }
+    return true;
+}
+
+std::unique_ptr<ConfigBase> ReaderPipe::read(CLI::App* app, bool verbose) {
+    std::unique_ptr<ConfigBase> config;
+    std::string error;
+    if (!this->try_read(app, verbose, config, error)) {
+        std::cerr << "\033[31mReaderPipe: " << error << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    return config;
+}
+
+bool ReaderPipe::try_read(CLI::App* app, bool verbose, std::unique_ptr<ConfigBase>& out, std::string& error) {
+    auto format = app->get_option("--format")->as<std::string>();
+    this->csv_reader.sep = app->get_option("--sep")->as<char>();
+    this->csv_reader.quote = app->get_option("--quote")->as<char>();
+    return this->try_read_next(format, verbose, out, error);
+}
+
+std::vector<std::unique_ptr<ConfigBase>> ReaderPipe::read_all(CLI::App* app, bool verbose) {
+    std::vector<std::unique_ptr<ConfigBase>> configs;
+    while (auto config = this->read(app, verbose)) {
+        configs.push_back(std::move(config));
+    }
+    return configs;
 }
 
 std::unique_ptr<ConfigBase> ReaderCLI::read(CLI::App* app, bool verbose) {
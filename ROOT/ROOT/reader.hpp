@@ -2,9 +2,9 @@
  * @file reader.hpp
  * @brief Reader classes for reading configuration from files.
  *
- * This file contains the definitions of ReaderBase, ReaderCSV, and ReaderDAT classes,
- * which are responsible for reading configuration data from various file formats
- * (e.g., CSV, DAT) and producing ConfigBase objects.
+ * This file contains the definitions of ReaderBase, ReaderCSV, ReaderDAT, ReaderBIN, ReaderJSONL, and ReaderPipe
+ * classes, which are responsible for reading configuration data from various file formats
+ * (e.g., CSV, DAT, columnar binary, JSON Lines) or streams and producing ConfigBase objects.
  *
  * This file was written with constant LLM assistance (vibe coded). I built
  * the structure and logic, and the LLM helped fill in the details.
@@ -15,11 +15,21 @@
 #define READER_HPP
 
 #include <CLI/CLI.hpp>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <functional>
 #include <memory>
+#include <istream>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "binary_format.hpp"
 #include "config.hpp"
+#include "function_parser.hpp"
 
 /**
  * @brief Base class for Reader classes.
@@ -46,6 +56,15 @@ class ReaderBase {
      * @return A unique pointer to a ConfigBase object representing the read configuration.
      */
     virtual std::unique_ptr<ConfigBase> read(CLI::App* app, bool verbose) = 0;
+    /**
+     * @brief Read every problem described by the input.
+     *
+     * Readers whose input can only describe a single problem fall back to wrapping the result of read.
+     *
+     * @param app The CLI app subcommand containing the options for a specific input type.
+     * @return A vector of unique pointers to ConfigBase objects, one per problem, in input order.
+     */
+    virtual std::vector<std::unique_ptr<ConfigBase>> read_all(CLI::App* app, bool verbose);
 
   protected:
     /**
@@ -91,10 +110,26 @@ class ReaderBase {
      * @brief Helper static method to create a ConfigBase object from a map of string key-value pairs.
      *
      * @param config_map The map containing configuration key-value pairs.
+     * @param cache Optional cache of parsed functions, shared between the problems of a long-lived process.
      * @return A unique pointer to a ConfigBase object representing the configuration.
      */
     static std::unique_ptr<ConfigBase> make_config_from_map(
-        const std::unordered_map<std::string, std::string>& config_map);
+        const std::unordered_map<std::string, std::string>& config_map, FunctionCache* cache = nullptr);
+    /**
+     * @brief Helper static method to create a ConfigBase object from a map, reporting errors instead of exiting.
+     *
+     * A missing or invalid key, an unsupported expression and a Bisection interval without a sign change are all
+     * reported through error, so that a long-lived process can reject a request and keep serving.
+     *
+     * @param config_map The map containing configuration key-value pairs.
+     * @param out A reference to store the configuration.
+     * @param error A reference to store the reason why the configuration was rejected.
+     * @param cache Optional cache of parsed functions, shared between the problems of a long-lived process.
+     * @return true if the configuration was created, false otherwise.
+     */
+    static bool try_make_config_from_map(const std::unordered_map<std::string, std::string>& config_map,
+                                         std::unique_ptr<ConfigBase>& out, std::string& error,
+                                         FunctionCache* cache = nullptr);
 };
 
 /**
@@ -111,6 +146,41 @@ class ReaderCSV : public ReaderBase {
      * @return A unique pointer to a ConfigBase object representing the read configuration.
      */
     std::unique_ptr<ConfigBase> read(CLI::App* app, bool verbose) override;
+    /**
+     * @brief Method to read all the problems from the CSV file, one per row following the header.
+     *
+     * @param app The CLI app subcommand containing the options for the CSV input.
+     * @return A vector of unique pointers to ConfigBase objects, one per non-empty row, in file order.
+     */
+    std::vector<std::unique_ptr<ConfigBase>> read_all(CLI::App* app, bool verbose) override;
+    /**
+     * @brief Split and normalize (trim and lower-case) the header line of a CSV input.
+     *
+     * @param line The header line.
+     * @return A vector of column names.
+     */
+    std::vector<std::string> read_header(const std::string& line) const;
+    /**
+     * @brief Read a single problem from one CSV row.
+     *
+     * @param headers The column names returned by read_header.
+     * @param line The row holding the values of one problem.
+     * @param lineno The line number, used in error messages.
+     * @return A unique pointer to a ConfigBase object representing the read configuration.
+     */
+    std::unique_ptr<ConfigBase> read_row(const std::vector<std::string>& headers, const std::string& line,
+                                         size_t lineno, bool verbose) const;
+    /**
+     * @brief Read a single problem from one CSV row without ever stopping the program.
+     *
+     * @param headers The column names returned by read_header.
+     * @param line The row holding the values of one problem.
+     * @param out A reference to store the configuration.
+     * @param error A reference to store the reason why the row was rejected.
+     * @return true if the row was read, false otherwise.
+     */
+    bool try_read_row(const std::vector<std::string>& headers, const std::string& line, bool verbose,
+                      std::unique_ptr<ConfigBase>& out, std::string& error) const;
 
   private:
     friend class ReaderCSVTester;  //!< Friend test fixture class for unit testing.
@@ -137,9 +207,306 @@ class ReaderDAT : public ReaderBase {
      * @return A unique pointer to a ConfigBase object representing the read configuration.
      */
     std::unique_ptr<ConfigBase> read(CLI::App* app, bool verbose) override;
+    /**
+     * @brief Method to read all the problems (sections) from the DAT file.
+     *
+     * A DAT file can hold several problems, each introduced by a `[problem-name]` header line. The `key = value`
+     * lines appearing before the first header form a global section whose values are inherited by every problem
+     * (and can be overridden inside a section). A file without headers describes exactly one problem.
+     *
+     * @param app The CLI app subcommand containing the options for the DAT input.
+     * @return A vector of unique pointers to ConfigBase objects, one per section, in file order.
+     */
+    std::vector<std::unique_ptr<ConfigBase>> read_all(CLI::App* app, bool verbose) override;
+    /**
+     * @brief Read the next section of a DAT stream as a single problem, without ever stopping the program.
+     *
+     * The sections follow the rules of read_all: the `key = value` lines before the first header are global
+     * defaults inherited by every section, and empty lines do not matter. A section is complete, and solved, once
+     * the next header or the end of the stream is read. A malformed section is read to its end before being
+     * rejected, so that the next call starts on the following section.
+     *
+     * @param input The input stream to read the section from.
+     * @param lineno A reference to the number of lines read so far, used in error messages.
+     * @param out A reference to store the configuration, left empty if the stream has no more sections.
+     * @param error A reference to store the reason why the section was rejected.
+     * @return true if a section was read or the stream is exhausted, false if the section was rejected.
+     */
+    bool try_read_section(std::istream& input, size_t& lineno, bool verbose, std::unique_ptr<ConfigBase>& out,
+                          std::string& error);
+
+  private:
+    friend class ReaderDATTester;                             //!< Friend test fixture class for unit testing.
+    std::unordered_map<std::string, std::string> global_map;  //!< Global defaults read so far.
+    std::optional<std::string> pending_section;  //!< Name of the section header which ended the previous section.
+    std::string pending_error;                   //!< Why the header of the pending section is malformed, if it is.
+    bool sectioned = false;                      //!< Whether a section header (or a headerless problem) was read.
+    /**
+     * @brief Helper method to read the next section of a DAT stream, with the global defaults merged in.
+     *
+     * A stream without headers holds a single problem, its global section, returned at the end of the stream.
+     *
+     * @param input The input stream to read the section from.
+     * @param lineno A reference to the number of lines read so far, used in error messages.
+     * @param name A reference to store the name of the section.
+     * @param config_map A reference to store the key-value pairs of the section.
+     * @param error A reference to store the first malformed line of the section (a malformed global line is
+     * returned on its own, as an empty section), left empty if there is none.
+     * @return true if a section was read, false once the stream has no more sections.
+     */
+    bool read_section(std::istream& input, size_t& lineno, std::string& name,
+                      std::unordered_map<std::string, std::string>& config_map, std::string& error);
+    /**
+     * @brief Helper static method to split a DAT stream into named sections of key-value pairs.
+     *
+     * The global (headerless) section is merged into every named section, and is returned on its own (with an
+     * empty name) only if the stream has no named sections.
+     *
+     * @param input The input stream to read the DAT content from.
+     * @return A vector of (section name, configuration map) pairs, in stream order.
+     */
+    static std::vector<std::pair<std::string, std::unordered_map<std::string, std::string>>> parseSections(
+        std::istream& input);
+};
+
+/**
+ * @brief Reader class for columnar binary batch files.
+ *
+ * This class extends ReaderBase and implements reading a batch of problems from a memory-mapped file in the
+ * columnar binary format documented in binary_format.hpp.
+ */
+class ReaderBIN : public ReaderBase {
+  public:
+    /**
+     * @brief Method to read the first problem from the binary batch file.
+     *
+     * @param app The CLI app subcommand containing the options for the binary input.
+     * @return A unique pointer to a ConfigBase object representing the read configuration.
+     */
+    std::unique_ptr<ConfigBase> read(CLI::App* app, bool verbose) override;
+    /**
+     * @brief Method to read all the problems from the binary batch file.
+     *
+     * @param app The CLI app subcommand containing the options for the binary input.
+     * @return A vector of unique pointers to ConfigBase objects, one per stored problem, in file order.
+     */
+    std::vector<std::unique_ptr<ConfigBase>> read_all(CLI::App* app, bool verbose) override;
+    /**
+     * @brief Static method to check every row of a mapped batch and parse the expressions they reference.
+     *
+     * Each expression of the dictionary is parsed at most once, however many problems reference it. Exits with an
+     * error message on the first row failing BinaryBatchView::check_row.
+     *
+     * @param batch The mapped binary batch.
+     * @return The parsed functions, indexed like the dictionary (entries no row references are left empty).
+     */
+    static std::vector<std::function<double(double)>> parse_batch(const BinaryBatchView& batch);
+    /**
+     * @brief Static method to build the configuration of one row of a mapped batch and hand it over to a visitor.
+     *
+     * The configuration lives on the stack for the duration of the call, so that a batch can be solved straight
+     * from the mapped columns, without keeping a configuration per problem.
+     *
+     * @param batch The mapped binary batch.
+     * @param functions The functions returned by parse_batch for the batch.
+     * @param row The index of the problem.
+     * @param verbose Indicates whether verbose output is enabled.
+     * @param visitor Called with the configuration of the row, as its derived type.
+     */
+    template <typename Visitor>
+    static void visit_row(const BinaryBatchView& batch, const std::vector<std::function<double(double)>>& functions,
+                          std::size_t row, bool verbose, Visitor&& visitor) {
+        double tolerance = batch.tolerance()[row];
+        int max_iterations = batch.max_iterations()[row];
+        bool aitken = batch.aitken()[row] != 0;
+        double first = batch.first()[row];
+        double second = batch.second()[row];
+        const auto& function = functions[batch.function()[row]];
+        switch (batch.method()[row]) {
+            case Method::BISECTION: {
+                BisectionConfig config(tolerance, max_iterations, aitken, function, first, second, verbose);
+                visitor(config);
+                break;
+            }
+            case Method::CHORDS: {
+                ChordsConfig config(tolerance, max_iterations, aitken, function, first, second, verbose);
+                visitor(config);
+                break;
+            }
+            case Method::NEWTON: {
+                NewtonConfig config(tolerance, max_iterations, aitken, function, functions[batch.auxiliary()[row]],
+                                    first, verbose);
+                visitor(config);
+                break;
+            }
+            case Method::FIXED_POINT: {
+                FixedPointConfig config(tolerance, max_iterations, aitken, function, first,
+                                        functions[batch.auxiliary()[row]], verbose);
+                visitor(config);
+                break;
+            }
+            default:
+                // rows with any other method are rejected by parse_batch
+                break;
+        }
+    }
 
   private:
-    friend class ReaderDATTester;  //!< Friend test fixture class for unit testing.
+    friend class ReaderBINTester;  //!< Friend test fixture class for unit testing.
+    /**
+     * @brief Helper static method to create ConfigBase objects from the columns of a mapped batch.
+     *
+     * @param batch The mapped binary batch.
+     * @param verbose Indicates whether verbose output is enabled.
+     * @return A vector of unique pointers to ConfigBase objects, one per stored problem.
+     */
+    static std::vector<std::unique_ptr<ConfigBase>> make_configs_from_batch(const BinaryBatchView& batch,
+                                                                            bool verbose);
+};
+
+/**
+ * @brief Reader class for JSON Lines files.
+ *
+ * This class extends ReaderBase and implements reading problems from a JSON Lines file, holding one flat JSON
+ * object per line (e.g. `{"function": "x^2-4", "method": "newton", "initial": 1, "derivative": "2*x"}`). The keys
+ * are the same as the ones of the DAT format, and an optional "name" key names the problem. The file is streamed
+ * line by line through a small non-DOM tokenizer, so only the current line is ever held in memory.
+ */
+class ReaderJSONL : public ReaderBase {
+  public:
+    /**
+     * @brief Method to read the first problem from the JSON Lines file.
+     *
+     * @param app The CLI app subcommand containing the options for the JSON Lines input.
+     * @return A unique pointer to a ConfigBase object representing the read configuration.
+     */
+    std::unique_ptr<ConfigBase> read(CLI::App* app, bool verbose) override;
+    /**
+     * @brief Method to read all the problems (lines) from the JSON Lines file.
+     *
+     * @param app The CLI app subcommand containing the options for the JSON Lines input.
+     * @return A vector of unique pointers to ConfigBase objects, one per non-empty line, in file order.
+     */
+    std::vector<std::unique_ptr<ConfigBase>> read_all(CLI::App* app, bool verbose) override;
+    /**
+     * @brief Open the JSON Lines file, to be read one problem at a time with read_next.
+     *
+     * The file is read in a single pass, so that it can be a pipe (e.g. /dev/stdin or a process substitution): the
+     * first problems are read ahead, which tells a file holding a single problem from one holding several without
+     * reading it to the end.
+     *
+     * @param app The CLI app subcommand containing the options for the JSON Lines input.
+     * @param lookahead The maximum number of problems to read ahead.
+     * @return The number of problems (non-empty lines) read ahead, lookahead if the file holds at least as many.
+     */
+    size_t open(CLI::App* app, size_t lookahead = 2);
+    /**
+     * @brief Read the next problem from the file opened with open.
+     *
+     * @return A unique pointer to a ConfigBase object, or nullptr once the file is exhausted.
+     */
+    std::unique_ptr<ConfigBase> read_next(bool verbose);
+    /**
+     * @brief Read a single problem from one JSON Lines line.
+     *
+     * @param line The line holding one JSON object.
+     * @param lineno The line number, used in error messages.
+     * @param cache Optional cache of parsed functions, shared between the problems of a long-lived process.
+     * @return A unique pointer to a ConfigBase object representing the read configuration.
+     */
+    static std::unique_ptr<ConfigBase> read_line(const std::string& line, size_t lineno, bool verbose,
+                                                 FunctionCache* cache = nullptr);
+    /**
+     * @brief Read a single problem from one JSON Lines line without ever stopping the program.
+     *
+     * Every error (malformed JSON, missing or invalid key, unsupported expression) is reported through error, so
+     * that a long-lived process can reject a malformed request instead of stopping.
+     *
+     * @param line The line holding one JSON object.
+     * @param out A reference to store the configuration.
+     * @param error A reference to store the reason why the line was rejected.
+     * @param cache Optional cache of parsed functions, shared between the problems of a long-lived process.
+     * @return true if the line was read, false otherwise.
+     */
+    static bool try_read_line(const std::string& line, std::unique_ptr<ConfigBase>& out, std::string& error,
+                              FunctionCache* cache = nullptr, bool verbose = false);
+
+  private:
+    friend class ReaderJSONLTester;  //!< Friend test fixture class for unit testing.
+    std::ifstream input;             //!< The file opened by open.
+    size_t lineno = 0;               //!< Number of lines read so far.
+    //! Lines read ahead by open and not yet returned by read_next, with their line numbers.
+    std::deque<std::pair<size_t, std::string>> pending;
+    /**
+     * @brief Helper static method to tokenize a flat JSON object into key-value pairs.
+     *
+     * Strings are unescaped, while numbers, booleans and null are stored verbatim. Nested objects and arrays are
+     * not supported.
+     *
+     * @param line The input line holding one JSON object.
+     * @param out A reference to store the key-value pairs (keys are lower-cased).
+     * @return true if parsing was successful, false otherwise.
+     */
+    static bool parseJsonObject(const std::string& line, std::unordered_map<std::string, std::string>& out);
+};
+
+/**
+ * @brief Reader class for a continuous stream of problems (e.g. standard input).
+ *
+ * This class extends ReaderBase and implements reading problems one at a time from a stream holding CSV rows
+ * (after a header line), DAT blocks, or JSON Lines, so that each problem can be solved as soon as it is read.
+ */
+class ReaderPipe : public ReaderBase {
+  public:
+    /**
+     * @brief Constructor for ReaderPipe.
+     *
+     * @param input The stream to read problems from.
+     */
+    explicit ReaderPipe(std::istream& input);
+    /**
+     * @brief Method to read the next problem from the stream.
+     *
+     * @param app The CLI app subcommand containing the options for the pipe input.
+     * @return A unique pointer to a ConfigBase object, or nullptr once the stream is exhausted.
+     */
+    std::unique_ptr<ConfigBase> read(CLI::App* app, bool verbose) override;
+    /**
+     * @brief Method to read every remaining problem from the stream.
+     *
+     * @param app The CLI app subcommand containing the options for the pipe input.
+     * @return A vector of unique pointers to ConfigBase objects, one per problem, in stream order.
+     */
+    std::vector<std::unique_ptr<ConfigBase>> read_all(CLI::App* app, bool verbose) override;
+    /**
+     * @brief Read the next problem from the stream without ever stopping the program.
+     *
+     * A malformed problem is skipped and reported through error, so that a continuous stream goes on with the
+     * problems following it.
+     *
+     * @param app The CLI app subcommand containing the options for the pipe input.
+     * @param out A reference to store the configuration, left empty once the stream is exhausted.
+     * @param error A reference to store the reason why the problem was rejected, with its line number.
+     * @return true if a problem was read or the stream is exhausted, false if the problem was rejected.
+     */
+    bool try_read(CLI::App* app, bool verbose, std::unique_ptr<ConfigBase>& out, std::string& error);
+
+  private:
+    friend class ReaderPipeTester;     //!< Friend test fixture class for unit testing.
+    std::istream& input;               //!< The stream to read problems from.
+    size_t lineno = 0;                 //!< Number of lines read so far.
+    ReaderCSV csv_reader;              //!< Row reader used for CSV streams.
+    ReaderDAT dat_reader;              //!< Block reader used for DAT streams.
+    std::vector<std::string> headers;  //!< Column names of a CSV stream, read from its first line.
+    /**
+     * @brief Read the next problem from the stream in a given format, without ever stopping the program.
+     *
+     * @param format The format of the stream: "csv", "dat" or "jsonl".
+     * @param out A reference to store the configuration, left empty once the stream is exhausted.
+     * @param error A reference to store the reason why the problem was rejected, with its line number.
+     * @return true if a problem was read or the stream is exhausted, false if the problem was rejected.
+     */
+    bool try_read_next(const std::string& format, bool verbose, std::unique_ptr<ConfigBase>& out, std::string& error);
 };
 
 /**
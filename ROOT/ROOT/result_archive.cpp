@@ -0,0 +1,243 @@
+/**
+ * @file result_archive.cpp
+ * @brief Implementation of the result archive writer, reader and merger.
+ *
+ * The fixed-size structures are written and mapped as they are laid out in memory, which matches the documented
+ * layout on little-endian hosts.
+ *
+ * @author Saransh-cpp
+ */
+#include "result_archive.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <libROOT/method.hpp>
+
+#include "text_format.hpp"
+
+static_assert(std::endian::native == std::endian::little, "the result archive assumes a little-endian host");
+static_assert(sizeof(ResultArchiveHeader) == 16 && sizeof(ResultRecordHeader) == 56 &&
+                  sizeof(ResultArchiveTrailer) == 24,
+              "the result archive structures must not be padded");
+
+namespace {
+
+/** @brief Round a size up to the 8-byte alignment of the records. */
+constexpr std::uint64_t padded(std::uint64_t size) { return (size + 7) / 8 * 8; }
+
+}  // namespace
+
+ResultArchiveWriter::ResultArchiveWriter(const std::string& filename, bool append)
+    : filename(filename), partial(filename + ".part") {
+    if (append && std::filesystem::exists(filename)) {
+        // keep the records of the archive and load its index, which is rewritten (with the new records) on close
+        ResultArchiveReader existing(filename);
+        this->offsets.assign(existing.index, existing.index + existing.size());
+        this->end = existing.trailer->index_offset;
+        std::error_code error;
+        std::filesystem::copy_file(filename, this->partial, std::filesystem::copy_options::overwrite_existing, error);
+        if (error) {
+            std::cerr << "\033[31mError: could not copy " << filename << " to " << this->partial << ": "
+                      << error.message() << "\033[0m\n";
+            std::exit(EXIT_FAILURE);
+        }
+        this->file.open(this->partial, std::ios::in | std::ios::out | std::ios::binary);
+    } else {
+        this->file.open(this->partial, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    }
+    if (!this->file.is_open()) {
+        std::cerr << "\033[31mError: could not open file " << this->partial << " for writing.\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    if (this->end == 0) {
+        ResultArchiveHeader header{};
+        std::memcpy(header.magic, result_archive_magic, sizeof(result_archive_magic));
+        header.version = result_archive_version;
+        this->file.write(reinterpret_cast<const char*>(&header), sizeof(header));  // NOLINT
+        this->end = sizeof(header);
+    }
+    this->file.seekp(static_cast<std::streamoff>(this->end));
+}
+
+ResultArchiveWriter::~ResultArchiveWriter() {
+    ResultArchiveTrailer trailer{};
+    trailer.count = this->offsets.size();
+    trailer.index_offset = this->end;
+    std::memcpy(trailer.magic, result_archive_index_magic, sizeof(result_archive_index_magic));
+
+    // the new index always ends at or after the old one, so no stale bytes are left at the end of the copy
+    this->file.seekp(static_cast<std::streamoff>(this->end));
+    this->file.write(reinterpret_cast<const char*>(this->offsets.data()),  // NOLINT
+                     static_cast<std::streamsize>(this->offsets.size() * sizeof(std::uint64_t)));
+    this->file.write(reinterpret_cast<const char*>(&trailer), sizeof(trailer));  // NOLINT
+    this->file.flush();
+    bool written = this->file.good();
+    this->file.close();
+
+    // the archive is only replaced once the new one is complete on disk
+    int fd = ::open(this->partial.c_str(), O_RDONLY);
+    written = written && fd >= 0 && ::fsync(fd) == 0;
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    std::error_code error;
+    if (written) {
+        std::filesystem::rename(this->partial, this->filename, error);
+    }
+    if (!written || error) {
+        std::cerr << "\033[31mError: could not write the result archive " << this->filename
+                  << ", its previous content is kept.\033[0m\n";
+        std::filesystem::remove(this->partial, error);
+    }
+}
+
+void ResultArchiveWriter::add(std::uint64_t id, const std::string& name, std::int32_t status,
+                              std::uint64_t evaluations, const Eigen::Ref<const Eigen::MatrixX2d>& results,
+                              bool trajectory) {
+    ResultRecordHeader header{};
+    header.id = id;
+    header.status = status;
+    header.evaluations = evaluations;
+    header.name_length = static_cast<std::uint32_t>(name.size());
+    if (results.rows() > 0) {
+        header.iterations = static_cast<std::int32_t>(results.rows() - 1);
+        header.root = results(results.rows() - 1, 0);
+        header.f_root = results(results.rows() - 1, 1);
+    }
+    header.trajectory_rows = trajectory ? static_cast<std::uint64_t>(results.rows()) : 0;
+
+    std::string record(sizeof(header) + padded(name.size()) + header.trajectory_rows * 2 * sizeof(double), '\0');
+    std::memcpy(record.data(), &header, sizeof(header));
+    std::memcpy(record.data() + sizeof(header), name.data(), name.size());
+    // Eigen stores the results column by column, the archive row by row
+    auto* rows = reinterpret_cast<double*>(record.data() + sizeof(header) + padded(name.size()));  // NOLINT
+    for (std::uint64_t i = 0; i < header.trajectory_rows; ++i) {
+        rows[2 * i] = results(static_cast<Eigen::Index>(i), 0);
+        rows[2 * i + 1] = results(static_cast<Eigen::Index>(i), 1);
+    }
+
+    this->file.write(record.data(), static_cast<std::streamsize>(record.size()));
+    this->offsets.push_back(this->end);
+    this->end += record.size();
+}
+
+ResultArchiveReader::ResultArchiveReader(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "\033[31mResultArchiveReader: failed to open file: " << filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 ||
+        static_cast<std::size_t>(info.st_size) < sizeof(ResultArchiveHeader) + sizeof(ResultArchiveTrailer)) {
+        ::close(fd);
+        std::cerr << "\033[31mResultArchiveReader: file too small to be a result archive: " << filename
+                  << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    this->length = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "\033[31mResultArchiveReader: failed to map file: " << filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    this->data = static_cast<const std::byte*>(mapping);
+    this->trailer = reinterpret_cast<const ResultArchiveTrailer*>(  // NOLINT
+        this->data + this->length - sizeof(ResultArchiveTrailer));
+
+    if (!this->validate()) {
+        std::cerr << "\033[31mResultArchiveReader: malformed result archive: " << filename << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    this->index = reinterpret_cast<const std::uint64_t*>(this->data + this->trailer->index_offset);  // NOLINT
+}
+
+ResultArchiveReader::~ResultArchiveReader() {
+    if (this->data != nullptr) {
+        ::munmap(const_cast<std::byte*>(this->data), this->length);  // NOLINT
+    }
+}
+
+bool ResultArchiveReader::validate() const {
+    const auto* header = reinterpret_cast<const ResultArchiveHeader*>(this->data);  // NOLINT
+    if (std::memcmp(header->magic, result_archive_magic, sizeof(result_archive_magic)) != 0 ||
+        header->version != result_archive_version ||
+        std::memcmp(this->trailer->magic, result_archive_index_magic, sizeof(result_archive_index_magic)) != 0) {
+        return false;
+    }
+    // the index must fill exactly the bytes between the last record and the trailer
+    std::uint64_t index_offset = this->trailer->index_offset;
+    std::uint64_t index_end = this->length - sizeof(ResultArchiveTrailer);
+    return index_offset % 8 == 0 && index_offset >= sizeof(ResultArchiveHeader) && index_offset <= index_end &&
+           this->trailer->count == (index_end - index_offset) / sizeof(std::uint64_t) &&
+           (index_end - index_offset) % sizeof(std::uint64_t) == 0;
+}
+
+ResultRecord ResultArchiveReader::record(std::size_t index) const {
+    std::uint64_t offset = index < this->size() ? this->index[index] : 0;
+    std::uint64_t records_end = this->trailer->index_offset;
+    if (offset < sizeof(ResultArchiveHeader) || offset % 8 != 0 || offset + sizeof(ResultRecordHeader) > records_end) {
+        std::cerr << "\033[31mResultArchiveReader: no valid record at position " << index << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    const auto* header = reinterpret_cast<const ResultRecordHeader*>(this->data + offset);  // NOLINT
+    std::uint64_t available = records_end - offset - sizeof(ResultRecordHeader);
+    if (padded(header->name_length) > available ||
+        header->trajectory_rows > (available - padded(header->name_length)) / (2 * sizeof(double))) {
+        std::cerr << "\033[31mResultArchiveReader: record " << index << " overflows the archive\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    const std::byte* name = this->data + offset + sizeof(ResultRecordHeader);
+    const std::byte* trajectory = name + padded(header->name_length);
+    return {header, {reinterpret_cast<const char*>(name), header->name_length},  // NOLINT
+            {reinterpret_cast<const double*>(trajectory), 2 * header->trajectory_rows}};  // NOLINT
+}
+
+void merge_result_archives(const std::string& output, const std::vector<std::string>& inputs) {
+    for (const auto& input : inputs) {
+        if (std::filesystem::exists(output) && std::filesystem::equivalent(output, input)) {
+            std::cerr << "\033[31mError: cannot merge the archive " << input << " into itself.\033[0m\n";
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    ResultArchiveWriter writer(output, true);
+    for (const auto& input : inputs) {
+        ResultArchiveReader reader(input);
+        // the records of an archive are contiguous, between its header and its index
+        const std::byte* records = reader.data + sizeof(ResultArchiveHeader);
+        std::uint64_t size = reader.trailer->index_offset - sizeof(ResultArchiveHeader);
+        std::uint64_t shift = writer.end - sizeof(ResultArchiveHeader);
+        writer.file.write(reinterpret_cast<const char*>(records), static_cast<std::streamsize>(size));  // NOLINT
+        for (std::size_t i = 0; i < reader.size(); ++i) {
+            writer.offsets.push_back(reader.index[i] + shift);
+        }
+        writer.end += size;
+    }
+}
+
+std::string result_record_json(const ResultRecord& record) {
+    const ResultRecordHeader& header = *record.header;
+    std::string out = "{\"id\":" + std::to_string(header.id) + ",\"name\":";
+    append_json_string(out, record.name);
+    out += ",\"status\":\"";
+    out += solver_status_name(header.status);
+    out += "\",\"root\":";
+    append_json_number(out, header.root);
+    out += ",\"f_root\":";
+    append_json_number(out, header.f_root);
+    out += ",\"iterations\":" + std::to_string(header.iterations);
+    out += ",\"evaluations\":" + std::to_string(header.evaluations);
+    out += ",\"trajectory_rows\":" + std::to_string(header.trajectory_rows) + "}";
+    return out;
+}
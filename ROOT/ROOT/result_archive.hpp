@@ -0,0 +1,207 @@
+/**
+ * @file result_archive.hpp
+ * @brief Indexed, append-only binary archive of solved problems.
+ *
+ * Text outputs appended over several runs can only be read back from the start; the archive instead ends with an
+ * index of record offsets, so that any record is found with a single lookup and shards written by different runs
+ * can be merged without decoding their records. All values are little-endian and every record starts at an
+ * 8-byte aligned offset. A file is laid out as:
+ *
+ * | Section  | Type                        | Content                                                          |
+ * |----------|-----------------------------|------------------------------------------------------------------|
+ * | header   | ResultArchiveHeader         | magic and version                                                |
+ * | records  | ResultRecordHeader + data   | one record per problem, see below                                |
+ * | index    | uint64[count]               | offset of every record, in the order they were added             |
+ * | trailer  | ResultArchiveTrailer        | number of records, offset of the index and a second magic        |
+ *
+ * A record is a ResultRecordHeader followed by the name of the problem (not null-terminated, padded with zeros to
+ * 8 bytes) and by the optional trajectory, stored row by row as trajectory_rows pairs of doubles (x, f(x)).
+ *
+ * An archive is written to a temporary file next to it (a copy of the archive when appending, whose new records
+ * go over the old index and trailer), which replaces the archive once its complete index and trailer are on disk:
+ * an interrupted run leaves the previous archive readable.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef RESULT_ARCHIVE_HPP
+#define RESULT_ARCHIVE_HPP
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Fixed-size header at the beginning of a result archive.
+ *
+ */
+struct ResultArchiveHeader {
+    char magic[8];           //!< File signature, always "ROOTRES" followed by a null byte.
+    std::uint32_t version;   //!< Version of the format (currently 1).
+    std::uint32_t reserved;  //!< Reserved for future use, always 0.
+};
+
+/**
+ * @brief Fixed-size header of every record of a result archive.
+ *
+ */
+struct ResultRecordHeader {
+    std::uint64_t id;               //!< Identifier of the problem (its index in the batch it was read from).
+    std::int32_t status;            //!< SolverStatus enumeration value.
+    std::int32_t iterations;        //!< Number of iterations performed.
+    std::uint64_t evaluations;      //!< Number of function evaluations performed.
+    double root;                    //!< The last estimate of the root.
+    double f_root;                  //!< The function evaluated at the last estimate.
+    std::uint32_t name_length;      //!< Length of the name following the header, without padding.
+    std::uint32_t reserved;         //!< Reserved for future use, always 0.
+    std::uint64_t trajectory_rows;  //!< Number of (x, f(x)) rows stored after the name, 0 if not stored.
+};
+
+/**
+ * @brief Fixed-size trailer at the end of a result archive.
+ *
+ */
+struct ResultArchiveTrailer {
+    std::uint64_t count;         //!< Number of records (and of index entries).
+    std::uint64_t index_offset;  //!< Offset of the index.
+    char magic[8];               //!< Trailer signature, always "ROOTIDX" followed by a null byte.
+};
+
+/** @brief Version of the format written and accepted by ROOT. */
+constexpr std::uint32_t result_archive_version = 1;
+/** @brief Signature at the start of every result archive. */
+constexpr char result_archive_magic[8] = {'R', 'O', 'O', 'T', 'R', 'E', 'S', '\0'};
+/** @brief Signature at the end of every result archive. */
+constexpr char result_archive_index_magic[8] = {'R', 'O', 'O', 'T', 'I', 'D', 'X', '\0'};
+
+/**
+ * @brief A record of an archive, viewed in place.
+ *
+ */
+struct ResultRecord {
+    const ResultRecordHeader* header;    //!< The fixed-size fields of the record.
+    std::string_view name;               //!< The name of the problem, empty if it has none.
+    std::span<const double> trajectory;  //!< The trajectory, row by row (x(0), f(x(0)), x(1), ...), possibly empty.
+};
+
+/**
+ * @brief Writer of result archives, adding one record at a time.
+ *
+ * The records are written to the temporary file `filename.part`; the index and the trailer are written when the
+ * writer is destroyed, which then renames the temporary file to the archive.
+ */
+class ResultArchiveWriter {
+  public:
+    /**
+     * @brief Create an archive, or open an existing one to add records after the ones it holds.
+     *
+     * @param filename The path of the archive, including its extension.
+     * @param append Whether to keep the records of an existing archive (a missing archive is created).
+     */
+    ResultArchiveWriter(const std::string& filename, bool append);
+    /**
+     * @brief Write the index and the trailer, and replace the archive with the completed temporary file.
+     *
+     */
+    ~ResultArchiveWriter();
+    ResultArchiveWriter(const ResultArchiveWriter&) = delete;
+    ResultArchiveWriter& operator=(const ResultArchiveWriter&) = delete;
+    /**
+     * @brief Add the record of a solved problem.
+     *
+     * @param id The identifier of the problem.
+     * @param name The name of the problem, possibly empty.
+     * @param status The SolverStatus enumeration value.
+     * @param evaluations The number of function evaluations.
+     * @param results The results of the solver (x(i) in the first column, f(x(i)) in the second one).
+     * @param trajectory Whether to store every row of the results, or only the last one.
+     */
+    void add(std::uint64_t id, const std::string& name, std::int32_t status, std::uint64_t evaluations,
+             const Eigen::Ref<const Eigen::MatrixX2d>& results, bool trajectory);
+    /** @brief Number of records in the archive, including the ones it held when it was opened. */
+    std::size_t size() const { return this->offsets.size(); }
+
+  private:
+    friend class ResultArchiveTester;  //!< Friend test fixture class for unit testing.
+    friend void merge_result_archives(const std::string&, const std::vector<std::string>&);  //!< Copies records.
+    std::string filename;                //!< The path of the archive.
+    std::string partial;                 //!< The temporary file written, renamed to filename once complete.
+    std::fstream file;                   //!< The temporary file being written.
+    std::vector<std::uint64_t> offsets;  //!< The offset of every record, written as the index.
+    std::uint64_t end = 0;               //!< The offset following the last record.
+};
+
+/**
+ * @brief Read-only, memory-mapped view over a result archive.
+ *
+ * Nothing is read until a record is accessed, and accessing a record only touches its own pages.
+ */
+class ResultArchiveReader {
+  public:
+    /**
+     * @brief Map and validate a result archive.
+     *
+     * @param filename The path of the archive to map.
+     */
+    explicit ResultArchiveReader(const std::string& filename);
+    /**
+     * @brief Unmap the archive.
+     *
+     */
+    ~ResultArchiveReader();
+    ResultArchiveReader(const ResultArchiveReader&) = delete;
+    ResultArchiveReader& operator=(const ResultArchiveReader&) = delete;
+
+    /** @brief Number of records stored in the archive. */
+    std::size_t size() const { return this->trailer->count; }
+    /**
+     * @brief Access a record.
+     *
+     * @param index The position of the record in the archive, from 0 to size() - 1.
+     * @return A view of the record, pointing into the mapping.
+     */
+    ResultRecord record(std::size_t index) const;
+
+  private:
+    friend class ResultArchiveTester;  //!< Friend test fixture class for unit testing.
+    friend class ResultArchiveWriter;  //!< Loads the index of the archives it appends to.
+    friend void merge_result_archives(const std::string&, const std::vector<std::string>&);  //!< Copies records.
+    const std::byte* data = nullptr;                //!< Start of the mapping.
+    std::size_t length = 0;                         //!< Length of the mapping in bytes.
+    const ResultArchiveTrailer* trailer = nullptr;  //!< The trailer at the end of the mapping.
+    const std::uint64_t* index = nullptr;           //!< The index of record offsets.
+    /**
+     * @brief Helper method to check the signatures and that the index lies inside the mapping.
+     *
+     * The records themselves are only checked when they are accessed, so that opening an archive does not depend
+     * on its size.
+     *
+     * @return true if the archive is well-formed, false otherwise.
+     */
+    bool validate() const;
+};
+
+/**
+ * @brief Append the records of several archives to an archive, without decoding them.
+ *
+ * The records of every input are copied as a single block and their offsets are shifted into the index of the
+ * output; the identifiers are kept, so shards of the same batch merge back into the batch.
+ *
+ * @param output The archive to write (created if missing, extended otherwise).
+ * @param inputs The archives to copy, in order.
+ */
+void merge_result_archives(const std::string& output, const std::vector<std::string>& inputs);
+
+/**
+ * @brief Describe a record as a JSON object (without its trajectory).
+ *
+ * @param record The record to describe.
+ * @return The object, on a single line.
+ */
+std::string result_record_json(const ResultRecord& record);
+
+#endif  // RESULT_ARCHIVE_HPP
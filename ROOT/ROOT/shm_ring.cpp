@@ -0,0 +1,280 @@
+#include "shm_ring.hpp"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <utility>
+
+static_assert(sizeof(ShmRequest) == 256, "ShmRequest must keep its fixed layout");
+static_assert(sizeof(ShmResult) == 32, "ShmResult must keep its fixed layout");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+              "shared-memory rings require address-free atomics");
+
+namespace {
+
+/** @brief Number of polls a consumer spins for before sleeping on the futex. */
+constexpr int spin_polls = 4096;
+
+std::size_t round_up(std::size_t bytes) { return (bytes + 63) / 64 * 64; }
+
+void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected, const timespec* timeout) {
+    // shared (not FUTEX_PRIVATE) futexes, the other side lives in another process
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, timeout, nullptr,  // NOLINT
+              0);
+}
+
+void futex_wake(std::atomic<std::uint32_t>& word) {
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr,  // NOLINT
+              0);
+}
+
+/**
+ * @brief Single-producer/single-consumer ring over the slots of a segment.
+ *
+ * Head and tail grow forever and are reduced modulo the (power of two) capacity when indexing a slot.
+ */
+template <typename Record>
+class Ring {
+  public:
+    Ring(ShmRingIndices& indices, Record* slots, std::uint32_t capacity)
+        : indices(indices), slots(slots), mask(capacity - 1) {}
+
+    bool try_push(const Record& record) {
+        std::uint64_t tail = this->indices.tail.load(std::memory_order_relaxed);
+        if (tail - this->indices.head.load(std::memory_order_acquire) > this->mask) {
+            return false;
+        }
+        this->slots[tail & this->mask] = record;
+        this->indices.tail.store(tail + 1, std::memory_order_release);
+        this->indices.sequence.fetch_add(1, std::memory_order_seq_cst);
+        if (this->indices.waiters.load(std::memory_order_seq_cst) != 0) {
+            futex_wake(this->indices.sequence);
+        }
+        return true;
+    }
+
+    bool try_pop(Record& record) {
+        std::uint64_t head = this->indices.head.load(std::memory_order_relaxed);
+        if (head == this->indices.tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        record = this->slots[head & this->mask];
+        this->indices.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Block until the ring is not empty, stop becomes true or the timeout (nullptr: none) expires.
+     *
+     * Spurious returns are allowed.
+     */
+    void wait(const std::atomic<std::uint32_t>& stop, const timespec* timeout) {
+        for (int poll = 0; poll < spin_polls; ++poll) {
+            if (!this->empty() || stop.load(std::memory_order_relaxed) != 0) {
+                return;
+            }
+        }
+        // registering as a waiter before the last check guarantees that a producer publishing afterwards
+        // either sees the waiter and wakes it up, or bumps sequence so that the futex does not sleep
+        this->indices.waiters.fetch_add(1, std::memory_order_seq_cst);
+        std::uint32_t sequence = this->indices.sequence.load(std::memory_order_seq_cst);
+        if (this->empty() && stop.load(std::memory_order_seq_cst) == 0) {
+            futex_wait(this->indices.sequence, sequence, timeout);
+        }
+        this->indices.waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    /** @brief Wake up a sleeping consumer without publishing anything (e.g. to let it notice a stop request). */
+    void wake() {
+        this->indices.sequence.fetch_add(1, std::memory_order_seq_cst);
+        futex_wake(this->indices.sequence);
+    }
+
+  private:
+    ShmRingIndices& indices;
+    Record* slots;
+    std::uint64_t mask;
+
+    bool empty() const {
+        return this->indices.head.load(std::memory_order_relaxed) ==
+               this->indices.tail.load(std::memory_order_acquire);
+    }
+};
+
+}  // namespace
+
+ShmSegment::ShmSegment(const std::string& name, std::uint32_t capacity, bool create) : name(name), owner(create) {
+    int fd = -1;
+    if (create) {
+        std::uint32_t slots = 1;
+        while (slots < capacity) {
+            slots <<= 1U;
+        }
+        capacity = slots;
+        // a segment left behind by a previous server is replaced
+        ::shm_unlink(name.c_str());
+        fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        this->length = round_up(sizeof(ShmHeader)) + round_up(capacity * sizeof(ShmRequest)) +
+                       round_up(capacity * sizeof(ShmResult));
+        if (fd >= 0 && ::ftruncate(fd, static_cast<off_t>(this->length)) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    } else {
+        fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        struct stat info {};
+        if (fd >= 0 && (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(ShmHeader))) {
+            ::close(fd);
+            fd = -1;
+        }
+        if (fd >= 0) {
+            this->length = static_cast<std::size_t>(info.st_size);
+        }
+    }
+    if (fd < 0) {
+        std::cerr << "\033[31mShmSegment: failed to " << (create ? "create" : "open") << " segment " << name << ": "
+                  << std::strerror(errno) << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    this->mapping = ::mmap(nullptr, this->length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (this->mapping == MAP_FAILED) {
+        std::cerr << "\033[31mShmSegment: failed to map segment " << name << "\033[0m\n";
+        std::exit(EXIT_FAILURE);
+    }
+    auto* bytes = static_cast<std::byte*>(this->mapping);
+
+    if (create) {
+        // the new segment is zero-filled, which is also the initial state of every index
+        this->head = new (bytes) ShmHeader{};
+        std::memcpy(this->head->magic, shm_magic, sizeof(shm_magic));
+        this->head->version = shm_version;
+        this->head->capacity = capacity;
+        this->head->server.store(static_cast<std::int32_t>(::getpid()));
+    } else {
+        this->head = std::launder(reinterpret_cast<ShmHeader*>(bytes));  // NOLINT
+        std::uint32_t slots = this->head->capacity;
+        if (std::memcmp(this->head->magic, shm_magic, sizeof(shm_magic)) != 0 || this->head->version != shm_version ||
+            slots == 0 || (slots & (slots - 1)) != 0 ||
+            this->length < round_up(sizeof(ShmHeader)) + round_up(slots * sizeof(ShmRequest)) +
+                               round_up(slots * sizeof(ShmResult))) {
+            std::cerr << "\033[31mShmSegment: malformed segment " << name << "\033[0m\n";
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    this->request_slots = reinterpret_cast<ShmRequest*>(bytes + round_up(sizeof(ShmHeader)));  // NOLINT
+    this->result_slots = reinterpret_cast<ShmResult*>(                                         // NOLINT
+        bytes + round_up(sizeof(ShmHeader)) + round_up(this->head->capacity * sizeof(ShmRequest)));
+}
+
+ShmSegment::~ShmSegment() {
+    ::munmap(this->mapping, this->length);
+    if (this->owner) {
+        ::shm_unlink(this->name.c_str());
+    }
+}
+
+ShmServer::ShmServer(const std::string& name, std::uint32_t capacity, Handler handler)
+    : segment(name, capacity, true), handler(std::move(handler)) {}
+
+void ShmServer::serve() {
+    ShmHeader& header = this->segment.header();
+    Ring<ShmRequest> requests(header.requests, this->segment.requests(), header.capacity);
+    Ring<ShmResult> results(header.results, this->segment.results(), header.capacity);
+
+    ShmRequest request{};
+    while (true) {
+        if (requests.try_pop(request)) {
+            ShmResult result = this->handler(request);
+            // the client drains results while it waits, so a full result ring only lasts a moment
+            bool published = false;
+            while (!(published = results.try_push(result)) && header.stopping.load() == 0) {
+                std::this_thread::yield();
+            }
+            if (!published) {
+                break;
+            }
+            continue;
+        }
+        if (header.stopping.load() != 0) {
+            break;
+        }
+        requests.wait(header.stopping, nullptr);
+    }
+    // no result is published anymore: a client waiting for one gives up instead of sleeping forever
+    header.server.store(0);
+    results.wake();
+}
+
+ShmClient::ShmClient(const std::string& name) : segment(name, 0, false) {}
+
+bool ShmClient::try_submit(const ShmRequest& request) {
+    ShmHeader& header = this->segment.header();
+    return Ring<ShmRequest>(header.requests, this->segment.requests(), header.capacity).try_push(request);
+}
+
+bool ShmClient::try_receive(ShmResult& result) {
+    ShmHeader& header = this->segment.header();
+    return Ring<ShmResult>(header.results, this->segment.results(), header.capacity).try_pop(result);
+}
+
+bool ShmClient::receive(ShmResult& result) {
+    return this->receive_until(result, std::chrono::steady_clock::time_point::max());
+}
+
+bool ShmClient::receive(ShmResult& result, std::chrono::milliseconds timeout) {
+    return this->receive_until(result, std::chrono::steady_clock::now() + timeout);
+}
+
+bool ShmClient::receive_until(ShmResult& result, std::chrono::steady_clock::time_point deadline) {
+    ShmHeader& header = this->segment.header();
+    Ring<ShmResult> results(header.results, this->segment.results(), header.capacity);
+    while (!results.try_pop(result)) {
+        if (!this->server_alive()) {
+            // a result published right before the server went away is still taken
+            return results.try_pop(result);
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        // sleep at most for the liveness period, so that a server dying meanwhile is noticed
+        auto nap = std::min<std::chrono::nanoseconds>(deadline - now, shm_liveness_period);
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(nap);
+        timespec timeout{static_cast<time_t>(seconds.count()), static_cast<long>((nap - seconds).count())};
+        results.wait(header.stopping, &timeout);
+    }
+    return true;
+}
+
+bool ShmClient::server_alive() const {
+    std::int32_t pid = this->segment.header().server.load();
+    // EPERM: the process exists but belongs to another user
+    return pid != 0 && (::kill(pid, 0) == 0 || errno == EPERM);
+}
+
+void ShmClient::stop() {
+    ShmHeader& header = this->segment.header();
+    header.stopping.store(1);
+    Ring<ShmRequest>(header.requests, this->segment.requests(), header.capacity).wake();
+}
+
+bool shm_set_expression(char (&field)[shm_expression_size], const std::string& expression) {
+    if (expression.size() >= shm_expression_size) {
+        return false;
+    }
+    std::memcpy(field, expression.c_str(), expression.size() + 1);
+    return true;
+}
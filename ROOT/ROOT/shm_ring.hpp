@@ -0,0 +1,253 @@
+/**
+ * @file shm_ring.hpp
+ * @brief Shared-memory transport for solve requests between co-located processes.
+ *
+ * A POSIX shared-memory segment holds two lock-free single-producer/single-consumer rings of fixed-layout
+ * records: requests (written by the client, read by the server) and results (written by the server, read by the
+ * client). Producers copy a record into a slot and publish it with a single atomic store, so that no system call
+ * is made while the other side is busy; a consumer with nothing to do spins for a short while and then sleeps on
+ * a futex, which the producer only wakes up when somebody is actually sleeping. A sleeping client also wakes up
+ * periodically to check that the server it waits for is still alive, so that it never hangs on a dead server.
+ *
+ * The segment is laid out as:
+ *
+ * | Section  | Type                      | Content                                                |
+ * |----------|---------------------------|--------------------------------------------------------|
+ * | header   | ShmHeader                 | magic, version, capacity, server, indices and futexes |
+ * | requests | ShmRequest[capacity]      | request ring                                           |
+ * | results  | ShmResult[capacity]       | result ring                                            |
+ *
+ * Every process using a segment must run on the same machine (and thus share the same endianness and layout).
+ *
+ * @author Saransh-cpp
+ */
+#ifndef SHM_RING_HPP
+#define SHM_RING_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/** @brief Size of the expression fields of a request, including the terminating null character. */
+constexpr std::size_t shm_expression_size = 104;
+/** @brief Version of the segment layout written and accepted by ROOT. */
+constexpr std::uint32_t shm_version = 2;
+/** @brief Signature at the start of every segment. */
+constexpr char shm_magic[8] = {'R', 'O', 'O', 'T', 'S', 'H', 'M', '\0'};
+/** @brief Longest time a waiting client sleeps before checking that the server is still alive. */
+constexpr std::chrono::milliseconds shm_liveness_period{100};
+
+/**
+ * @brief Fixed-layout solve request (one cache-line multiple, 256 bytes).
+ *
+ */
+struct alignas(64) ShmRequest {
+    std::uint64_t id;                     //!< Identifier chosen by the client, copied into the result.
+    std::int32_t method;                  //!< Method enumeration value.
+    std::int32_t max_iterations;          //!< Maximum number of iterations.
+    double tolerance;                     //!< Tolerance for convergence.
+    double first;                         //!< Initial guess (newton, fixed_point), x0 or interval_a.
+    double second;                        //!< x1 or interval_b (ignored by newton and fixed_point).
+    std::uint8_t aitken;                  //!< 1 if Aitken acceleration is enabled, 0 otherwise.
+    char function[shm_expression_size];   //!< The function, null-terminated.
+    char auxiliary[shm_expression_size];  //!< The derivative or g-function, null-terminated (may be empty).
+};
+
+/** @brief Outcome of a request. */
+enum ShmStatus : std::int32_t {
+    SHM_SOLVED = 0,            //!< The problem converged, root and f_root hold the last iteration.
+    SHM_REJECTED = 1,          //!< The problem is malformed (e.g. unknown method or unsupported function).
+    SHM_MAX_ITERATIONS = 2,    //!< The maximum number of iterations was reached first.
+    SHM_DIVERGED = 3,          //!< The iterates or their evaluations stopped being finite numbers.
+    SHM_TIMED_OUT = 4,         //!< The time limit of the server was reached first, root holds the best iteration.
+    SHM_BUDGET_EXHAUSTED = 5,  //!< The evaluation budget of the server was spent first, root holds the best iteration.
+};
+
+/**
+ * @brief Fixed-layout result of a request (32 bytes).
+ *
+ */
+struct ShmResult {
+    std::uint64_t id;         //!< Identifier of the answered request.
+    double root;              //!< The estimate of the root (the last iterate, or the best one if a limit was hit).
+    double f_root;            //!< The function evaluated at root.
+    std::int32_t iterations;  //!< Number of iterations performed.
+    std::int32_t status;      //!< ShmStatus of the request.
+};
+
+/**
+ * @brief Indices and futex word of one ring; head and tail live on separate cache lines.
+ *
+ */
+struct ShmRingIndices {
+    alignas(64) std::atomic<std::uint64_t> head;      //!< Next slot to read, only written by the consumer.
+    alignas(64) std::atomic<std::uint64_t> tail;      //!< Next slot to write, only written by the producer.
+    alignas(64) std::atomic<std::uint32_t> sequence;  //!< Futex word, bumped on every publication.
+    std::atomic<std::uint32_t> waiters;               //!< Number of consumers sleeping on sequence.
+};
+
+/**
+ * @brief Header at the start of a segment.
+ *
+ */
+struct ShmHeader {
+    char magic[8];                        //!< Segment signature, always "ROOTSHM" followed by a null byte.
+    std::uint32_t version;                //!< Version of the layout.
+    std::uint32_t capacity;               //!< Number of slots of each ring (a power of two).
+    std::atomic<std::uint32_t> stopping;  //!< Set by a client to stop the server.
+    std::atomic<std::int32_t> server;     //!< Process id of the server, 0 once it stopped answering requests.
+    ShmRingIndices requests;              //!< Indices of the request ring.
+    ShmRingIndices results;               //!< Indices of the result ring.
+};
+
+/**
+ * @brief Memory mapping of a segment, shared by the server and the client.
+ *
+ */
+class ShmSegment {
+  public:
+    /**
+     * @brief Create (server) or open (client) a segment.
+     *
+     * @param name The POSIX shared-memory name of the segment (e.g. "/root-ring").
+     * @param capacity The number of slots of each ring, rounded up to a power of two (only used when creating).
+     * @param create Whether to create the segment (replacing an existing one) or to open an existing one.
+     */
+    ShmSegment(const std::string& name, std::uint32_t capacity, bool create);
+    /**
+     * @brief Unmap the segment, and remove its name if this process created it.
+     *
+     */
+    ~ShmSegment();
+    ShmSegment(const ShmSegment&) = delete;
+    ShmSegment& operator=(const ShmSegment&) = delete;
+
+    /** @brief The header of the segment. */
+    ShmHeader& header() const { return *this->head; }
+    /** @brief The slots of the request ring. */
+    ShmRequest* requests() const { return this->request_slots; }
+    /** @brief The slots of the result ring. */
+    ShmResult* results() const { return this->result_slots; }
+
+  private:
+    friend class ShmRingTester;           //!< Friend test fixture class for unit testing.
+    std::string name;                     //!< The POSIX shared-memory name of the segment.
+    bool owner = false;                   //!< Whether this process created the segment.
+    void* mapping = nullptr;              //!< Start of the mapping.
+    std::size_t length = 0;               //!< Length of the mapping in bytes.
+    ShmHeader* head = nullptr;            //!< The header at the start of the mapping.
+    ShmRequest* request_slots = nullptr;  //!< The slots of the request ring.
+    ShmResult* result_slots = nullptr;    //!< The slots of the result ring.
+};
+
+/**
+ * @brief Server side of a segment: consumes requests and produces results.
+ *
+ */
+class ShmServer {
+  public:
+    /**
+     * @brief Type of the function answering a request.
+     *
+     */
+    using Handler = std::function<ShmResult(const ShmRequest&)>;
+    /**
+     * @brief Create the segment.
+     *
+     * @param name The POSIX shared-memory name of the segment.
+     * @param capacity The number of slots of each ring.
+     * @param handler The function answering every request.
+     */
+    ShmServer(const std::string& name, std::uint32_t capacity, Handler handler);
+    /**
+     * @brief Answer requests, in order, until a client stops the server.
+     *
+     */
+    void serve();
+
+  private:
+    friend class ShmRingTester;  //!< Friend test fixture class for unit testing.
+    ShmSegment segment;          //!< The shared segment.
+    Handler handler;             //!< The function answering every request.
+};
+
+/**
+ * @brief Client side of a segment: produces requests and consumes results.
+ *
+ * A client must be used from a single thread, and a segment must have a single client at a time.
+ */
+class ShmClient {
+  public:
+    /**
+     * @brief Open the segment of a running server.
+     *
+     * @param name The POSIX shared-memory name of the segment.
+     */
+    explicit ShmClient(const std::string& name);
+    /**
+     * @brief Publish a request without blocking.
+     *
+     * @param request The request to publish.
+     * @return true if the request was published, false if the request ring is full.
+     */
+    bool try_submit(const ShmRequest& request);
+    /**
+     * @brief Take the next result without blocking.
+     *
+     * @param result A reference to store the result.
+     * @return true if a result was available, false otherwise.
+     */
+    bool try_receive(ShmResult& result);
+    /**
+     * @brief Wait for the next result as long as the server is alive.
+     *
+     * @param result A reference to store the result.
+     * @return true if a result was received (in request order), false if the server stopped or died first.
+     */
+    bool receive(ShmResult& result);
+    /**
+     * @brief Wait for the next result, at most for a given time.
+     *
+     * @param result A reference to store the result.
+     * @param timeout The longest time to wait for.
+     * @return true if a result was received (in request order), false on timeout or if the server stopped or died.
+     */
+    bool receive(ShmResult& result, std::chrono::milliseconds timeout);
+    /**
+     * @brief Ask the server to stop once the published requests are answered.
+     *
+     */
+    void stop();
+
+  private:
+    friend class ShmRingTester;  //!< Friend test fixture class for unit testing.
+    ShmSegment segment;          //!< The shared segment.
+    /**
+     * @brief Wait for the next result until a deadline.
+     *
+     * @param result A reference to store the result.
+     * @param deadline The time to give up at (time_point::max() to wait as long as the server is alive).
+     * @return true if a result was received, false on timeout or if the server stopped or died.
+     */
+    bool receive_until(ShmResult& result, std::chrono::steady_clock::time_point deadline);
+    /**
+     * @brief Check whether the server is still answering requests.
+     *
+     * @return true if the server has not stopped and its process still exists.
+     */
+    bool server_alive() const;
+};
+
+/**
+ * @brief Copy an expression into a fixed-size request field.
+ *
+ * @param field The field to fill.
+ * @param expression The expression to copy.
+ * @return true if the expression fits (with its terminating null character), false otherwise.
+ */
+bool shm_set_expression(char (&field)[shm_expression_size], const std::string& expression);
+
+#endif  // SHM_RING_HPP
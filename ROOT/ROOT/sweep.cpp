@@ -0,0 +1,196 @@
+/**
+ * @file sweep.cpp
+ * @brief Implementation of the parameter sweeps and of their rows.
+ *
+ * @author Saransh-cpp
+ */
+#include "sweep.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <iterator>
+#include <regex>
+
+#include "text_format.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+
+/** @brief Parse a whole string as a number. */
+bool parse_number(const std::string& text, double& number) {
+    const char* last = text.data() + text.size();
+    auto [end, ec] = std::from_chars(text.data(), last, number);
+    return !text.empty() && ec == std::errc() && end == last && std::isfinite(number);
+}
+
+/**
+ * @brief Split "name=value" on its equal sign, dropping the spaces.
+ *
+ * The name must be usable as a factor of a parsed term: an identifier other than the variable x, which does not
+ * contain the name of a trigonometric function (the parser would then read the whole expression as trigonometric).
+ */
+bool split_assignment(const std::string& text, std::string& name, std::string& value) {
+    std::string compact;
+    std::copy_if(text.begin(), text.end(), std::back_inserter(compact),
+                 [](unsigned char character) { return std::isspace(character) == 0; });
+    auto equal = compact.find('=');
+    if (equal == std::string::npos) {
+        return false;
+    }
+    name = compact.substr(0, equal);
+    value = compact.substr(equal + 1);
+    static const std::regex identifier(R"(^[A-Za-z_][A-Za-z0-9_]*$)");
+    return std::regex_match(name, identifier) && name != "x" && name != "X" &&
+           !std::regex_search(name, std::regex("sin|cos", std::regex::icase));
+}
+
+}  // namespace
+
+std::size_t SweepRange::size() const {
+    // the tolerance keeps the stop value when the division lands just below a whole number of steps
+    return static_cast<std::size_t>(std::floor((this->stop - this->start) / this->step + 1e-9)) + 1;
+}
+
+double SweepRange::value(std::size_t index) const { return this->start + static_cast<double>(index) * this->step; }
+
+bool parse_sweep_range(const std::string& text, SweepRange& range) {
+    std::string name;
+    std::string values;
+    if (!split_assignment(text, name, values)) {
+        return false;
+    }
+    auto first_colon = values.find(':');
+    auto second_colon = first_colon == std::string::npos ? first_colon : values.find(':', first_colon + 1);
+    if (second_colon == std::string::npos) {
+        return false;
+    }
+    SweepRange parsed;
+    parsed.name = name;
+    if (!parse_number(values.substr(0, first_colon), parsed.start) ||
+        !parse_number(values.substr(first_colon + 1, second_colon - first_colon - 1), parsed.stop) ||
+        !parse_number(values.substr(second_colon + 1), parsed.step) || parsed.step == 0.0 ||
+        (parsed.stop - parsed.start) * parsed.step < 0.0) {
+        return false;
+    }
+    range = parsed;
+    return true;
+}
+
+bool parse_sweep_parameter(const std::string& text, std::string& name, double& value) {
+    std::string parsed_name;
+    std::string parsed_value;
+    double number = 0.0;
+    if (!split_assignment(text, parsed_name, parsed_value) || !parse_number(parsed_value, number)) {
+        return false;
+    }
+    name = parsed_name;
+    value = number;
+    return true;
+}
+
+SweepSeed warm_start(Method method, const SweepSeed& cold, const std::vector<double>& roots,
+                     const std::function<double(double)>& function) {
+    if (roots.empty()) {
+        return cold;
+    }
+    // the points are evenly spaced, so the next root is extrapolated linearly from the last two
+    double last = roots.back();
+    double step = roots.size() > 1 ? last - roots[roots.size() - 2] : 0.0;
+    double prediction = last + step;
+    double width = std::abs(cold.second - cold.first);
+    double spread = width > 0.0 ? 1e-3 * width : 1e-3;
+
+    SweepSeed seed = cold;
+    switch (method) {
+        case Method::NEWTON:
+        case Method::FIXED_POINT:
+            seed.first = prediction;
+            return seed;
+        case Method::CHORDS:
+            // the solve starts from the second point, the first one only sets the slope of the first chord
+            seed.second = prediction;
+            seed.first = prediction != last ? last : prediction - spread;
+            return seed;
+        case Method::BISECTION: {
+            double half = std::max(std::abs(step), spread);
+            for (int attempt = 0; attempt < 16; ++attempt, half *= 2) {
+                double left = prediction - half;
+                double right = prediction + half;
+                seed.evaluations += 2;
+                if (function(left) * function(right) <= 0.0) {
+                    seed.first = left;
+                    seed.second = right;
+                    return seed;
+                }
+            }
+            seed.first = cold.first;
+            seed.second = cold.second;
+            return seed;
+        }
+        default:
+            return cold;
+    }
+}
+
+std::vector<SweepPoint> run_sweep(const SweepRange& range, Method method, const SweepSeed& cold, bool warm,
+                                  std::size_t jobs, const std::function<SweepProblem()>& make_problem) {
+    std::size_t size = range.size();
+    std::size_t chunks = std::clamp<std::size_t>(jobs, 1, size);
+    std::vector<SweepPoint> points(size);
+
+    {
+        ThreadPool pool(chunks);
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            // every chunk writes its own points, so the threads share nothing but the vector
+            pool.submit([&, first = chunk * size / chunks, last = (chunk + 1) * size / chunks] {
+                SweepProblem problem = make_problem();
+                std::vector<double> roots;
+                for (std::size_t i = first; i < last; ++i) {
+                    *problem.parameter = range.value(i);
+                    SweepSeed seed = warm ? warm_start(method, cold, roots, problem.function) : cold;
+                    SweepPoint point = problem.solve(seed);
+                    point.parameter = range.value(i);
+                    point.evaluations += seed.evaluations;
+                    // a failed point breaks the continuation, the next one starts cold again
+                    if (point.status == SolverStatus::CONVERGED) {
+                        roots.push_back(point.root);
+                        if (roots.size() > 2) {
+                            roots.erase(roots.begin());
+                        }
+                    } else {
+                        roots.clear();
+                    }
+                    points[i] = point;
+                }
+            });
+        }
+        // the pool joins its threads once every chunk is solved
+    }
+    return points;
+}
+
+std::string sweep_csv_header(const std::string& name, char separator) {
+    std::string header = name;
+    for (const char* column : {"status", "root", "residual", "iterations", "evaluations"}) {
+        header += separator;
+        header += column;
+    }
+    return header + '\n';
+}
+
+void append_sweep_csv(std::string& out, const SweepPoint& point, char separator) {
+    append_number(out, point.parameter);
+    out += separator;
+    out += solver_status_name(point.status);
+    out += separator;
+    append_number(out, point.root);
+    out += separator;
+    append_number(out, point.residual);
+    out += separator;
+    out += std::to_string(point.iterations);
+    out += separator;
+    out += std::to_string(point.evaluations);
+    out += '\n';
+}
@@ -0,0 +1,144 @@
+/**
+ * @file sweep.hpp
+ * @brief Continuation over a range of values of a named parameter of the function.
+ *
+ * The points of a sweep are solved in increasing order, and the roots found at the previous points seed the next
+ * solve: the initial guess of Newton and fixed-point iterations is extrapolated from the last two roots, and the
+ * interval of the two-point methods is placed around that prediction. Parallel sweeps split the range in contiguous
+ * chunks, each continued on its own thread from a cold start.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <libROOT/method.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A range of values of a named parameter, written as "name=start:stop:step".
+ *
+ */
+struct SweepRange {
+    std::string name;    //!< The name of the parameter, as used in the function.
+    double start = 0.0;  //!< The first value of the parameter.
+    double stop = 0.0;   //!< The last value of the parameter, included if reached by a whole number of steps.
+    double step = 1.0;   //!< The increment between two values, with the sign of stop - start.
+
+    /**
+     * @brief The number of values of the range.
+     *
+     * @return The number of values, at least one.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief The value of the parameter at a position of the range.
+     *
+     * @param index The position, from 0 to size() - 1.
+     * @return The value, computed from the start rather than accumulated to avoid drifting.
+     */
+    [[nodiscard]] double value(std::size_t index) const;
+};
+
+/**
+ * @brief The starting points of a solve: the initial guess, or the two points of the interval.
+ *
+ */
+struct SweepSeed {
+    double first = 0.0;    //!< Initial guess, or first point of the interval.
+    double second = 0.0;   //!< Second point of the interval (unused by Newton and fixed-point iterations).
+    long evaluations = 0;  //!< Function evaluations spent placing the seed.
+};
+
+/**
+ * @brief Summary of the solve at one value of the parameter.
+ *
+ */
+struct SweepPoint {
+    double parameter = 0.0;                         //!< The value of the parameter.
+    SolverStatus status = SolverStatus::CONVERGED;  //!< How the solving process ended.
+    double root = 0.0;                              //!< The last estimate of the root.
+    double residual = 0.0;                          //!< The absolute value of the function at the root.
+    int iterations = 0;                             //!< Number of iterations performed.
+    long evaluations = 0;                           //!< Number of function evaluations, seed included.
+};
+
+/**
+ * @brief The problem solved by one chunk of a sweep, with functions parsed for that chunk only.
+ *
+ */
+struct SweepProblem {
+    std::shared_ptr<double> parameter;                   //!< The swept parameter, read by the parsed functions.
+    std::function<double(double)> function;              //!< The function at the current value of the parameter.
+    std::function<SweepPoint(const SweepSeed&)> solve;  //!< Solve at the current value of the parameter from a seed.
+};
+
+/**
+ * @brief Parse a range written as "name=start:stop:step", spaces allowed.
+ *
+ * @param text The range description.
+ * @param range The parsed range, left untouched if the description is invalid.
+ * @return true if the description is valid, false otherwise.
+ */
+bool parse_sweep_range(const std::string& text, SweepRange& range);
+
+/**
+ * @brief Parse a fixed parameter written as "name=value", spaces allowed.
+ *
+ * @param text The parameter description.
+ * @param name The name of the parameter.
+ * @param value The value of the parameter.
+ * @return true if the description is valid, false otherwise (name and value are then left untouched).
+ */
+bool parse_sweep_parameter(const std::string& text, std::string& name, double& value);
+
+/**
+ * @brief Place the seed of the next solve from the roots of the previous points.
+ *
+ * @param method The method solving the points.
+ * @param cold The seed given by the user, used when there is no previous root.
+ * @param roots The roots of the previous points, the most recent one last (only the last two are used).
+ * @param function The function at the value of the parameter being solved, used to bracket the root.
+ * @return The seed; for the bisection method, the cold seed if no sign change was found near the prediction.
+ */
+SweepSeed warm_start(Method method, const SweepSeed& cold, const std::vector<double>& roots,
+                     const std::function<double(double)>& function);
+
+/**
+ * @brief Solve every point of a range, continuing each chunk of the range from the roots of its previous points.
+ *
+ * @param range The range of values of the parameter.
+ * @param method The method solving the points.
+ * @param cold The seed given by the user.
+ * @param warm Seed every point after the first one of a chunk with warm_start, instead of the cold seed.
+ * @param jobs The number of threads, each solving a contiguous chunk of the range.
+ * @param make_problem Builds the problem of a chunk; called once on the thread of every chunk.
+ * @return The points, in the order of the range.
+ */
+std::vector<SweepPoint> run_sweep(const SweepRange& range, Method method, const SweepSeed& cold, bool warm,
+                                  std::size_t jobs, const std::function<SweepProblem()>& make_problem);
+
+/**
+ * @brief The header line of a CSV sweep.
+ *
+ * @param name The name of the parameter, used as the first column.
+ * @param separator The separator character of the columns.
+ * @return The header, ended by a newline.
+ */
+std::string sweep_csv_header(const std::string& name, char separator);
+
+/**
+ * @brief Append a point to a CSV sweep.
+ *
+ * @param out The text to append to.
+ * @param point The point to write, ended by a newline.
+ * @param separator The separator character of the columns.
+ */
+void append_sweep_csv(std::string& out, const SweepPoint& point, char separator);
+
+#endif  // SWEEP_HPP
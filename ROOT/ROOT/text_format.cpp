@@ -0,0 +1,58 @@
+/**
+ * @file text_format.cpp
+ * @brief Implementation of the number and string formatting helpers.
+ *
+ * @author Saransh-cpp
+ */
+#include "text_format.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+void append_number(std::string& out, double number) {
+    std::array<char, 32> digits{};
+    auto [end, ec] = std::to_chars(digits.data(), digits.data() + digits.size(), number);
+    out.append(digits.data(), end);
+}
+
+void append_json_number(std::string& out, double number) {
+    if (!std::isfinite(number)) {
+        out += "null";
+        return;
+    }
+    append_number(out, number);
+}
+
+void append_json_string(std::string& out, std::string_view text) {
+    out += '"';
+    for (char character : text) {
+        switch (character) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(character) < 0x20) {
+                    std::array<char, 8> escaped{};
+                    std::snprintf(escaped.data(), escaped.size(), "\\u%04x", static_cast<unsigned>(character));
+                    out += escaped.data();
+                } else {
+                    out += character;
+                }
+        }
+    }
+    out += '"';
+}
@@ -0,0 +1,38 @@
+/**
+ * @file text_format.hpp
+ * @brief Helpers formatting numbers and strings in the text outputs (CSV rows and JSON objects).
+ *
+ * @author Saransh-cpp
+ */
+#ifndef TEXT_FORMAT_HPP
+#define TEXT_FORMAT_HPP
+
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Append a number in its shortest form reading back as the same double.
+ *
+ * @param out The string to append to.
+ * @param number The number.
+ */
+void append_number(std::string& out, double number);
+
+/**
+ * @brief Append a number as a JSON value: its shortest exact form, or null if it is not finite (JSON has no
+ * representation of infinities and NaNs, which only appear in diverged problems).
+ *
+ * @param out The string to append to.
+ * @param number The number.
+ */
+void append_json_number(std::string& out, double number);
+
+/**
+ * @brief Append a JSON string literal, quotes included, escaping quotes, backslashes and control characters.
+ *
+ * @param out The string to append to.
+ * @param text The content of the string (bytes above 0x7F are copied unchanged, as parts of UTF-8 sequences).
+ */
+void append_json_string(std::string& out, std::string_view text);
+
+#endif  // TEXT_FORMAT_HPP
@@ -0,0 +1,49 @@
+#include "thread_pool.hpp"
+
+#include <utility>
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) {
+        threads = 1;
+    }
+    this->workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        this->workers.emplace_back([this] { this->work(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(this->mutex);
+        this->stopping = true;
+    }
+    this->ready.notify_all();
+    for (auto& worker : this->workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard lock(this->mutex);
+        this->tasks.push(std::move(task));
+    }
+    this->ready.notify_one();
+}
+
+void ThreadPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(this->mutex);
+            this->ready.wait(lock, [this] { return this->stopping || !this->tasks.empty(); });
+            // queued tasks are drained before stopping
+            if (this->tasks.empty()) {
+                return;
+            }
+            task = std::move(this->tasks.front());
+            this->tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Fixed-size pool of worker threads.
+ *
+ * The pool is created once and kept alive for the lifetime of a long-lived process (e.g. the solver daemon), so
+ * that serving a request never pays for spawning a thread.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool of worker threads executing submitted tasks in submission order.
+ *
+ */
+class ThreadPool {
+  public:
+    /**
+     * @brief Start the worker threads.
+     *
+     * @param threads The number of worker threads (at least one thread is always started).
+     */
+    explicit ThreadPool(std::size_t threads);
+    /**
+     * @brief Run the tasks which are still queued and join the worker threads.
+     *
+     */
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    /**
+     * @brief Queue a task, which is run by the first idle worker thread.
+     *
+     * @param task The task to run.
+     */
+    void submit(std::function<void()> task);
+    /** @brief Number of worker threads. */
+    std::size_t size() const { return this->workers.size(); }
+
+  private:
+    friend class ThreadPoolTester;            //!< Friend test fixture class for unit testing.
+    std::vector<std::thread> workers;         //!< The worker threads.
+    std::queue<std::function<void()>> tasks;  //!< Tasks waiting for a worker thread.
+    std::mutex mutex;                         //!< Guards tasks and stopping.
+    std::condition_variable ready;            //!< Signalled when a task is queued or the pool is stopping.
+    bool stopping = false;                    //!< Set by the destructor to let the workers return.
+    /**
+     * @brief Loop run by every worker thread, popping and running tasks until the pool is stopped.
+     *
+     */
+    void work();
+};
+
+#endif  // THREAD_POOL_HPP
@@ -2,12 +2,19 @@
 #define ROOT_WRITER_HPP
 
 #include <Eigen/Dense>
+#include <array>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <ranges>
+#include <sstream>
+#include <span>
 #include <string>
+#include <vector>
 
+#include "npy.hpp"
+#include "plot.hpp"
+#include "text_format.hpp"
 #include "writer_def.hpp"
 
 template <>
@@ -15,48 +22,111 @@ void PrinterGNUPlot<Eigen::Vector2d>::generate_gnuplot_script() const;
 
 template <>
 Writer<Eigen::MatrixX2d>::Writer(const Eigen::MatrixX2d& vals_to_write, WritingMethod write_method,
-                                 std::string filename, char separator, bool overwrite) {
-    this->values = vals_to_write;
-    this->method = write_method;
-    this->separator = separator;
+                                 std::string filename, char separator, bool overwrite)
+    : values(vals_to_write) {
+    this->sinks = {WriterSink{write_method, filename, separator}};
     this->overwrite = overwrite;
-    this->filename = filename;
 }
 
 template <>
-void Writer<Eigen::MatrixX2d>::write() {
+Writer<Eigen::MatrixX2d>::Writer(const Eigen::MatrixX2d& vals_to_write, WritingMethod write_method,
+                                 std::streambuf* stream, char separator)
+    : values(vals_to_write) {
+    this->sinks = {WriterSink{write_method, "", separator, stream}};
+    this->overwrite = false;
+}
+
+template <>
+Writer<Eigen::MatrixX2d>::Writer(const Eigen::MatrixX2d& vals_to_write, std::vector<WriterSink> sinks,
+                                 bool overwrite)
+    : values(vals_to_write) {
+    this->sinks = std::move(sinks);
+    this->overwrite = overwrite;
+}
+
+template <>
+void Writer<Eigen::MatrixX2d>::print_root() const {
     std::cout << "The found root is " << this->values.row(this->values.rows() - 1)(0) << std::endl;
+}
 
-    std::unique_ptr<PrinterBase<Eigen::Vector2d>> printer;
-    this->build_printer(printer);
+template <>
+void Writer<Eigen::MatrixX2d>::write_rows() {
+    std::vector<std::unique_ptr<PrinterBase<Eigen::Vector2d>>> printers(this->sinks.size());
+    for (size_t i = 0; i < this->sinks.size(); ++i) {
+        this->build_printer(this->sinks[i], printers[i]);
+    }
 
-    for (int i = 0; i < this->values.rows(); i++) {
+    // with a single printer there is nothing to share, so the printer takes the whole block
+    if (printers.size() == 1) {
+        printers.front()->write_block(this->values);
+    }
+    std::array<std::string, 2> text;
+    for (int i = 0; printers.size() > 1 && i < this->values.rows(); i++) {
         Eigen::Vector2d row = this->values.row(i);
-        printer->write_values(row);
+        for (int j = 0; j < 2; ++j) {
+            text[j].clear();
+            PrinterFile<Eigen::Vector2d>::append_double(text[j], row(j));
+        }
+        for (auto& printer : printers) {
+            printer->write_formatted(row, text);
+        }
     }
 
     // LLM
-    if (auto gp = dynamic_cast<PrinterGNUPlot<Eigen::Vector2d>*>(printer.get())) {
-        gp->generate_gnuplot_script();
-        std::cout << "Gnuplot script generated: " << this->filename << ".plt\n";
+    for (size_t i = 0; i < printers.size(); ++i) {
+        if (auto gp = dynamic_cast<PrinterGNUPlot<Eigen::Vector2d>*>(printers[i].get())) {
+            gp->flush();
+            gp->generate_gnuplot_script();
+            std::cout << "Gnuplot script generated: " << this->sinks[i].filename << ".plt\n";
+        }
     }
 }
 
+template <>
+void Writer<Eigen::MatrixX2d>::write() {
+    this->print_root();
+    this->write_rows();
+}
+
 template <typename T>
 template <typename V>
-void Writer<T>::build_printer(std::unique_ptr<PrinterBase<V>>& printer) {
-    switch (this->method) {
+void Writer<T>::build_printer(const WriterSink& sink, std::unique_ptr<PrinterBase<V>>& printer) {
+    if (sink.stream != nullptr) {
+        switch (sink.method) {
+            case WritingMethod::CSV:
+                printer = std::make_unique<PrinterCSV<V>>(sink.stream, sink.separator);
+                break;
+            case WritingMethod::DAT:
+                printer = std::make_unique<PrinterDAT<V>>(sink.stream);
+                break;
+            case WritingMethod::JSONL:
+                printer = std::make_unique<PrinterJSONL<V>>(sink.stream);
+                break;
+            default:
+                std::cerr << "\033[31mError: writing method not supported on a stream.\033[0m\n";
+                std::exit(EXIT_FAILURE);
+        }
+        return;
+    }
+
+    switch (sink.method) {
         case WritingMethod::CONSOLE:
             printer = std::make_unique<PrinterCLI<V>>();
             break;
         case WritingMethod::CSV:
-            printer = std::make_unique<PrinterCSV<V>>(this->filename, this->separator, this->overwrite);
+            printer = std::make_unique<PrinterCSV<V>>(sink.filename, sink.separator, this->overwrite);
             break;
         case WritingMethod::DAT:
-            printer = std::make_unique<PrinterDAT<V>>(this->filename, this->overwrite);
+            printer = std::make_unique<PrinterDAT<V>>(sink.filename, this->overwrite);
             break;
         case WritingMethod::GNUPLOT:
-            printer = std::make_unique<PrinterGNUPlot<V>>(this->filename, this->overwrite);
+            printer = std::make_unique<PrinterGNUPlot<V>>(sink.filename, this->overwrite);
+            break;
+        case WritingMethod::JSONL:
+            printer = std::make_unique<PrinterJSONL<V>>(sink.filename, this->overwrite);
+            break;
+        case WritingMethod::NPY:
+            printer = std::make_unique<PrinterNPY<V>>(sink.filename);
             break;
         default:
             std::cerr << "\033[31mError: Unknown writing method.\033[0m\n";
@@ -75,20 +145,55 @@ void PrinterCLI<Eigen::Vector2d>::write_values(const Eigen::Vector2d& value) {
 }
 
 template <typename V>
-PrinterFile<V>::PrinterFile(const std::string& fname, bool ow_mode) {
+PrinterFile<V>::PrinterFile(const std::string& fname, bool ow_mode, bool separate_appends) : file(nullptr) {
     this->filename = fname;
     this->append = ow_mode;
     if (this->append) {
-        file.open(this->filename, std::ios::trunc);
+        output_file.open(this->filename, std::ios::trunc);
     } else {
-        file.open(this->filename, std::ios::app);
-        file << std::endl;
+        output_file.open(this->filename, std::ios::app);
     }
 
-    if (!file.is_open()) {
+    if (!output_file.is_open()) {
         std::cerr << "\033[31mError: could not open file " << this->filename << " for writing.\033[0m\n";
         std::exit(EXIT_FAILURE);
     }
+    file.rdbuf(output_file.rdbuf());
+    if (!this->append && separate_appends) {
+        buffer += '\n';
+    }
+    buffer.reserve(buffer_capacity + 128);
+}
+
+// results written on a stream are always appended, and separated by whoever owns the stream
+template <typename V>
+PrinterFile<V>::PrinterFile(std::streambuf* stream) : append(false), file(stream) {
+    buffer.reserve(buffer_capacity + 128);
+}
+
+template <typename V>
+PrinterFile<V>::~PrinterFile() {
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+template <typename V>
+void PrinterFile<V>::write_buffer_if_full() {
+    if (buffer.size() >= buffer_capacity) {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
+
+template <typename V>
+void PrinterFile<V>::flush() {
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+    file.flush();
+}
+
+template <typename V>
+void PrinterFile<V>::append_double(std::string& out, double number) {
+    ::append_number(out, number);
 }
 
 template <typename V>
@@ -96,17 +201,156 @@ PrinterCSV<V>::PrinterCSV(const std::string& fname, char sep, bool ow_mode) : Pr
     this->separator = sep;
 }
 
+template <typename V>
+PrinterCSV<V>::PrinterCSV(std::streambuf* stream, char sep) : PrinterFile<V>(stream) {
+    this->separator = sep;
+}
+
 template <>
 void PrinterCSV<Eigen::Vector2d>::write_values(const Eigen::Vector2d& value) {
-    file << value(0) << this->separator << value(1) << std::endl;
+    append_double(buffer, value(0));
+    buffer += this->separator;
+    append_double(buffer, value(1));
+    buffer += '\n';
+    write_buffer_if_full();
+}
+
+template <>
+void PrinterCSV<Eigen::Vector2d>::write_block(const Block& block) {
+    for (Eigen::Index i = 0; i < block.rows(); ++i) {
+        append_double(buffer, block(i, 0));
+        buffer += this->separator;
+        append_double(buffer, block(i, 1));
+        buffer += '\n';
+        write_buffer_if_full();
+    }
+}
+
+template <>
+void PrinterCSV<Eigen::Vector2d>::write_formatted(const Eigen::Vector2d& /*value*/, std::span<const std::string> text) {
+    buffer += text[0];
+    buffer += this->separator;
+    buffer += text[1];
+    buffer += '\n';
+    write_buffer_if_full();
 }
 
 template <typename V>
 PrinterDAT<V>::PrinterDAT(const std::string& fname, bool ow_mode) : PrinterFile<V>(fname + ".dat", ow_mode) {}
 
+template <typename V>
+PrinterDAT<V>::PrinterDAT(std::streambuf* stream) : PrinterFile<V>(stream) {}
+
 template <>
 void PrinterDAT<Eigen::Vector2d>::write_values(const Eigen::Vector2d& value) {
-    file << value(0) << " " << value(1) << std::endl;
+    append_double(buffer, value(0));
+    buffer += ' ';
+    append_double(buffer, value(1));
+    buffer += '\n';
+    write_buffer_if_full();
+}
+
+template <>
+void PrinterDAT<Eigen::Vector2d>::write_block(const Block& block) {
+    for (Eigen::Index i = 0; i < block.rows(); ++i) {
+        append_double(buffer, block(i, 0));
+        buffer += ' ';
+        append_double(buffer, block(i, 1));
+        buffer += '\n';
+        write_buffer_if_full();
+    }
+}
+
+template <>
+void PrinterDAT<Eigen::Vector2d>::write_formatted(const Eigen::Vector2d& /*value*/, std::span<const std::string> text) {
+    buffer += text[0];
+    buffer += ' ';
+    buffer += text[1];
+    buffer += '\n';
+    write_buffer_if_full();
+}
+
+// JSON Lines hold one object per line, so appended results must not be separated by an empty line
+template <typename V>
+PrinterJSONL<V>::PrinterJSONL(const std::string& fname, bool ow_mode)
+    : PrinterFile<V>(fname + ".jsonl", ow_mode, false) {}
+
+template <typename V>
+PrinterJSONL<V>::PrinterJSONL(std::streambuf* stream) : PrinterFile<V>(stream) {}
+
+template <typename V>
+void PrinterJSONL<V>::append_number(std::string& out, double number) {
+    append_json_number(out, number);
+}
+
+template <>
+void PrinterJSONL<Eigen::Vector2d>::write_values(const Eigen::Vector2d& value) {
+    this->buffer += this->written_rows == 0 ? "{\"trajectory\":[[" : ",[";
+    append_number(this->buffer, value(0));
+    this->buffer += ',';
+    append_number(this->buffer, value(1));
+    this->buffer += ']';
+    this->write_buffer_if_full();
+    this->last_value = value;
+    ++this->written_rows;
+}
+
+template <>
+void PrinterJSONL<Eigen::Vector2d>::write_block(const Block& block) {
+    for (Eigen::Index i = 0; i < block.rows(); ++i) {
+        this->buffer += this->written_rows == 0 ? "{\"trajectory\":[[" : ",[";
+        append_number(this->buffer, block(i, 0));
+        this->buffer += ',';
+        append_number(this->buffer, block(i, 1));
+        this->buffer += ']';
+        this->write_buffer_if_full();
+        ++this->written_rows;
+    }
+    if (block.rows() > 0) {
+        this->last_value = block.row(block.rows() - 1).transpose();
+    }
+}
+
+template <>
+PrinterJSONL<Eigen::Vector2d>::~PrinterJSONL() {
+    if (this->written_rows == 0) {
+        return;
+    }
+    // the first row is the starting point, the following ones are the iterations
+    // (the buffer is written on the stream by the PrinterFile destructor)
+    this->buffer += "],\"root\":";
+    append_number(this->buffer, this->last_value(0));
+    this->buffer += ",\"f_root\":";
+    append_number(this->buffer, this->last_value(1));
+    this->buffer += ",\"iterations\":" + std::to_string(this->written_rows - 1) + "}\n";
+}
+
+template <typename V>
+PrinterNPY<V>::PrinterNPY(const std::string& fname) : PrinterFile<V>(fname + ".npy", true) {}
+
+template <>
+void PrinterNPY<Eigen::Vector2d>::write_values(const Eigen::Vector2d& value) {
+    this->data.push_back(value(0));
+    this->data.push_back(value(1));
+}
+
+template <>
+void PrinterNPY<Eigen::Vector2d>::write_block(const Block& block) {
+    // the rows of the .npy array follow one another, while Eigen stores the block column by column
+    const size_t start = this->data.size();
+    this->data.resize(start + 2 * static_cast<size_t>(block.rows()));
+    Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, 2, Eigen::RowMajor>>(this->data.data() + start, block.rows(), 2) =
+        block;
+}
+
+template <>
+PrinterNPY<Eigen::Vector2d>::~PrinterNPY() {
+    // the header goes through the buffer, the rows are written straight from the contiguous array
+    this->buffer = npy_header("<f8", {this->data.size() / 2, 2}, false);
+    this->file.write(this->buffer.data(), static_cast<std::streamsize>(this->buffer.size()));
+    this->buffer.clear();
+    this->file.write(reinterpret_cast<const char*>(this->data.data()),
+                     static_cast<std::streamsize>(this->data.size() * sizeof(double)));
 }
 
 template <typename V>
@@ -141,14 +385,40 @@ void PrinterGNUPlot<Eigen::Vector2d>::generate_gnuplot_script() const {
 
     script.close();
 
-    // Check if gnuplot exists before calling it
-    if (std::system("which gnuplot > /dev/null 2>&1") == 0) {
+    // Check if gnuplot exists before calling it (looked up once, without spawning a shell)
+    static const bool has_gnuplot = executable_on_path("gnuplot");
+    if (has_gnuplot) {
         std::system(("gnuplot " + plt_file).c_str());
         std::cout << "Gnuplot image generated: " << png_file << std::endl;
-    } else {
-        std::cerr << "\033[33mWarning: gnuplot not found. Script generated but PNG not created.\033[0m\n";
-        std::exit(EXIT_FAILURE);
+        return;
+    }
+
+    // otherwise the same plot is rendered natively from the .dat file, where every block of rows separated by an
+    // empty line (i.e. every appended result) is a path of its own, as for gnuplot
+    std::cerr << "\033[33mWarning: gnuplot not found. Script generated, PNG rendered natively.\033[0m\n";
+    ConvergencePlot plot;
+    std::ifstream data(this->filename);
+    std::vector<double> path;
+    auto add_path = [&plot, &path] {
+        if (!path.empty()) {
+            plot.add("", Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, 2, Eigen::RowMajor>>(
+                             path.data(), static_cast<Eigen::Index>(path.size() / 2), 2));
+            path.clear();
+        }
+    };
+    for (std::string line; std::getline(data, line);) {
+        std::istringstream row(line);
+        double x = 0, fx = 0;
+        if (row >> x >> fx) {
+            path.push_back(x);
+            path.push_back(fx);
+        } else {
+            add_path();
+        }
     }
+    add_path();
+    plot.write_png(png_file);
+    std::cout << "Image generated: " << png_file << std::endl;
 }
 
 #endif  // ROOT_WRITER_IMPL_HPP
@@ -7,8 +7,8 @@
  * The Writer class handles the writing outer process, meanwhile the printers effectively write on the output or
  * in the given file the results.
  * The Printer classes actually print a given value in the specified output, getting just one value from the
- * ones stored in Writer object. They can write on the output, on .csv or .dat files, or they can
- * write on a .dat file and then create a gnuplot.
+ * ones stored in Writer object. They can write on the output, on .csv, .dat, .jsonl or NumPy .npy files, or they
+ * can write on a .dat file and then create a gnuplot.
  *
  * @author andreasaporito
  *
@@ -19,15 +19,31 @@
 #include <Eigen/Dense>
 #include <fstream>
 #include <iostream>
+#include <span>
 #include <string>
+#include <vector>
 
-enum WritingMethod { CONSOLE, CSV, DAT, GNUPLOT };
+enum WritingMethod { CONSOLE, CSV, DAT, GNUPLOT, JSONL, NPY };
 
 template <typename V>
 class PrinterBase;
 
+/** @brief One output destination of a Writer: the writing method and where it writes */
+struct WriterSink {
+    WritingMethod method;              //!< Method to write with
+    std::string filename = "output";   //!< Name of the output file, without the extension
+    char separator = ',';              //!< Separator for .csv files
+    std::streambuf* stream = nullptr;  //!< External stream to write on instead of a file (e.g. standard output)
+};
+
 /**
  * @brief Class to store required arguments and handle the printing flow
+ *
+ * A Writer can write the same values on several sinks (e.g. a .csv file for the machine and the command line for
+ * the human) in a single pass over the values: every row is handed to each printer in turn, and the numbers of the
+ * row are formatted only once for all the file printers.
+ *
+ * The values are borrowed, not copied: they must outlive the Writer (and its copies).
  */
 template <typename T>
 class Writer {
@@ -35,39 +51,63 @@ class Writer {
     friend class WriterBaseTester;  //<! Friend test fixture class for unit testing.
     /** @brief Method to convert the generic Printer into a typed one for a specific output destination
      *
+     * @param sink The output destination to build the printer for
      * @param printer The original abstract printer
      */
     template <typename V>
-    void build_printer(std::unique_ptr<PrinterBase<V>>& printer);
+    void build_printer(const WriterSink& sink, std::unique_ptr<PrinterBase<V>>& printer);
 
   protected:
-    T values;              //!< Templated values to write to allow different usage of the class
-    WritingMethod method;  //!< Method to write with - defined thanks to @author Saransh-cpp config
-    char separator;        //!< Separator for .csv files
-    bool overwrite;        //!< Option to overwrite or append the output file
-    std::string filename;  //!< Name of the output file
+    Eigen::Ref<const T> values;     //!< Borrowed view of the values to write, which are owned by the caller
+    std::vector<WriterSink> sinks;  //!< Output destinations - defined thanks to @author Saransh-cpp config
+    bool overwrite;                 //!< Option to overwrite or append the output files
 
   public:
     /**
      * @brief Constructor for a Writer object
      *
-     * @param vals_to_write Values to be written, which will be stored in values argument
+     * @param vals_to_write Values to be written, which are viewed (not copied) by the values argument
      * @param write_method Method to be used, which will be stored in method argument
      * @param separator Separator for .csv extension files (optional)
      * @param overwrite Option to overwrite or append to the file (optional)
      */
     Writer(const T& vals_to_write, WritingMethod write_method, std::string filename = "output", char separator = ',',
            bool overwrite = true);
+    /**
+     * @brief Constructor for a Writer object writing on an external stream instead of a file
+     *
+     * @param vals_to_write Values to be written, which are viewed (not copied) by the values argument
+     * @param write_method Method to be used (CSV, DAT or JSONL), which will be stored in method argument
+     * @param stream Stream buffer to write on, which is not owned nor flushed by the Writer
+     * @param separator Separator for .csv formatted output (optional)
+     */
+    Writer(const T& vals_to_write, WritingMethod write_method, std::streambuf* stream, char separator = ',');
+    /**
+     * @brief Constructor for a Writer object writing on several sinks at once
+     *
+     * @param vals_to_write Values to be written, which are viewed (not copied) by the values argument
+     * @param sinks Output destinations, written in the given order for each row
+     * @param overwrite Option to overwrite or append to the files (optional)
+     */
+    Writer(const T& vals_to_write, std::vector<WriterSink> sinks, bool overwrite = true);
     /** @brief Method to run the printing loop and correctly initialize the Printer
      *
      */
     void write();
+    /** @brief Method to report the found root on the standard output, the first step of write() */
+    void print_root() const;
+    /** @brief Method to run the printing loop without reporting the root, e.g. from a background writer thread
+     *
+     */
+    void write_rows();
 };
 
 /** @brief Abstract Printer class */
 template <typename V>
 class PrinterBase {
   public:
+    /** @brief Non-owning view of consecutive values, one value per row */
+    using Block = Eigen::Ref<const Eigen::Matrix<double, Eigen::Dynamic, V::RowsAtCompileTime>>;
     /** @brief Default constructor for the PrinterBase class */
     PrinterBase() = default;
     /** @brief Virtual destructor for the PrinterBase class */
@@ -77,6 +117,25 @@ class PrinterBase {
      * @param value The given value to be written.
      */
     virtual void write_values(const V& value) = 0;
+    /** @brief Writes a given value whose elements were already formatted, once for every printer of a Writer
+     *
+     * Printers which do not write the shortest round-trip form of the numbers just write the value.
+     *
+     * @param value The given value to be written
+     * @param text The elements of the value in their shortest round-trip form
+     */
+    virtual void write_formatted(const V& value, std::span<const std::string> /*text*/) { write_values(value); }
+    /** @brief Writes a block of consecutive values, one per row of the block
+     *
+     * Printers which cannot do better than writing the rows one by one use this default implementation.
+     *
+     * @param block The given values to be written, viewed without copying them
+     */
+    virtual void write_block(const Block& block) {
+        for (Eigen::Index i = 0; i < block.rows(); ++i) {
+            write_values(block.row(i).transpose());
+        }
+    }
 };
 
 /** @brief The class to print out the values in the CLI */
@@ -92,22 +151,49 @@ class PrinterCLI : public PrinterBase<V> {
     void write_values(const V& value) override;
 };
 
-/** @brief Mother class for all the Printers which print in a file*/
+/** @brief Mother class for all the Printers which print in a file
+ *
+ * Rows are formatted into a reusable buffer, which is written on the file in blocks of buffer_capacity bytes
+ * (and when the printer is destroyed) instead of flushing the file at every row.
+ */
 template <typename V>
 class PrinterFile : public PrinterBase<V> {
   protected:
     std::string filename;  //!< The name of output file, without the extension
     bool append;  //!< Boolean which defines whether at a new Writing process the output file (if already existent), has
                   //!< to be overwritten or not
-    std::ofstream file;  //!< The actual file, saved in order not to access it at each printing iteration
+    std::ofstream output_file;  //!< The actual file, saved in order not to access it at each printing iteration
+    std::ostream file;          //!< The stream written on, bound either to output_file or to an external stream
+    std::string buffer;         //!< Formatted rows which have not been written on the stream yet
+    /** @brief Size (in bytes) above which the buffer is written on the stream */
+    static constexpr size_t buffer_capacity = 1 << 16;
+    /** @brief Writes the buffer on the stream once it has grown above buffer_capacity */
+    void write_buffer_if_full();
 
   public:
     /** @brief The constructor for PrinterFile class
      *
      * @param fname Name of the file to write on
      * @param ow_mode Option to overwrite or append to the file
+     * @param separate_appends Option to separate appended output from the existing one with an empty line
      */
-    PrinterFile(const std::string& fname, bool ow_mode);
+    PrinterFile(const std::string& fname, bool ow_mode, bool separate_appends = true);
+    /** @brief The constructor for PrinterFile class writing on an external stream (e.g. standard output)
+     *
+     * @param stream The stream buffer to write on, which is not owned by the printer
+     */
+    explicit PrinterFile(std::streambuf* stream);
+    /** @brief Writes the remaining buffered rows on the stream */
+    ~PrinterFile() override;
+    /** @brief Writes the buffered rows on the stream and flushes it, e.g. before another program reads the file */
+    void flush();
+    /**
+     * @brief Appends a number to a string in the shortest form which round-trips to the same double
+     *
+     * @param out The string to append to
+     * @param number The number to append
+     */
+    static void append_double(std::string& out, double number);
 };
 
 /** @brief Class to write on .dat the result - daughter of FilePrinter and Mother of GnuPlotPrinter*/
@@ -120,11 +206,27 @@ class PrinterDAT : public PrinterFile<V> {
      * @param ow_mode Option to overwrite or append the file
      */
     PrinterDAT(const std::string& fname, bool ow_mode);
+    /** @brief Constructor for the PrinterDAT class writing on an external stream
+     *
+     * @param stream The stream buffer to write on
+     */
+    explicit PrinterDAT(std::streambuf* stream);
     /** @brief Writes a given result into the .dat file
      *
      * @param value The value to write
      */
     void write_values(const V& value) override;
+    /** @brief Writes a given result, already formatted, into the .dat file
+     *
+     * @param value The value to write
+     * @param text The formatted elements of the value
+     */
+    void write_formatted(const V& value, std::span<const std::string> text) override;
+    /** @brief Writes every row of a given block of results, without going through a virtual call per row
+     *
+     * @param block The values to write
+     */
+    void write_block(const typename PrinterBase<V>::Block& block) override;
 };
 
 /** @brief Class to write on .csv the result*/
@@ -141,12 +243,103 @@ class PrinterCSV : public PrinterFile<V> {
      * @param ow_mode Option to overwrite or append the file
      */
     PrinterCSV(const std::string& fname, char sep, bool ow_mode);
+    /** @brief Constructor of the PrinterCSV class writing on an external stream
+     *
+     * @param stream The stream buffer to write on
+     * @param sep The separator to use
+     */
+    PrinterCSV(std::streambuf* stream, char sep);
     /**
      * @brief Writes a given result into the .csv file with the sotred separator
      *
      * @param value The value to write
      */
     void write_values(const V& value) override;
+    /**
+     * @brief Writes a given result, already formatted, into the .csv file with the stored separator
+     *
+     * @param value The value to write
+     * @param text The formatted elements of the value
+     */
+    void write_formatted(const V& value, std::span<const std::string> text) override;
+    /** @brief Writes every row of a given block of results, without going through a virtual call per row
+     *
+     * @param block The values to write
+     */
+    void write_block(const typename PrinterBase<V>::Block& block) override;
+};
+
+/** @brief Class to write on .jsonl the result - one JSON object per written result */
+template <typename V>
+class PrinterJSONL : public PrinterFile<V> {
+  private:
+    V last_value;          //!< The latest written value, reported as the root when the object is closed
+    int written_rows = 0;  //!< Number of values written so far
+
+  public:
+    /** @brief Constructor of the PrinterJSONL class
+     *
+     * @param fname The file to write on
+     * @param ow_mode Option to overwrite or append the file
+     */
+    PrinterJSONL(const std::string& fname, bool ow_mode);
+    /** @brief Constructor of the PrinterJSONL class writing on an external stream
+     *
+     * @param stream The stream buffer to write on
+     */
+    explicit PrinterJSONL(std::streambuf* stream);
+    /** @brief Closes the JSON object of the written result (root, f(root) and number of iterations) */
+    ~PrinterJSONL() override;
+    /**
+     * @brief Appends a given value to the trajectory of the JSON object being written
+     *
+     * @param value The value to write
+     */
+    void write_values(const V& value) override;
+    /** @brief Writes every row of a given block of results, without going through a virtual call per row
+     *
+     * @param block The values to write
+     */
+    void write_block(const typename PrinterBase<V>::Block& block) override;
+    /**
+     * @brief Appends a number to a string in the shortest form which round-trips (null if not finite)
+     *
+     * @param out The string to append to
+     * @param number The number to append
+     */
+    static void append_number(std::string& out, double number);
+};
+
+/** @brief Class to write on .npy the result - a NumPy array of shape (rows, 2) of little-endian doubles
+ *
+ * The rows are gathered in memory and written, right after the .npy header, in a single block when the printer is
+ * destroyed, so that numpy.load only has to copy the data. The file is always overwritten, since a .npy file holds
+ * exactly one array.
+ */
+template <typename V>
+class PrinterNPY : public PrinterFile<V> {
+  private:
+    std::vector<double> data;  //!< The written values, row by row
+
+  public:
+    /** @brief Constructor of the PrinterNPY class
+     *
+     * @param fname The file to write on
+     */
+    explicit PrinterNPY(const std::string& fname);
+    /** @brief Writes the .npy header and the gathered rows into the file */
+    ~PrinterNPY() override;
+    /**
+     * @brief Appends a given value to the array being written
+     *
+     * @param value The value to write
+     */
+    void write_values(const V& value) override;
+    /** @brief Appends every row of a given block of results to the array being written
+     *
+     * @param block The values to write
+     */
+    void write_block(const typename PrinterBase<V>::Block& block) override;
 };
 
 /** @brief Class Daughter of PrinterDAT to write on .dat (inherited) and produce a gnu plot for the results*/
@@ -1,13 +1,22 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <libROOT/solver.hpp>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include "shm_ring.hpp"
 
 // TO DO:
 // Right now the tests are just checking whether the root is near its computed respective within a given tolerance,
@@ -30,12 +39,35 @@ static std::string exec_command(const std::string& cmd) {
     return result;
 }
 
+// Directory for the files written by one test, named after the test so that tests can run in parallel; it is removed
+// with every file in it at the end of the test
+class TestDirectory {
+  public:
+    TestDirectory() {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        this->directory = std::filesystem::temp_directory_path() /
+                          ("root_" + std::string(info->test_suite_name()) + "_" + info->name());
+        std::filesystem::create_directories(this->directory);
+    }
+    ~TestDirectory() { std::filesystem::remove_all(this->directory); }
+    TestDirectory(const TestDirectory&) = delete;
+    TestDirectory& operator=(const TestDirectory&) = delete;
+
+    // path of a file in the directory
+    std::string path(const std::string& name) const { return (this->directory / name).string(); }
+
+  private:
+    std::filesystem::path directory;
+};
+
 TEST(NewtonMethodWithReaderCSVWriterCSV, QuadraticConvergesToMinus2) {
     std::string filename = "../../../../ROOT/tests/test_data/config.csv";
     std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
 
     std::string cmd = exe +
-                      " --wcsv result"
+                      " --wcsv " + result +
                       " csv --file " +
                       filename;
 
@@ -44,16 +76,17 @@ TEST(NewtonMethodWithReaderCSVWriterCSV, QuadraticConvergesToMinus2) {
     ASSERT_FALSE(output.empty());
 
     // check CSV file created
-    EXPECT_TRUE(std::filesystem::exists("result.csv"));
-    std::filesystem::remove("result.csv");
+    EXPECT_TRUE(std::filesystem::exists(result + ".csv"));
 }
 
 TEST(NewtonMethodWithReaderCSVWriterDAT, QuadraticConvergesToMinus2) {
     std::string filename = "../../../../ROOT/tests/test_data/config.csv";
     std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
 
     std::string cmd = exe +
-                      " --wdat result"
+                      " --wdat " + result +
                       " csv --file " +
                       filename;
 
@@ -62,16 +95,17 @@ TEST(NewtonMethodWithReaderCSVWriterDAT, QuadraticConvergesToMinus2) {
     ASSERT_FALSE(output.empty());
 
     // check DAT file created
-    EXPECT_TRUE(std::filesystem::exists("result.dat"));
-    std::filesystem::remove("result.dat");
+    EXPECT_TRUE(std::filesystem::exists(result + ".dat"));
 }
 
 TEST(NewtonMethodWithReaderCSVWriterGNUPlot, QuadraticConvergesToMinus2) {
     std::string filename = "../../../../ROOT/tests/test_data/config.csv";
     std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
 
     std::string cmd = exe +
-                      " --wdat result"
+                      " --wdat " + result +
                       " --wgnuplot"
                       " csv --file " +
                       filename;
@@ -81,22 +115,21 @@ TEST(NewtonMethodWithReaderCSVWriterGNUPlot, QuadraticConvergesToMinus2) {
     ASSERT_FALSE(output.empty());
 
     // check DAT file created
-    EXPECT_TRUE(std::filesystem::exists("result.dat"));
-    std::filesystem::remove("result.dat");
+    EXPECT_TRUE(std::filesystem::exists(result + ".dat"));
 
-    EXPECT_TRUE(std::filesystem::exists("result.plt"));
-    std::filesystem::remove("result.plt");
+    EXPECT_TRUE(std::filesystem::exists(result + ".plt"));
 
-    EXPECT_TRUE(std::filesystem::exists("result.png"));
-    std::filesystem::remove("result.png");
+    EXPECT_TRUE(std::filesystem::exists(result + ".png"));
 }
 
 TEST(NewtonMethodWithReaderDATWriterCSV, QuadraticConvergesToMinus2) {
     std::string filename = "../../../../ROOT/tests/test_data/config.dat";
     std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
 
     std::string cmd = exe +
-                      " --wcsv result"
+                      " --wcsv " + result +
                       " dat --file " +
                       filename;
 
@@ -105,16 +138,17 @@ TEST(NewtonMethodWithReaderDATWriterCSV, QuadraticConvergesToMinus2) {
     ASSERT_FALSE(output.empty());
 
     // check CSV file created
-    EXPECT_TRUE(std::filesystem::exists("result.csv"));
-    std::filesystem::remove("result.csv");
+    EXPECT_TRUE(std::filesystem::exists(result + ".csv"));
 }
 
 TEST(NewtonMethodWithReaderDATWriterDAT, QuadraticConvergesToMinus2) {
     std::string filename = "../../../../ROOT/tests/test_data/config.dat";
     std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
 
     std::string cmd = exe +
-                      " --wdat result"
+                      " --wdat " + result +
                       " dat --file " +
                       filename;
 
@@ -123,16 +157,17 @@ TEST(NewtonMethodWithReaderDATWriterDAT, QuadraticConvergesToMinus2) {
     ASSERT_FALSE(output.empty());
 
     // check DAT file created
-    EXPECT_TRUE(std::filesystem::exists("result.dat"));
-    std::filesystem::remove("result.dat");
+    EXPECT_TRUE(std::filesystem::exists(result + ".dat"));
 }
 
 TEST(NewtonMethodWithReaderDATWriterGNUPlot, QuadraticConvergesToMinus2) {
     std::string filename = "../../../../ROOT/tests/test_data/config.dat";
     std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
 
     std::string cmd = exe +
-                      " --wdat result"
+                      " --wdat " + result +
                       " --wgnuplot"
                       " dat --file " +
                       filename;
@@ -142,14 +177,11 @@ TEST(NewtonMethodWithReaderDATWriterGNUPlot, QuadraticConvergesToMinus2) {
     ASSERT_FALSE(output.empty());
 
     // check DAT file created
-    EXPECT_TRUE(std::filesystem::exists("result.dat"));
-    std::filesystem::remove("result.dat");
+    EXPECT_TRUE(std::filesystem::exists(result + ".dat"));
 
-    EXPECT_TRUE(std::filesystem::exists("result.plt"));
-    std::filesystem::remove("result.plt");
+    EXPECT_TRUE(std::filesystem::exists(result + ".plt"));
 
-    EXPECT_TRUE(std::filesystem::exists("result.png"));
-    std::filesystem::remove("result.png");
+    EXPECT_TRUE(std::filesystem::exists(result + ".png"));
 }
 
 TEST(NewtonMethodWithReaderCSVWriterCLI, QuadraticConvergesToMinus2) {
@@ -613,3 +645,624 @@ TEST(BisectionMethodReaderCLIWriterCLI, QuadraticConvergesToEdge) {
     // Validate the root value
     EXPECT_NEAR(root, 1.0, 1e-4);
 }
+
+TEST(MultiProblemReaderDATWriterCLI, SolvesEverySection) {
+    std::string filename = "../../../../ROOT/tests/test_data/config_sections.dat";
+    std::string exe = "../../ROOT/root_cli";
+
+    std::string cmd = exe +
+                      " --wcli dat"
+                      " --file " +
+                      filename;
+
+    std::string output = exec_command(cmd);
+
+    ASSERT_FALSE(output.empty());
+
+    // one root line per section, in file order
+    const std::string token = "The found root is ";
+    std::vector<double> roots;
+    for (auto pos = output.find(token); pos != std::string::npos; pos = output.find(token, pos)) {
+        pos += token.size();
+        std::stringstream ss(output.substr(pos));
+        double root = 0.0;
+        ss >> root;
+        roots.push_back(root);
+    }
+
+    ASSERT_EQ(roots.size(), 2) << "Output was:\n" << output;
+    EXPECT_NEAR(roots[0], -2.0, 1e-4);
+    EXPECT_NEAR(roots[1], 2.0, 1e-4);
+    EXPECT_NE(output.find("Problem [chords-cubic]"), std::string::npos);
+}
+
+TEST(MultiProblemReaderDATWriterCSV, BackgroundWriterMatchesSynchronousWriter) {
+    std::string filename = "../../../../ROOT/tests/test_data/config_sections.dat";
+    std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string background = directory.path("background");
+    std::string synchronous = directory.path("synchronous");
+
+    // the files are written by the background writer thread by default, and by the solving thread with --wqueue 0
+    exec_command(exe + " --wcsv " + background + " --wqueue 1 dat --file " + filename);
+    exec_command(exe + " --wcsv " + synchronous + " --wqueue 0 dat --file " + filename);
+
+    ASSERT_TRUE(std::filesystem::exists(background + ".csv"));
+    ASSERT_TRUE(std::filesystem::exists(synchronous + ".csv"));
+    std::ifstream background_csv(background + ".csv");
+    std::ifstream synchronous_csv(synchronous + ".csv");
+    std::string background_content((std::istreambuf_iterator<char>(background_csv)), std::istreambuf_iterator<char>());
+    std::string synchronous_content((std::istreambuf_iterator<char>(synchronous_csv)),
+                                    std::istreambuf_iterator<char>());
+
+    EXPECT_FALSE(background_content.empty());
+    EXPECT_EQ(background_content, synchronous_content);
+}
+
+TEST(MultiProblemReaderDATWriterCSVDATCLI, WritesEverySinkInOneRun) {
+    std::string filename = "../../../../ROOT/tests/test_data/config_sections.dat";
+    std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
+
+    std::string cmd = exe +
+                      " --wcli --wcsv " + result + " --wdat " + result +
+                      " dat --file " +
+                      filename;
+
+    std::string output = exec_command(cmd);
+
+    // the command line gets the iterations, the files get the same rows
+    EXPECT_NE(output.find("Here are the iterations of the method"), std::string::npos) << output;
+    ASSERT_TRUE(std::filesystem::exists(result + ".csv"));
+    ASSERT_TRUE(std::filesystem::exists(result + ".dat"));
+    std::ifstream csv(result + ".csv");
+    std::ifstream dat(result + ".dat");
+    std::string csv_content((std::istreambuf_iterator<char>(csv)), std::istreambuf_iterator<char>());
+    std::string dat_content((std::istreambuf_iterator<char>(dat)), std::istreambuf_iterator<char>());
+
+    EXPECT_FALSE(csv_content.empty());
+    std::replace(csv_content.begin(), csv_content.end(), ',', ' ');
+    EXPECT_EQ(csv_content, dat_content);
+}
+
+TEST(MultiProblemReaderDATWriterPlot, OnePlotForAllProblems) {
+    std::string filename = "../../../../ROOT/tests/test_data/config_sections.dat";
+    std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
+
+    std::string cmd = exe +
+                      " --wsvg " + result + " --wpng " + result +
+                      " dat --file " +
+                      filename;
+
+    std::string output = exec_command(cmd);
+
+    ASSERT_FALSE(output.empty());
+
+    // one overlay of both iteration paths, in each format
+    ASSERT_TRUE(std::filesystem::exists(result + ".svg"));
+    ASSERT_TRUE(std::filesystem::exists(result + ".png"));
+    std::ifstream svg_file(result + ".svg");
+    std::string svg((std::istreambuf_iterator<char>(svg_file)), std::istreambuf_iterator<char>());
+    std::ifstream png_file(result + ".png", std::ios::binary);
+    std::string png((std::istreambuf_iterator<char>(png_file)), std::istreambuf_iterator<char>());
+
+    size_t paths = 0;
+    for (auto pos = svg.find("<polyline"); pos != std::string::npos; pos = svg.find("<polyline", pos + 1)) {
+        ++paths;
+    }
+    EXPECT_EQ(paths, 2);
+    EXPECT_NE(svg.find(">newton-quadratic</text>"), std::string::npos);
+    EXPECT_NE(svg.find(">chords-cubic</text>"), std::string::npos);
+    EXPECT_EQ(png.substr(0, 8), std::string("\x89PNG\r\n\x1a\n", 8));
+}
+
+TEST(MultiProblemReaderDATWriterArchive, AppendsAndMergesIndexedRecords) {
+    std::string dat_file = "../../../../ROOT/tests/test_data/config_sections.dat";
+    std::string jsonl_file = "../../../../ROOT/tests/test_data/config.jsonl";
+    std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
+    std::string shard = directory.path("shard");
+
+    // a second run appends its records, with their trajectories, to the records of the first one
+    exec_command(exe + " --warchive " + result + " dat --file " + dat_file);
+    exec_command(exe + " --warchive " + result + " --ofmode a --archive-trajectories jsonl --file " + jsonl_file);
+    exec_command(exe + " --warchive " + shard + " dat --file " + dat_file);
+    ASSERT_TRUE(std::filesystem::exists(result + ".rra"));
+    ASSERT_TRUE(std::filesystem::exists(shard + ".rra"));
+
+    std::string count = exec_command(exe + " archive --file " + result + ".rra");
+    EXPECT_NE(count.find("4 records"), std::string::npos);
+    std::string records = exec_command(exe + " archive --file " + result + ".rra --record 1 3");
+    EXPECT_NE(records.find(R"({"id":1,"name":"chords-cubic","status":"converged",)"), std::string::npos);
+    EXPECT_NE(records.find(R"("trajectory_rows":0})"), std::string::npos);
+    EXPECT_NE(records.find(R"({"id":1,"name":"cubic","status":"converged",)"), std::string::npos);
+    EXPECT_EQ(records.find(R"("trajectory_rows":0})", records.find('\n')), std::string::npos);
+
+    // merging copies the records of the shard after the ones already in the archive
+    exec_command(exe + " archive --file " + result + ".rra --merge " + shard + ".rra");
+    std::string merged = exec_command(exe + " archive --file " + result + ".rra --record 5");
+    EXPECT_NE(merged.find(R"({"id":1,"name":"chords-cubic")"), std::string::npos);
+}
+
+TEST(BatchShards, OneSummaryRowPerProblem) {
+    std::string filename = "../../../../ROOT/tests/test_data/config.jsonl";
+    std::string exe = "../../ROOT/root_cli";
+
+    // the shards split the batch between them, each one solving its problems on two threads
+    std::vector<std::string> rows;
+    for (const std::string shard : {"0/2", "1/2"}) {
+        std::string summary = exec_command(exe + " batch --jobs 2 --shard " + shard + " --file " + filename);
+        std::istringstream lines(summary);
+        std::string line;
+        std::getline(lines, line);
+        EXPECT_EQ(line, "id,name,status,root,residual,iterations,evaluations,seconds");
+        while (std::getline(lines, line)) {
+            rows.push_back(line);
+        }
+    }
+
+    ASSERT_EQ(rows.size(), 2);
+    EXPECT_EQ(rows[0].rfind("0,quadratic,converged,", 0), 0);
+    EXPECT_EQ(rows[1].rfind("1,cubic,converged,", 0), 0);
+    for (const auto& row : rows) {
+        std::vector<std::string> columns;
+        std::istringstream fields(row);
+        for (std::string field; std::getline(fields, field, ',');) {
+            columns.push_back(field);
+        }
+        ASSERT_EQ(columns.size(), 8) << row;
+        EXPECT_LT(std::stod(columns[4]), 1e-4) << row;
+        EXPECT_GT(std::stoi(columns[6]), std::stoi(columns[5])) << row;
+    }
+}
+
+TEST(ParameterSweep, WarmStartsCutIterations) {
+    std::string exe = "../../ROOT/root_cli";
+    std::string cmd = exe + " sweep -f \"a*x^2 - p\" --set a=1 --derivative \"2*a*x\" --range p=1:50:0.5 --x0 1";
+
+    // sum the iterations of every point, checking that each one converged to sqrt(p)
+    auto total_iterations = [](const std::string& summary) {
+        std::istringstream lines(summary);
+        std::string line;
+        std::getline(lines, line);
+        EXPECT_EQ(line, "p,status,root,residual,iterations,evaluations");
+        int iterations = 0;
+        int rows = 0;
+        while (std::getline(lines, line)) {
+            std::vector<std::string> columns;
+            std::istringstream fields(line);
+            for (std::string field; std::getline(fields, field, ',');) {
+                columns.push_back(field);
+            }
+            EXPECT_EQ(columns.size(), 6) << line;
+            EXPECT_EQ(columns[1], "converged") << line;
+            EXPECT_NEAR(std::stod(columns[2]), std::sqrt(std::stod(columns[0])), 1e-4) << line;
+            iterations += std::stoi(columns[4]);
+            ++rows;
+        }
+        EXPECT_EQ(rows, 99);
+        return iterations;
+    };
+
+    int warm = total_iterations(exec_command(cmd));
+    int parallel = total_iterations(exec_command(cmd + " --jobs 3"));
+    int cold = total_iterations(exec_command(cmd + " --no-warm-start"));
+    EXPECT_LT(2 * warm, cold);
+    EXPECT_LT(2 * parallel, cold);
+}
+
+TEST(Portfolio, FirstConvergedMethodWins) {
+    std::string exe = "../../ROOT/root_cli";
+    std::string cmd = exe +
+                      " portfolio -f \"x^3 - 2x - 5\" --derivative \"3x^2 - 2\""
+                      " --g-function \"x - 0.05*x^3 + 0.1*x + 0.25\" --x0 0 --x1 3 -t 1e-8 -n 10000";
+    std::string summary = exec_command(cmd);
+
+    std::istringstream lines(summary);
+    std::string line;
+    std::getline(lines, line);
+    EXPECT_EQ(line, "method,status,root,residual,iterations,evaluations,seconds,winner");
+    int rows = 0;
+    int winners = 0;
+    while (std::getline(lines, line)) {
+        std::vector<std::string> columns;
+        std::istringstream fields(line);
+        for (std::string field; std::getline(fields, field, ',');) {
+            columns.push_back(field);
+        }
+        ASSERT_EQ(columns.size(), 8) << line;
+        ++rows;
+        if (columns[7] == "true") {
+            ++winners;
+            EXPECT_EQ(columns[1], "converged") << line;
+            EXPECT_NEAR(std::stod(columns[2]), 2.0945514815, 1e-6) << line;
+        } else {
+            // the losers either converged too late to win or were stopped
+            EXPECT_TRUE(columns[1] == "cancelled" || columns[1] == "converged") << line;
+        }
+    }
+    EXPECT_EQ(rows, 4);
+    EXPECT_EQ(winners, 1);
+}
+
+TEST(BatchLimits, EvaluationBudgetEndsEverySolve) {
+    std::string filename = "../../../../ROOT/tests/test_data/config.jsonl";
+    std::string exe = "../../ROOT/root_cli";
+
+    std::string summary = exec_command(exe + " --max-evaluations 4 batch --file " + filename);
+    std::istringstream lines(summary);
+    std::string line;
+    std::getline(lines, line);
+    int rows = 0;
+    while (std::getline(lines, line)) {
+        std::vector<std::string> columns;
+        std::istringstream fields(line);
+        for (std::string field; std::getline(fields, field, ',');) {
+            columns.push_back(field);
+        }
+        ASSERT_EQ(columns.size(), 8) << line;
+        EXPECT_EQ(columns[2], "budget_exhausted") << line;
+        // the budget is checked before every iteration, one step may still overshoot it
+        EXPECT_GE(std::stoi(columns[6]), 4) << line;
+        EXPECT_LE(std::stoi(columns[6]), 6) << line;
+        ++rows;
+    }
+    EXPECT_EQ(rows, 2);
+
+    // a generous time limit is never reached
+    summary = exec_command(exe + " --time-limit 10 batch --file " + filename);
+    EXPECT_EQ(summary.find("timed_out"), std::string::npos);
+    EXPECT_NE(summary.find("converged"), std::string::npos);
+}
+
+TEST(MultiProblemReaderJSONLWriterJSONL, OneResultObjectPerProblem) {
+    std::string filename = "../../../../ROOT/tests/test_data/config.jsonl";
+    std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
+
+    std::string cmd = exe +
+                      " --wjsonl " + result +
+                      " jsonl --file " +
+                      filename;
+
+    std::string output = exec_command(cmd);
+
+    ASSERT_FALSE(output.empty());
+
+    // check JSONL file created, with one result object per line
+    ASSERT_TRUE(std::filesystem::exists(result + ".jsonl"));
+    std::ifstream jsonl(result + ".jsonl");
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(jsonl, line);) {
+        lines.push_back(line);
+    }
+
+    ASSERT_EQ(lines.size(), 2);
+    std::vector<double> roots;
+    const std::string token = "\"root\":";
+    for (const auto& line : lines) {
+        EXPECT_EQ(line.front(), '{');
+        EXPECT_EQ(line.back(), '}');
+        auto pos = line.find(token);
+        ASSERT_NE(pos, std::string::npos) << line;
+        roots.push_back(std::stod(line.substr(pos + token.size())));
+    }
+    EXPECT_NEAR(roots[0], -2.0, 1e-4);
+    EXPECT_NEAR(roots[1], 2.0, 1e-4);
+}
+
+TEST(MultiProblemReaderJSONLWriterNPY, OneArchiveForAllProblems) {
+    std::string filename = "../../../../ROOT/tests/test_data/config.jsonl";
+    std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
+
+    std::string cmd = exe +
+                      " --wnpy " + result +
+                      " jsonl --file " +
+                      filename;
+
+    std::string output = exec_command(cmd);
+
+    ASSERT_FALSE(output.empty());
+
+    // check the .npz archive is created, with the trajectories and the summary arrays as members
+    ASSERT_TRUE(std::filesystem::exists(result + ".npz"));
+    std::ifstream npz(result + ".npz", std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(npz)), std::istreambuf_iterator<char>());
+
+    EXPECT_EQ(bytes.substr(0, 4), std::string("PK\x03\x04", 4));
+    for (const std::string member : {"x_quadratic.npy", "f_quadratic.npy", "x_cubic.npy", "f_cubic.npy",
+                                     "f_root.npy", "iterations.npy"}) {
+        EXPECT_NE(bytes.find(member), std::string::npos) << member;
+    }
+
+    // the root member (right after the zero extra field length of its local header) is stored uncompressed
+    const std::string member = std::string("\0\0root.npy", 10);
+    auto pos = bytes.find(member);
+    ASSERT_NE(pos, std::string::npos);
+    pos += member.size();
+    EXPECT_EQ(bytes.substr(pos, 6), "\x93NUMPY");
+    size_t header_size = static_cast<unsigned char>(bytes[pos + 8]) + (static_cast<unsigned char>(bytes[pos + 9]) << 8);
+    EXPECT_NE(bytes.find("'shape': (2,)", pos), std::string::npos);
+    std::array<double, 2> roots{};
+    std::memcpy(roots.data(), bytes.data() + pos + 10 + header_size, sizeof(roots));
+    EXPECT_NEAR(roots[0], -2.0, 1e-4);
+    EXPECT_NEAR(roots[1], 2.0, 1e-4);
+}
+
+TEST(MultiProblemReaderJSONLWriterNPY, ReadsFileFromPipe) {
+    std::string filename = "../../../../ROOT/tests/test_data/config.jsonl";
+    std::string exe = "../../ROOT/root_cli";
+    TestDirectory directory;
+    std::string result = directory.path("result");
+
+    // a pipe is read once, and enough of it is read ahead to pick an archive for several problems
+    std::string cmd = "cat " + filename + " | " + exe + " --wnpy " + result + " jsonl --file /dev/stdin";
+
+    std::string output = exec_command(cmd);
+
+    std::vector<double> roots;
+    const std::string token = "The found root is ";
+    for (auto pos = output.find(token); pos != std::string::npos; pos = output.find(token, pos + 1)) {
+        roots.push_back(std::stod(output.substr(pos + token.size())));
+    }
+    ASSERT_EQ(roots.size(), 2) << "Output was:\n" << output;
+    EXPECT_NEAR(roots[0], -2.0, 1e-4);
+    EXPECT_NEAR(roots[1], 2.0, 1e-4);
+    EXPECT_TRUE(std::filesystem::exists(result + ".npz"));
+    EXPECT_FALSE(std::filesystem::exists(result + ".npy"));
+}
+
+TEST(MultiProblemReaderPipeWriterPipe, StreamsOneResultPerProblem) {
+    std::string filename = "../../../../ROOT/tests/test_data/config.jsonl";
+    std::string exe = "../../ROOT/root_cli";
+
+    // only the results are written on standard output, diagnostics go to standard error
+    std::string cmd = "cat " + filename + " | " + exe + " pipe --format jsonl --flush-every 1 2>/dev/null";
+
+    std::string output = exec_command(cmd);
+
+    std::istringstream stream(output);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(stream, line);) {
+        lines.push_back(line);
+    }
+
+    ASSERT_EQ(lines.size(), 2) << output;
+    std::vector<double> roots;
+    const std::string token = "\"root\":";
+    for (const auto& line : lines) {
+        EXPECT_EQ(line.front(), '{');
+        EXPECT_EQ(line.back(), '}');
+        auto pos = line.find(token);
+        ASSERT_NE(pos, std::string::npos) << line;
+        roots.push_back(std::stod(line.substr(pos + token.size())));
+    }
+    EXPECT_NEAR(roots[0], -2.0, 1e-4);
+    EXPECT_NEAR(roots[1], 2.0, 1e-4);
+}
+
+TEST(MultiProblemReaderPipeWriterPipe, StreamsDatSectionsWithGlobalDefaults) {
+    std::string filename = "../../../../ROOT/tests/test_data/config_sections.dat";
+    std::string exe = "../../ROOT/root_cli";
+
+    // the sections inherit the method-less global defaults, as when the file is read with the dat subcommand
+    std::string cmd = "cat " + filename + " | " + exe + " pipe --format dat 2>/dev/null; echo \"exit $?\"";
+
+    std::string output = exec_command(cmd);
+
+    std::istringstream stream(output);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(stream, line);) {
+        lines.push_back(line);
+    }
+
+    ASSERT_EQ(lines.size(), 3) << output;
+    const std::string token = "\"root\":";
+    for (size_t i : {0, 1}) {
+        auto pos = lines[i].find(token);
+        ASSERT_NE(pos, std::string::npos) << lines[i];
+        EXPECT_NEAR(std::stod(lines[i].substr(pos + token.size())), i == 0 ? -2.0 : 2.0, 1e-4);
+    }
+    EXPECT_EQ(lines[2], "exit 0");
+}
+
+TEST(MultiProblemReaderPipeWriterPipe, GoesOnAfterMalformedProblem) {
+    std::string exe = "../../ROOT/root_cli";
+
+    // the malformed problem in the middle of the stream is answered with an error record, not with an exit
+    std::string cmd = "printf '%s\\n' "
+                      "'{\"method\": \"newton\", \"function\": \"x^2-4\", \"initial\": -1, \"derivative\": \"2*x\"}' "
+                      "'{\"method\": \"bogus\", \"function\": \"x^2-4\"}' "
+                      "'{\"method\": \"chords\", \"function\": \"x^3-8\", \"x0\": 1, \"x1\": 3}' | " +
+                      exe + " pipe --format jsonl 2>/dev/null; echo \"exit $?\"";
+
+    std::string output = exec_command(cmd);
+
+    std::istringstream stream(output);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(stream, line);) {
+        lines.push_back(line);
+    }
+
+    ASSERT_EQ(lines.size(), 4) << output;
+    const std::string token = "\"root\":";
+    for (size_t i : {0, 2}) {
+        auto pos = lines[i].find(token);
+        ASSERT_NE(pos, std::string::npos) << lines[i];
+        EXPECT_NEAR(std::stod(lines[i].substr(pos + token.size())), i == 0 ? -2.0 : 2.0, 1e-4);
+    }
+    EXPECT_EQ(lines[1], "{\"error\":\"line 2: unknown method: bogus\"}");
+    EXPECT_EQ(lines[3], "exit 0");
+}
+
+TEST(MultiProblemDaemonClient, AnswersFromWarmProcess) {
+    std::string filename = "../../../../ROOT/tests/test_data/config.jsonl";
+    std::string exe = "../../ROOT/root_cli";
+    std::string socket_path = "test_cli_daemon.sock";
+
+    std::filesystem::remove(socket_path);
+    std::system((exe + " daemon --socket " + socket_path + " --threads 2 2>/dev/null &").c_str());
+    for (int attempt = 0; attempt < 100 && !std::filesystem::exists(socket_path); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    ASSERT_TRUE(std::filesystem::exists(socket_path));
+
+    // every request is answered in order, malformed ones with an error object
+    std::string cmd = "(cat " + filename + "; echo '{\"method\": \"unknown\"}') | " + exe + " client --socket " +
+                      socket_path + " --stop";
+    std::string output = exec_command(cmd);
+
+    std::istringstream stream(output);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(stream, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 3) << output;
+    const std::string token = "\"root\":";
+    auto root_of = [&token](const std::string& line) {
+        auto pos = line.find(token);
+        return pos == std::string::npos ? 0.0 : std::stod(line.substr(pos + token.size()));
+    };
+    EXPECT_NEAR(root_of(lines[0]), -2.0, 1e-4);
+    EXPECT_NEAR(root_of(lines[1]), 2.0, 1e-4);
+    EXPECT_NE(lines[2].find("\"error\""), std::string::npos) << lines[2];
+    EXPECT_NE(lines[0].find("\"status\":\"converged\""), std::string::npos) << lines[0];
+    // the trajectory comes first, the status closes the object
+    EXPECT_EQ(lines[0].rfind("{\"trajectory\":[[", 0), 0U) << lines[0];
+    EXPECT_NE(lines[0].find("],\"root\":"), std::string::npos) << lines[0];
+    EXPECT_TRUE(lines[0].ends_with("\"status\":\"converged\"}")) << lines[0];
+
+    // the daemon removes its socket once stopped
+    for (int attempt = 0; attempt < 100 && std::filesystem::exists(socket_path); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    EXPECT_FALSE(std::filesystem::exists(socket_path));
+}
+
+TEST(ShmServerClient, SolvesRequestsFromTheRing) {
+    std::string exe = "../../ROOT/root_cli";
+    std::string name = "/root-test-cli-ring";
+
+    std::system((exe + " shm --name " + name + " --capacity 16 2>/dev/null &").c_str());
+    std::string segment = "/dev/shm" + name;
+    for (int attempt = 0; attempt < 100 && !std::filesystem::exists(segment); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    ASSERT_TRUE(std::filesystem::exists(segment));
+
+    ShmClient client(name);
+    ShmRequest newton{};
+    newton.id = 1;
+    newton.method = Method::NEWTON;
+    newton.max_iterations = 100;
+    newton.tolerance = 1e-8;
+    newton.first = -1;
+    ASSERT_TRUE(shm_set_expression(newton.function, "x^2-4"));
+    ASSERT_TRUE(shm_set_expression(newton.auxiliary, "2*x"));
+    ShmRequest bisection = newton;
+    bisection.id = 2;
+    bisection.method = Method::BISECTION;
+    bisection.first = 3;
+    bisection.second = 4;  // same sign at both ends, rejected instead of stopping the server
+    ShmRequest unparsable = newton;
+    unparsable.id = 3;
+    ASSERT_TRUE(shm_set_expression(unparsable.function, "x^2+y"));  // rejected instead of stopping the server
+    ShmRequest chords = newton;
+    chords.id = 4;
+    chords.method = Method::CHORDS;
+    chords.first = 1;
+    chords.second = 3;
+    ASSERT_TRUE(shm_set_expression(chords.function, "x^3-8"));
+
+    ASSERT_TRUE(client.try_submit(newton));
+    ASSERT_TRUE(client.try_submit(bisection));
+    ASSERT_TRUE(client.try_submit(unparsable));
+    ASSERT_TRUE(client.try_submit(chords));
+
+    ShmResult result{};
+    ASSERT_TRUE(client.receive(result));
+    EXPECT_EQ(result.id, 1U);
+    EXPECT_EQ(result.status, SHM_SOLVED);
+    EXPECT_NEAR(result.root, -2.0, 1e-6);
+    ASSERT_TRUE(client.receive(result));
+    EXPECT_EQ(result.id, 2U);
+    EXPECT_EQ(result.status, SHM_REJECTED);
+    ASSERT_TRUE(client.receive(result));
+    EXPECT_EQ(result.id, 3U);
+    EXPECT_EQ(result.status, SHM_REJECTED);
+    ASSERT_TRUE(client.receive(result));
+    EXPECT_EQ(result.id, 4U);
+    EXPECT_EQ(result.status, SHM_SOLVED);
+    EXPECT_NEAR(result.root, 2.0, 1e-6);
+
+    client.stop();
+    for (int attempt = 0; attempt < 100 && std::filesystem::exists(segment); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    EXPECT_FALSE(std::filesystem::exists(segment));
+}
+
+TEST(MultiProblemDaemonClient, AppliesEvaluationLimit) {
+    std::string exe = "../../ROOT/root_cli";
+    std::string socket_path = "test_cli_daemon_limits.sock";
+
+    std::filesystem::remove(socket_path);
+    std::system((exe + " --max-evaluations 6 daemon --socket " + socket_path + " 2>/dev/null &").c_str());
+    for (int attempt = 0; attempt < 100 && !std::filesystem::exists(socket_path); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    ASSERT_TRUE(std::filesystem::exists(socket_path));
+
+    std::string request = R"({"function": "x^2-4", "method": "bisection", "interval_a": 0, "interval_b": 5, )"
+                          R"("tolerance": 1e-300, "max-iterations": 1000})";
+    std::string output =
+        exec_command("echo '" + request + "' | " + exe + " client --socket " + socket_path + " --stop");
+    EXPECT_NE(output.find("\"status\":\"budget_exhausted\""), std::string::npos) << output;
+    EXPECT_NE(output.find("\"root\":"), std::string::npos) << output;
+
+    for (int attempt = 0; attempt < 100 && std::filesystem::exists(socket_path); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
+
+TEST(ShmServerClient, AppliesEvaluationLimit) {
+    std::string exe = "../../ROOT/root_cli";
+    std::string name = "/root-test-cli-ring-limits";
+
+    std::system((exe + " --max-evaluations 6 shm --name " + name + " --capacity 4 2>/dev/null &").c_str());
+    std::string segment = "/dev/shm" + name;
+    for (int attempt = 0; attempt < 100 && !std::filesystem::exists(segment); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    ASSERT_TRUE(std::filesystem::exists(segment));
+
+    ShmClient client(name);
+    ShmRequest bisection{};
+    bisection.id = 1;
+    bisection.method = Method::BISECTION;
+    bisection.max_iterations = 1000;
+    bisection.tolerance = 1e-300;
+    bisection.first = 0;
+    bisection.second = 5;
+    ASSERT_TRUE(shm_set_expression(bisection.function, "x^2-4"));
+    ASSERT_TRUE(client.try_submit(bisection));
+
+    ShmResult result{};
+    ASSERT_TRUE(client.receive(result));
+    EXPECT_EQ(result.id, 1U);
+    EXPECT_EQ(result.status, SHM_BUDGET_EXHAUSTED);
+    // the best iterate is reported, which is at least as close as the midpoint of the interval
+    EXPECT_LE(std::abs(result.f_root), std::abs(2.5 * 2.5 - 4));
+
+    client.stop();
+    for (int attempt = 0; attempt < 100 && std::filesystem::exists(segment); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
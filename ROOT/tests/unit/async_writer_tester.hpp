@@ -0,0 +1,79 @@
+#ifndef ASYNC_WRITER_TESTER_HPP
+#define ASYNC_WRITER_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "ROOT/async_writer.hpp"
+
+/**
+ * @brief Test fixture class for the MpscQueue and AsyncWriter unit tests.
+ *
+ */
+class AsyncWriterTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test that the queue keeps its values in order and refuses new ones when full.
+     *
+     * @param capacity The requested capacity (rounded up to a power of two).
+     */
+    void testQueueFull(std::size_t capacity) {
+        MpscQueue<int> queue(capacity);
+        EXPECT_GE(queue.capacity(), capacity);
+        EXPECT_EQ(queue.capacity() & (queue.capacity() - 1), 0U);
+
+        // wrap around the slots a few times
+        for (int lap = 0; lap < 3; ++lap) {
+            for (int i = 0; i < static_cast<int>(queue.capacity()); ++i) {
+                int value = i;
+                EXPECT_TRUE(queue.try_push(value));
+            }
+            int rejected = -1;
+            EXPECT_FALSE(queue.try_push(rejected));
+            EXPECT_EQ(rejected, -1);
+            for (int i = 0; i < static_cast<int>(queue.capacity()); ++i) {
+                int value = -1;
+                EXPECT_TRUE(queue.try_pop(value));
+                EXPECT_EQ(value, i);
+            }
+            int value = -1;
+            EXPECT_FALSE(queue.try_pop(value));
+        }
+    }
+
+    /**
+     * @brief Test that every job submitted by several threads runs, in submission order for each thread.
+     *
+     * @param capacity The number of slots of the queue (small to make the producers wait).
+     * @param producers The number of submitting threads.
+     * @param jobs The number of jobs submitted by each thread.
+     */
+    void testRunsEveryJob(std::size_t capacity, int producers, int jobs) {
+        // only the writer thread touches the results, so they need no synchronization
+        std::vector<std::vector<int>> written(producers);
+        {
+            AsyncWriter writer(capacity);
+            std::vector<std::thread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.emplace_back([&writer, &written, p, jobs] {
+                    for (int j = 0; j < jobs; ++j) {
+                        writer.submit([&written, p, j] { written[p].push_back(j); });
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+        for (int p = 0; p < producers; ++p) {
+            ASSERT_EQ(written[p].size(), static_cast<size_t>(jobs));
+            for (int j = 0; j < jobs; ++j) {
+                EXPECT_EQ(written[p][j], j);
+            }
+        }
+    }
+};
+
+#endif  // ASYNC_WRITER_TESTER_HPP
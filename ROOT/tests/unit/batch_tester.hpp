@@ -0,0 +1,107 @@
+#ifndef BATCH_TESTER_HPP
+#define BATCH_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ROOT/batch.hpp"
+
+/**
+ * @brief Test fixture class for the batch runner unit tests.
+ *
+ */
+class BatchTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test the parsing of valid and invalid shard descriptions.
+     *
+     */
+    void testParseShard() {
+        BatchShard shard;
+        EXPECT_TRUE(parse_batch_shard("2/5", shard));
+        EXPECT_EQ(shard.index, 2U);
+        EXPECT_EQ(shard.count, 5U);
+        for (const std::string invalid : {"5/5", "1/0", "/3", "1/", "1", "a/3", "1/3x", "-1/3"}) {
+            EXPECT_FALSE(parse_batch_shard(invalid, shard)) << invalid;
+        }
+        // an invalid description leaves the shard untouched
+        EXPECT_EQ(shard.index, 2U);
+    }
+
+    /**
+     * @brief Test that the shards of a batch cover every problem once, and that rows are emitted in order.
+     *
+     * @param problems The number of problems of the batch.
+     * @param shards The number of shards.
+     * @param jobs The number of threads of every shard.
+     */
+    void testShardsCoverBatch(std::size_t problems, std::size_t shards, std::size_t jobs) {
+        std::vector<int> solved(problems, 0);
+        for (std::size_t index = 0; index < shards; ++index) {
+            std::vector<std::uint64_t> emitted;
+            std::size_t size = run_batch(
+                problems, {index, shards}, jobs,
+                [](std::size_t id) {
+                    // later problems finish first, the rows must still come out in order
+                    std::this_thread::sleep_for(std::chrono::microseconds(id % 3 == 0 ? 200 : 0));
+                    BatchRow row;
+                    row.id = id;
+                    return row;
+                },
+                [&emitted](BatchRow& row) { emitted.push_back(row.id); });
+            EXPECT_EQ(size, emitted.size());
+            for (std::size_t k = 0; k < emitted.size(); ++k) {
+                EXPECT_EQ(emitted[k], index + k * shards);
+                ++solved[emitted[k]];
+            }
+        }
+        for (std::size_t id = 0; id < problems; ++id) {
+            EXPECT_EQ(solved[id], 1) << "problem " << id;
+        }
+    }
+
+    /**
+     * @brief Test the CSV and JSON Lines summary rows.
+     *
+     */
+    void testSummaryRows() {
+        BatchRow row;
+        row.id = 12;
+        row.name = "cubic, shifted";
+        row.status = SolverStatus::MAX_ITERATIONS;
+        row.root = 2.5;
+        row.residual = 1e-3;
+        row.iterations = 100;
+        row.evaluations = 201;
+        row.seconds = 0.25;
+
+        std::string csv = batch_csv_header(',');
+        append_batch_csv(csv, row, ',');
+        EXPECT_EQ(csv,
+                  "id,name,status,root,residual,iterations,evaluations,seconds\n"
+                  "12,\"cubic, shifted\",max_iterations,2.5,0.001,100,201,0.25\n");
+
+        std::string jsonl;
+        row.status = SolverStatus::DIVERGED;
+        row.root = std::numeric_limits<double>::infinity();
+        append_batch_jsonl(jsonl, row);
+        EXPECT_EQ(jsonl,
+                  R"({"id":12,"name":"cubic, shifted","status":"diverged","root":null,"residual":0.001,)"
+                  R"("iterations":100,"evaluations":201,"seconds":0.25})"
+                  "\n");
+
+        // names are written as JSON strings, control characters included
+        jsonl.clear();
+        row.name = "line\n\"two\"\t\x01\\";
+        append_batch_jsonl(jsonl, row);
+        EXPECT_EQ(jsonl.substr(0, jsonl.find(",\"status\"")), R"({"id":12,"name":"line\n\"two\"\t\u0001\\")");
+    }
+};
+
+#endif  // BATCH_TESTER_HPP
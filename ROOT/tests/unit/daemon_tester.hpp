@@ -0,0 +1,156 @@
+#ifndef DAEMON_TESTER_HPP
+#define DAEMON_TESTER_HPP
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ROOT/daemon.hpp"
+#include "ROOT/function_parser.hpp"
+#include "ROOT/reader.hpp"
+
+/**
+ * @brief Test fixture class for SolverDaemon unit tests.
+ *
+ */
+class SolverDaemonTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test that frames of different sizes are read back unchanged on the other end of a socket.
+     *
+     * @param payloads The payloads to send, in order.
+     */
+    void testFrameRoundTrip(const std::vector<std::string>& payloads) {
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+        std::thread sender([&payloads, fd = fds[0]] {
+            for (const auto& payload : payloads) {
+                write_frame(fd, payload);
+            }
+            ::close(fd);
+        });
+        std::string received;
+        for (const auto& payload : payloads) {
+            ASSERT_TRUE(read_frame(fds[1], received));
+            EXPECT_EQ(received, payload);
+        }
+        // the sender closed its end
+        EXPECT_FALSE(read_frame(fds[1], received));
+        sender.join();
+        ::close(fds[1]);
+    }
+
+    /**
+     * @brief Test that a daemon answers the requests of several connections and stops on an empty frame.
+     *
+     * @param connections The number of concurrent connections.
+     * @param requests The number of requests sent on every connection.
+     */
+    void testServe(int connections, int requests) {
+        std::string socket_path = "test_daemon.sock";
+        std::thread server_thread;
+        {
+            SolverDaemon daemon(socket_path, 2, [](const std::string& request) { return "echo:" + request; });
+            server_thread = std::thread([&daemon] { daemon.serve(); });
+
+            std::vector<std::thread> clients;
+            for (int client = 0; client < connections; ++client) {
+                clients.emplace_back([&socket_path, client, requests] {
+                    int fd = connect_daemon(socket_path);
+                    std::string response;
+                    for (int i = 0; i < requests; ++i) {
+                        std::string request = std::to_string(client) + "/" + std::to_string(i);
+                        ASSERT_TRUE(write_frame(fd, request));
+                        ASSERT_TRUE(read_frame(fd, response));
+                        EXPECT_EQ(response, "echo:" + request);
+                    }
+                    ::close(fd);
+                });
+            }
+            for (auto& client : clients) {
+                client.join();
+            }
+
+            int fd = connect_daemon(socket_path);
+            EXPECT_TRUE(write_frame(fd, ""));
+            server_thread.join();
+            EXPECT_TRUE(daemon.stopping);
+            ::close(fd);
+        }
+        EXPECT_FALSE(std::filesystem::exists(socket_path));
+    }
+
+    /**
+     * @brief Test that clients beyond the number of worker threads are served while every connection stays open.
+     *
+     * @param threads The number of worker threads of the daemon.
+     * @param connections The number of connections, all opened before the first request.
+     * @param rounds The number of requests sent on every connection, one connection after the other.
+     */
+    void testMoreConnectionsThanThreads(std::size_t threads, int connections, int rounds) {
+        std::string socket_path = "test_daemon_idle.sock";
+        SolverDaemon daemon(socket_path, threads, [](const std::string& request) { return "echo:" + request; });
+        std::thread server_thread([&daemon] { daemon.serve(); });
+
+        std::vector<int> fds;
+        for (int client = 0; client < connections; ++client) {
+            fds.push_back(connect_daemon(socket_path));
+        }
+        std::string response;
+        for (int round = 0; round < rounds; ++round) {
+            for (int client = 0; client < connections; ++client) {
+                std::string request = std::to_string(client) + "/" + std::to_string(round);
+                ASSERT_TRUE(write_frame(fds[client], request));
+                ASSERT_TRUE(read_frame(fds[client], response));
+                EXPECT_EQ(response, "echo:" + request);
+            }
+        }
+
+        EXPECT_TRUE(write_frame(fds.front(), ""));
+        server_thread.join();
+        for (int fd : fds) {
+            ::close(fd);
+        }
+    }
+
+    /**
+     * @brief Test that malformed requests are answered with an error object and the daemon keeps serving.
+     *
+     * @param requests The malformed requests, each sent before a valid one.
+     */
+    void testRejectsBadRequests(const std::vector<std::string>& requests) {
+        std::string socket_path = "test_daemon_bad.sock";
+        FunctionCache cache;
+        SolverDaemon daemon(socket_path, 2, [&cache](const std::string& request) {
+            std::unique_ptr<ConfigBase> config;
+            std::string error;
+            return ReaderJSONL::try_read_line(request, config, error, &cache) ? std::string("ok")
+                                                                               : daemon_error(error);
+        });
+        std::thread server_thread([&daemon] { daemon.serve(); });
+
+        const std::string valid = R"({"function": "x^2-4", "method": "newton", "initial": 1, "derivative": "2*x"})";
+        int fd = connect_daemon(socket_path);
+        std::string response;
+        for (const auto& request : requests) {
+            ASSERT_TRUE(write_frame(fd, request));
+            ASSERT_TRUE(read_frame(fd, response));
+            EXPECT_EQ(response.rfind("{\"error\":", 0), 0U) << request << " -> " << response;
+            ASSERT_TRUE(write_frame(fd, valid));
+            ASSERT_TRUE(read_frame(fd, response));
+            EXPECT_EQ(response, "ok") << "after " << request;
+        }
+
+        EXPECT_TRUE(write_frame(fd, ""));
+        server_thread.join();
+        ::close(fd);
+    }
+};
+
+#endif  // DAEMON_TESTER_HPP
@@ -0,0 +1,35 @@
+#ifndef FUNCTION_CACHE_TESTER_HPP
+#define FUNCTION_CACHE_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "ROOT/function_parser.hpp"
+
+/**
+ * @brief Test fixture class for FunctionCache unit tests.
+ *
+ */
+class FunctionCacheTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test that every distinct expression is parsed and stored once.
+     *
+     * @param expressions The expressions to request, possibly repeated.
+     * @param expected_size The expected number of distinct cached expressions.
+     * @param test_value A value to evaluate the returned functions at.
+     */
+    void testGet(const std::vector<std::string>& expressions, size_t expected_size, double test_value) {
+        FunctionCache cache;
+        for (const auto& expression : expressions) {
+            auto function = cache.get(expression);
+            EXPECT_DOUBLE_EQ(function(test_value), FunctionParserBase::parseFunction(expression)(test_value));
+            EXPECT_EQ(cache.functions.count(expression), 1);
+        }
+        EXPECT_EQ(cache.size(), expected_size);
+    }
+};
+
+#endif  // FUNCTION_CACHE_TESTER_HPP
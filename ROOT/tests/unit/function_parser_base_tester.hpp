@@ -3,6 +3,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <complex>
+#include <libROOT/scalar.hpp>
+
 #include "ROOT/function_parser.hpp"
 
 /**
@@ -93,6 +97,75 @@ class FunctionParserBaseTester : public ::testing::Test {
         double expected_value = expected(test_value);
         EXPECT_NEAR(result_value, expected_value, tolerance);
     }
+
+    /**
+     * @brief Test that a function parsed with named parameters follows the later changes of their values.
+     *
+     * @param input The input function string to parse, using the parameters a and p.
+     * @param expected The expected result, given the values of a and p.
+     * @param test_value A value to test the parsed function.
+     */
+    void testParseFunctionWithParameters(const std::string& input,
+                                         const std::function<double(double, double, double)>& expected,
+                                         double test_value) {
+        auto a = std::make_shared<double>(2.0);
+        auto p = std::make_shared<double>(3.0);
+        std::function<double(double)> result = FunctionParserBase::parseFunction(input, {{"a", a}, {"p", p}});
+        EXPECT_DOUBLE_EQ(result(test_value), expected(test_value, *a, *p));
+        *a = -0.5;
+        *p = 7.0;
+        EXPECT_DOUBLE_EQ(result(test_value), expected(test_value, *a, *p));
+    }
+    /**
+     * @brief Test that tryParseFunction reports an error instead of stopping the program.
+     *
+     * @param input The input function string to parse.
+     * @param valid Whether the input is expected to parse.
+     */
+    void testTryParseFunction(const std::string& input, bool valid) {
+        std::function<double(double)> result;
+        std::string error;
+        EXPECT_EQ(FunctionParserBase::tryParseFunction(input, result, error), valid) << input;
+        EXPECT_EQ(error.empty(), valid) << input << ": " << error;
+        EXPECT_EQ(static_cast<bool>(result), valid) << input;
+    }
+    void testParseFunctionPrecision() {
+        // (1 + 2^-40)^2 - 2 = -1 + 2^-39 + 2^-80: the last term needs more digits than a double or a long double has
+        const double x = 1.0 + std::ldexp(1.0, -40);
+        auto dd = FunctionParserBase::parseFunction<DoubleDouble>("x^2 - 2");
+        EXPECT_EQ(static_cast<double>(dd(x) + 1.0 - std::ldexp(1.0, -39)), std::ldexp(1.0, -80));
+        auto ld = FunctionParserBase::parseFunction<long double>("x^2 - 2");
+        EXPECT_EQ(ld(x), -1.0L + std::ldexp(1.0L, -39));
+
+        auto fl = FunctionParserBase::parseFunction<float>("2.5*x^2 - 1");
+        EXPECT_FLOAT_EQ(fl(2.0F), 9.0F);
+        auto trig = FunctionParserBase::parseFunction<DoubleDouble>("2*sin(x) - cos(x)");
+        EXPECT_LT(magnitude(trig(DoubleDouble::half_pi()) - 2.0), 1e-31);
+
+        // coefficients are read with the 106 bits of a DoubleDouble, beyond what a long double holds
+        auto tenth = FunctionParserBase::parseFunction<DoubleDouble>("0.1*x - 1");
+        EXPECT_LT(magnitude(tenth(10.0)), 1e-31);
+        auto close = FunctionParserBase::parseFunction<DoubleDouble>("1.0000000000000000000000000001*x - 1");
+        EXPECT_LT(magnitude(close(1.0) - 1e-28), 1e-31);
+
+        auto a = std::make_shared<double>(0.5);
+        auto parametrized = FunctionParserBase::parseFunction<DoubleDouble>("a*x^2 - 3", {{"a", a}});
+        EXPECT_EQ(static_cast<double>(parametrized(4.0)), 5.0);
+    }
+    void testParseFunctionComplex() {
+        using Complex = std::complex<double>;
+        const Complex i(0.0, 1.0);
+        auto polynomial = FunctionParserBase::parseFunction<Complex>("x^2 + 1");
+        EXPECT_EQ(polynomial(i), Complex(0.0));
+        EXPECT_EQ(polynomial(Complex(1.0, 1.0)), Complex(1.0, 2.0));
+        auto cubic = FunctionParserBase::parseFunction<Complex>("-0.5*x^3 + 2*x");
+        EXPECT_EQ(cubic(i), Complex(0.0, 2.5));
+
+        auto trig = FunctionParserBase::parseFunction<Complex>("2*sin(x) - cos(x)");
+        Complex value = trig(i);
+        EXPECT_NEAR(value.real(), -std::cosh(1.0), 1e-15);
+        EXPECT_NEAR(value.imag(), 2.0 * std::sinh(1.0), 1e-15);
+    }
 };
 
 #endif  // FUNCTION_PARSER_BASE_TESTER_HPP
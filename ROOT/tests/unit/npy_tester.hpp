@@ -0,0 +1,110 @@
+#ifndef NPY_TESTER_HPP
+#define NPY_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "ROOT/npy.hpp"
+
+/**
+ * @brief Test fixture class for the .npy and .npz writer unit tests.
+ *
+ */
+class NpyTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test the header of an array, which must describe it and keep the data aligned on 64 bytes.
+     *
+     * @param shape The dimensions of the array.
+     * @param expected_dict The expected dictionary, before the padding.
+     */
+    void testHeader(const std::vector<std::size_t>& shape, const std::string& expected_dict) {
+        std::string header = npy_header("<f8", shape, false);
+        EXPECT_EQ(header.size() % 64, 0U);
+        EXPECT_EQ(header.substr(0, 8), std::string("\x93NUMPY\x01\x00", 8));
+        EXPECT_EQ(read16(header, 8), header.size() - 10);
+        EXPECT_EQ(header.substr(10, expected_dict.size()), expected_dict);
+        EXPECT_EQ(header.find_first_not_of(' ', 10 + expected_dict.size()), header.size() - 1);
+        EXPECT_EQ(header.back(), '\n');
+    }
+
+    /**
+     * @brief Test the CRC-32 against the standard check value, also computed block by block.
+     *
+     */
+    void testCrc32() {
+        std::string digits = "123456789";
+        EXPECT_EQ(crc32(digits.data(), digits.size()), 0xCBF43926u);
+        EXPECT_EQ(crc32(digits.data() + 4, 5, crc32(digits.data(), 4)), 0xCBF43926u);
+        EXPECT_EQ(crc32(nullptr, 0), 0u);
+    }
+
+    /**
+     * @brief Test that the members of an archive are stored uncompressed and listed in the central directory.
+     *
+     */
+    void testArchive() {
+        std::string filename = "test_archive.npz";
+        std::vector<double> x = {0.5, 1.5, -2.25};
+        std::vector<std::int32_t> iterations = {3, 7};
+        std::vector<std::uint32_t> offsets;
+        {
+            NpzWriter npz(filename);
+            npz.add("x", x);
+            npz.add("iterations", iterations);
+            ASSERT_EQ(npz.entries.size(), 2U);
+            for (const auto& entry : npz.entries) {
+                offsets.push_back(entry.offset);
+            }
+            EXPECT_EQ(npz.entries[0].name, "x.npy");
+            EXPECT_EQ(npz.entries[1].name, "iterations.npy");
+        }
+
+        std::ifstream file(filename, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(read32(bytes, offsets[0]), 0x04034b50u);
+        EXPECT_EQ(read32(bytes, offsets[1]), 0x04034b50u);
+
+        // the member data is the .npy file itself, with its CRC and size in the local header
+        std::size_t name_size = read16(bytes, offsets[0] + 26);
+        std::size_t member = offsets[0] + 30 + name_size;
+        std::uint32_t size = read32(bytes, offsets[0] + 18);
+        EXPECT_EQ(read32(bytes, offsets[0] + 22), size);
+        EXPECT_EQ(read32(bytes, offsets[0] + 14), crc32(bytes.data() + member, size));
+        std::string header = npy_header("<f8", {x.size()}, false);
+        EXPECT_EQ(bytes.substr(member, header.size()), header);
+        std::vector<double> read_back(x.size());
+        std::memcpy(read_back.data(), bytes.data() + member + header.size(), x.size() * sizeof(double));
+        EXPECT_EQ(read_back, x);
+
+        // the end of central directory record counts the members and points at the central directory
+        std::size_t end = bytes.size() - 22;
+        EXPECT_EQ(read32(bytes, end), 0x06054b50u);
+        EXPECT_EQ(read16(bytes, end + 10), 2U);
+        std::uint32_t directory = read32(bytes, end + 16);
+        EXPECT_EQ(read32(bytes, end + 12), end - directory);
+        EXPECT_EQ(read32(bytes, directory), 0x02014b50u);
+        EXPECT_EQ(read32(bytes, directory + 42), offsets[0]);
+
+        std::filesystem::remove(filename);
+    }
+
+  private:
+    /** @brief Read a 16-bit little-endian integer at the given position. */
+    static std::uint32_t read16(const std::string& bytes, std::size_t at) {
+        return static_cast<unsigned char>(bytes[at]) | static_cast<unsigned char>(bytes[at + 1]) << 8;
+    }
+    /** @brief Read a 32-bit little-endian integer at the given position. */
+    static std::uint32_t read32(const std::string& bytes, std::size_t at) {
+        return read16(bytes, at) | read16(bytes, at + 2) << 16;
+    }
+};
+
+#endif  // NPY_TESTER_HPP
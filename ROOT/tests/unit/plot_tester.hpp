@@ -0,0 +1,144 @@
+#ifndef PLOT_TESTER_HPP
+#define PLOT_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "ROOT/npy.hpp"
+#include "ROOT/plot.hpp"
+
+/**
+ * @brief Test fixture class for the ConvergencePlot and PNG encoder unit tests.
+ *
+ */
+class ConvergencePlotTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test that an encoded PNG has valid chunks and stores every pixel uncompressed.
+     *
+     * @param width The width of the image.
+     * @param height The height of the image (large images span several deflate blocks).
+     */
+    void testPngEncode(int width, int height) {
+        std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * height);
+        for (std::size_t i = 0; i < pixels.size(); ++i) {
+            pixels[i] = static_cast<std::uint8_t>(i % 3);
+        }
+        std::string png = png_encode(pixels, width, height, {255, 255, 255, 0, 0, 0, 255, 0, 0});
+        ASSERT_EQ(png.substr(0, 8), std::string("\x89PNG\r\n\x1a\n", 8));
+
+        // walk through the chunks, checking their CRC and gathering the image data
+        std::vector<std::string> types;
+        std::string idat;
+        for (std::size_t at = 8; at < png.size();) {
+            std::uint32_t size = read32be(png, at);
+            std::string type = png.substr(at + 4, 4);
+            EXPECT_EQ(read32be(png, at + 8 + size), crc32(png.data() + at + 4, size + 4)) << type;
+            if (type == "IHDR") {
+                EXPECT_EQ(read32be(png, at + 8), static_cast<std::uint32_t>(width));
+                EXPECT_EQ(read32be(png, at + 12), static_cast<std::uint32_t>(height));
+                EXPECT_EQ(png[at + 16], 8);
+                EXPECT_EQ(png[at + 17], 3);
+            } else if (type == "IDAT") {
+                idat = png.substr(at + 8, size);
+            }
+            types.push_back(type);
+            at += 12 + size;
+        }
+        EXPECT_EQ(types, (std::vector<std::string>{"IHDR", "PLTE", "IDAT", "IEND"}));
+
+        // unwrap the stored deflate blocks: every scanline is its filter byte followed by the pixels
+        std::string raw;
+        std::size_t at = 2;
+        bool last = false;
+        while (!last) {
+            last = idat[at] & 1;
+            std::size_t size = static_cast<unsigned char>(idat[at + 1]) | static_cast<unsigned char>(idat[at + 2]) << 8;
+            raw += idat.substr(at + 5, size);
+            at += 5 + size;
+        }
+        EXPECT_EQ(at + 4, idat.size());
+        ASSERT_EQ(raw.size(), static_cast<std::size_t>(height) * (width + 1));
+        for (int y = 0; y < height; ++y) {
+            EXPECT_EQ(raw[static_cast<std::size_t>(y) * (width + 1)], 0);
+            for (int x = 0; x < width; ++x) {
+                ASSERT_EQ(static_cast<std::uint8_t>(raw[static_cast<std::size_t>(y) * (width + 1) + 1 + x]),
+                          pixels[static_cast<std::size_t>(y) * width + x]);
+            }
+        }
+    }
+
+    /**
+     * @brief Test that the axes cover every finite point, and never collapse for constant paths.
+     *
+     */
+    void testFrame() {
+        ConvergencePlot plot;
+        Eigen::MatrixX2d path(3, 2);
+        path << 1, 5, 2, INFINITY, 3, 5;
+        plot.add("constant", path);
+        EXPECT_EQ(plot.series.front().x.size(), 2U);
+
+        auto frame = plot.frame();
+        EXPECT_LT(frame.x_min, 1);
+        EXPECT_GT(frame.x_max, 3);
+        EXPECT_LT(frame.y_min, 5);
+        EXPECT_GT(frame.y_max, 5);
+        EXPECT_GE(frame.column(1), frame.left);
+        EXPECT_LE(frame.column(3), frame.right);
+        EXPECT_NEAR(frame.row(5), (frame.top + frame.bottom) / 2, 1e-9);
+    }
+
+    /**
+     * @brief Test that every path of an SVG plot is drawn and named in the legend.
+     *
+     */
+    void testWriteSvg() {
+        ConvergencePlot plot;
+        Eigen::MatrixX2d first(2, 2);
+        first << -1, -3, -2, 0;
+        Eigen::MatrixX2d second(3, 2);
+        second << 1, -7, 3, 19, 2, 0;
+        plot.add("a<b", first);
+        plot.add("second", second);
+        EXPECT_EQ(plot.size(), 2U);
+        plot.write_svg("plot.svg");
+
+        std::ifstream file("plot.svg");
+        std::string svg((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::filesystem::remove("plot.svg");
+        EXPECT_EQ(svg.rfind("<svg", 0), 0U);
+        EXPECT_EQ(count(svg, "<polyline"), 2U);
+        EXPECT_EQ(count(svg, "<circle"), 5U);
+        EXPECT_NE(svg.find(">a&lt;b</text>"), std::string::npos);
+        EXPECT_NE(svg.find(">second</text>"), std::string::npos);
+        EXPECT_NE(svg.find("</svg>"), std::string::npos);
+    }
+
+  private:
+    /** @brief Read a 32-bit big-endian integer at the given position. */
+    static std::uint32_t read32be(const std::string& bytes, std::size_t at) {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value = value << 8 | static_cast<unsigned char>(bytes[at + i]);
+        }
+        return value;
+    }
+    /** @brief Count the occurrences of a string. */
+    static std::size_t count(const std::string& text, const std::string& needle) {
+        std::size_t occurrences = 0;
+        for (auto at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+            ++occurrences;
+        }
+        return occurrences;
+    }
+};
+
+#endif  // PLOT_TESTER_HPP
@@ -0,0 +1,101 @@
+#ifndef PORTFOLIO_TESTER_HPP
+#define PORTFOLIO_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ROOT/portfolio.hpp"
+
+/**
+ * @brief Test fixture class for the method portfolio unit tests.
+ *
+ */
+class PortfolioTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test that the names of the methods are parsed back to the same methods.
+     *
+     */
+    void testMethodNames() {
+        for (Method method : {Method::NEWTON, Method::CHORDS, Method::FIXED_POINT, Method::BISECTION}) {
+            Method parsed = Method::BISECTION;
+            EXPECT_TRUE(parse_portfolio_method(portfolio_method_name(method), parsed));
+            EXPECT_EQ(parsed, method);
+        }
+        Method untouched = Method::CHORDS;
+        EXPECT_FALSE(parse_portfolio_method("secant", untouched));
+        EXPECT_EQ(untouched, Method::CHORDS);
+    }
+
+    /**
+     * @brief Test that the first method to converge wins, and that the others stop once it does.
+     *
+     */
+    void testRaceCancelsLosers() {
+        auto start = std::chrono::steady_clock::now();
+        PortfolioResult result = race_portfolio(
+            {Method::BISECTION, Method::NEWTON, Method::CHORDS}, [](Method method, std::stop_token stop) {
+                PortfolioEntry entry;
+                // Newton converges after a few iterations, the other methods would iterate for a minute
+                int iterations = method == Method::NEWTON ? 5 : 60000;
+                while (entry.iterations < iterations && !stop.stop_requested()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    ++entry.iterations;
+                }
+                entry.status = entry.iterations == iterations ? SolverStatus::CONVERGED : SolverStatus::CANCELLED;
+                return entry;
+            });
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        ASSERT_TRUE(result.winner.has_value());
+        EXPECT_EQ(*result.winner, 1U);
+        ASSERT_EQ(result.entries.size(), 3U);
+        EXPECT_EQ(result.entries[0].method, Method::BISECTION);
+        EXPECT_EQ(result.entries[0].status, SolverStatus::CANCELLED);
+        EXPECT_EQ(result.entries[1].status, SolverStatus::CONVERGED);
+        EXPECT_EQ(result.entries[2].status, SolverStatus::CANCELLED);
+        EXPECT_LT(elapsed.count(), 10.0);
+    }
+
+    /**
+     * @brief Test a race in which no method converges.
+     *
+     */
+    void testRaceWithoutWinner() {
+        PortfolioResult result = race_portfolio({Method::NEWTON, Method::CHORDS}, [](Method, std::stop_token) {
+            PortfolioEntry entry;
+            entry.status = SolverStatus::MAX_ITERATIONS;
+            return entry;
+        });
+        EXPECT_FALSE(result.winner.has_value());
+        EXPECT_EQ(result.entries[0].status, SolverStatus::MAX_ITERATIONS);
+        EXPECT_EQ(result.entries[1].method, Method::CHORDS);
+    }
+
+    /**
+     * @brief Test the CSV summary rows.
+     *
+     */
+    void testSummaryRows() {
+        PortfolioEntry entry;
+        entry.method = Method::FIXED_POINT;
+        entry.status = SolverStatus::CANCELLED;
+        entry.root = 0.75;
+        entry.residual = 0.125;
+        entry.iterations = 3;
+        entry.evaluations = 7;
+        entry.seconds = 0.5;
+
+        std::string csv = portfolio_csv_header(';');
+        append_portfolio_csv(csv, entry, false, ';');
+        EXPECT_EQ(csv,
+                  "method;status;root;residual;iterations;evaluations;seconds;winner\n"
+                  "fixed_point;cancelled;0.75;0.125;3;7;0.5;false\n");
+    }
+};
+
+#endif  // PORTFOLIO_TESTER_HPP
@@ -0,0 +1,207 @@
+#ifndef READER_BIN_TESTER_HPP
+#define READER_BIN_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ROOT/binary_format.hpp"
+#include "ROOT/reader.hpp"
+
+/**
+ * @brief Test fixture class for ReaderBIN (and columnar binary format) unit tests.
+ *
+ */
+class ReaderBINTester : public ::testing::Test {
+  protected:
+    /**
+     * @brief Picks a batch file named after the test, so that tests running in parallel do not share it.
+     *
+     */
+    void SetUp() override {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        this->filename = (std::filesystem::temp_directory_path() /
+                          ("root_" + std::string(info->test_suite_name()) + "_" + info->name() + ".bin"))
+                             .string();
+    }
+
+    /**
+     * @brief Removes the batch file of the test.
+     *
+     */
+    void TearDown() override { std::filesystem::remove(this->filename); }
+
+    std::string filename;  //!< Batch file written by the test
+
+  public:
+    /**
+     * @brief Helper method to build the columns of a small batch with one problem per method.
+     *
+     * @return The columns of the batch.
+     */
+    static BinaryBatchColumns makeColumns() {
+        BinaryBatchColumns columns;
+        columns.expressions = {"x^2-4", "2*x", "x^2-x", "x^2"};
+        columns.method = {Method::NEWTON, Method::BISECTION, Method::CHORDS, Method::FIXED_POINT};
+        columns.tolerance = {1e-5, 1e-6, 1e-7, 1e-8};
+        columns.max_iterations = {100, 200, 300, 400};
+        columns.aitken = {0, 0, 1, 1};
+        columns.first = {-1.0, 0.0, 1.0, 0.5};
+        columns.second = {0.0, 3.0, 3.0, 0.0};
+        columns.function = {0, 0, 0, 2};
+        columns.auxiliary = {1, binary_batch_no_function, binary_batch_no_function, 3};
+        return columns;
+    }
+
+    /**
+     * @brief Test that a written batch is mapped back with identical columns and dictionary.
+     *
+     */
+    void testRoundTrip() {
+        auto columns = makeColumns();
+        write_binary_batch(this->filename, columns);
+        {
+            BinaryBatchView batch(this->filename);
+            ASSERT_EQ(batch.size(), columns.method.size());
+            ASSERT_EQ(batch.strings(), columns.expressions.size());
+            for (size_t i = 0; i < batch.size(); ++i) {
+                EXPECT_EQ(batch.method()[i], columns.method[i]);
+                EXPECT_EQ(batch.tolerance()[i], columns.tolerance[i]);
+                EXPECT_EQ(batch.max_iterations()[i], columns.max_iterations[i]);
+                EXPECT_EQ(batch.aitken()[i], columns.aitken[i]);
+                EXPECT_EQ(batch.first()[i], columns.first[i]);
+                EXPECT_EQ(batch.second()[i], columns.second[i]);
+                EXPECT_EQ(batch.function()[i], columns.function[i]);
+                EXPECT_EQ(batch.auxiliary()[i], columns.auxiliary[i]);
+            }
+            for (std::uint32_t i = 0; i < batch.strings(); ++i) {
+                EXPECT_EQ(batch.expression(i), columns.expressions[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Test that the configurations built from a mapped batch match the stored problems.
+     *
+     */
+    void testMakeConfigs() {
+        write_binary_batch(this->filename, makeColumns());
+        std::vector<std::unique_ptr<ConfigBase>> configs;
+        {
+            BinaryBatchView batch(this->filename);
+            configs = ReaderBIN::make_configs_from_batch(batch, false);
+        }
+
+        ASSERT_EQ(configs.size(), 4);
+        auto* newton = dynamic_cast<NewtonConfig*>(configs[0].get());
+        ASSERT_NE(newton, nullptr);
+        EXPECT_DOUBLE_EQ(newton->initial_guess, -1.0);
+        EXPECT_DOUBLE_EQ(newton->derivative(3.0), 6.0);
+        EXPECT_DOUBLE_EQ(newton->tolerance, 1e-5);
+
+        auto* bisection = dynamic_cast<BisectionConfig*>(configs[1].get());
+        ASSERT_NE(bisection, nullptr);
+        EXPECT_DOUBLE_EQ(bisection->final_point, 3.0);
+        EXPECT_EQ(bisection->max_iterations, 200);
+
+        auto* chords = dynamic_cast<ChordsConfig*>(configs[2].get());
+        ASSERT_NE(chords, nullptr);
+        EXPECT_TRUE(chords->aitken);
+        EXPECT_DOUBLE_EQ(chords->function(2.0), 0.0);
+
+        auto* fixed_point = dynamic_cast<FixedPointConfig*>(configs[3].get());
+        ASSERT_NE(fixed_point, nullptr);
+        EXPECT_DOUBLE_EQ(fixed_point->g_function(3.0), 9.0);
+        EXPECT_DOUBLE_EQ(fixed_point->tolerance, 1e-8);
+    }
+
+    /**
+     * @brief Test that a file with invalid rows still opens, and that only the invalid rows fail check_row.
+     *
+     */
+    void testCheckRow() {
+        auto columns = makeColumns();
+        columns.function[1] = 7;
+        columns.auxiliary[3] = 4;
+        for (int i = 0; i < 7; ++i) {
+            columns.method.push_back(Method::CHORDS);
+            columns.tolerance.push_back(1e-6);
+            columns.max_iterations.push_back(100);
+            columns.aitken.push_back(0);
+            columns.first.push_back(1.0);
+            columns.second.push_back(3.0);
+            columns.function.push_back(2);
+            columns.auxiliary.push_back(binary_batch_no_function);
+        }
+        columns.max_iterations[4] = 0;
+        columns.max_iterations[5] = -1;
+        columns.tolerance[6] = 0.0;
+        columns.tolerance[7] = -1e-6;
+        columns.tolerance[8] = std::numeric_limits<double>::quiet_NaN();
+        columns.method[9] = Method::NEWTON;
+        columns.method[10] = 42;
+        write_binary_batch(this->filename, columns);
+        {
+            BinaryBatchView batch(this->filename);
+            const std::vector<std::string> expected = {"",
+                                                       "references a missing or malformed expression",
+                                                       "",
+                                                       "references a missing or malformed expression",
+                                                       "has non-positive max_iterations 0",
+                                                       "has non-positive max_iterations -1",
+                                                       "has non-positive tolerance",
+                                                       "has non-positive tolerance",
+                                                       "has non-positive tolerance",
+                                                       "requires a derivative or g-function",
+                                                       "has unknown method 42",
+                                                       "is out of the batch"};
+            for (size_t row = 0; row < expected.size(); ++row) {
+                std::string error;
+                EXPECT_EQ(batch.check_row(row, error), expected[row].empty()) << row;
+                EXPECT_EQ(error.substr(0, expected[row].size()), expected[row]) << row;
+            }
+            EXPECT_TRUE(batch.check_expression(3));
+            EXPECT_FALSE(batch.check_expression(4));
+        }
+    }
+
+    /**
+     * @brief Test that visit_row hands over the configuration of a row as its derived type.
+     *
+     */
+    void testVisitRow() {
+        write_binary_batch(this->filename, makeColumns());
+        BinaryBatchView batch(this->filename);
+        auto functions = ReaderBIN::parse_batch(batch);
+        ASSERT_EQ(functions.size(), 4);
+
+        std::vector<Method> methods;
+        for (size_t row = 0; row < batch.size(); ++row) {
+            ReaderBIN::visit_row(batch, functions, row, false, [&methods](auto& config) {
+                using Config = std::decay_t<decltype(config)>;
+                methods.push_back(config.method);
+                if constexpr (std::is_same_v<Config, NewtonConfig>) {
+                    EXPECT_DOUBLE_EQ(config.initial_guess, -1.0);
+                    EXPECT_DOUBLE_EQ(config.derivative(3.0), 6.0);
+                } else if constexpr (std::is_same_v<Config, BisectionConfig>) {
+                    EXPECT_DOUBLE_EQ(config.final_point, 3.0);
+                    EXPECT_EQ(config.max_iterations, 200);
+                } else if constexpr (std::is_same_v<Config, ChordsConfig>) {
+                    EXPECT_TRUE(config.aitken);
+                    EXPECT_DOUBLE_EQ(config.function(2.0), 0.0);
+                } else {
+                    EXPECT_DOUBLE_EQ(config.g_function(3.0), 9.0);
+                    EXPECT_DOUBLE_EQ(config.tolerance, 1e-8);
+                }
+            });
+        }
+        EXPECT_EQ(methods,
+                  (std::vector<Method>{Method::NEWTON, Method::BISECTION, Method::CHORDS, Method::FIXED_POINT}));
+    }
+};
+
+#endif  // READER_BIN_TESTER_HPP
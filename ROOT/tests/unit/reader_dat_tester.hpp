@@ -0,0 +1,35 @@
+#ifndef READER_DAT_TESTER_HPP
+#define READER_DAT_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "ROOT/reader.hpp"
+
+/**
+ * @brief Test fixture class for ReaderDAT unit tests.
+ *
+ */
+class ReaderDATTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test the parseSections method of ReaderDAT.
+     *
+     * @param content The DAT content to be split into sections.
+     * @param expected_names The expected section names, in order.
+     * @param expected The expected configuration map of each section, in order.
+     */
+    void testParseSections(const std::string& content, const std::vector<std::string>& expected_names,
+                           const std::vector<std::unordered_map<std::string, std::string>>& expected) {
+        std::istringstream input(content);
+        auto sections = ReaderDAT::parseSections(input);
+        ASSERT_EQ(sections.size(), expected_names.size());
+        for (size_t i = 0; i < sections.size(); ++i) {
+            EXPECT_EQ(sections[i].first, expected_names[i]);
+            EXPECT_EQ(sections[i].second, expected[i]);
+        }
+    }
+};
+
+#endif  // READER_DAT_TESTER_HPP
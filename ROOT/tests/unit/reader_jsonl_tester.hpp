@@ -0,0 +1,37 @@
+#ifndef READER_JSONL_TESTER_HPP
+#define READER_JSONL_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include "ROOT/reader.hpp"
+
+/**
+ * @brief Test fixture class for ReaderJSONL unit tests.
+ *
+ */
+class ReaderJSONLTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test the parseJsonObject method of ReaderJSONL on a valid object.
+     *
+     * @param line The input line holding one JSON object.
+     * @param expected The expected key-value pairs.
+     */
+    void testParseJsonObject(const std::string& line, const std::unordered_map<std::string, std::string>& expected) {
+        std::unordered_map<std::string, std::string> result;
+        EXPECT_TRUE(ReaderJSONL::parseJsonObject(line, result));
+        EXPECT_EQ(result, expected);
+    }
+
+    /**
+     * @brief Test that the parseJsonObject method of ReaderJSONL rejects a malformed object.
+     *
+     * @param line The input line holding a malformed JSON object.
+     */
+    void testParseJsonObjectFails(const std::string& line) {
+        std::unordered_map<std::string, std::string> result;
+        EXPECT_FALSE(ReaderJSONL::parseJsonObject(line, result));
+    }
+};
+
+#endif  // READER_JSONL_TESTER_HPP
@@ -0,0 +1,76 @@
+#ifndef READER_PIPE_TESTER_HPP
+#define READER_PIPE_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ROOT/reader.hpp"
+
+/**
+ * @brief Test fixture class for ReaderPipe unit tests.
+ *
+ */
+class ReaderPipeTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test that the read_next method of ReaderPipe returns the problems of a stream one at a time.
+     *
+     * @param format The format of the stream ("csv", "dat" or "jsonl").
+     * @param stream The content of the stream.
+     * @param expected_methods The expected method of each problem, in stream order.
+     * @param expected_names The expected name of each problem, in stream order.
+     */
+    void testReadNext(const std::string& format, const std::string& stream, const std::vector<Method>& expected_methods,
+                      const std::vector<std::string>& expected_names) {
+        std::istringstream input(stream);
+        ReaderPipe reader(input);
+        reader.csv_reader.sep = ',';
+        reader.csv_reader.quote = '"';
+        std::unique_ptr<ConfigBase> config;
+        std::string error;
+        for (size_t i = 0; i < expected_methods.size(); ++i) {
+            ASSERT_TRUE(reader.try_read_next(format, false, config, error)) << error;
+            ASSERT_NE(config, nullptr);
+            EXPECT_EQ(config->method, expected_methods[i]);
+            EXPECT_EQ(config->name, expected_names[i]);
+        }
+        ASSERT_TRUE(reader.try_read_next(format, false, config, error)) << error;
+        EXPECT_EQ(config, nullptr);
+    }
+
+    /**
+     * @brief Test that the malformed problems of a stream are rejected one by one, without ending the stream.
+     *
+     * @param format The format of the stream ("csv", "dat" or "jsonl").
+     * @param stream The content of the stream.
+     * @param expected_read Whether each problem, in stream order, is expected to be read or rejected.
+     * @param expected_errors A fragment of the error expected for each rejected problem, in stream order.
+     */
+    void testRejectsMalformed(const std::string& format, const std::string& stream,
+                              const std::vector<bool>& expected_read, const std::vector<std::string>& expected_errors) {
+        std::istringstream input(stream);
+        ReaderPipe reader(input);
+        reader.csv_reader.sep = ',';
+        reader.csv_reader.quote = '"';
+        std::unique_ptr<ConfigBase> config;
+        std::string error;
+        size_t rejected = 0;
+        for (bool read : expected_read) {
+            ASSERT_EQ(reader.try_read_next(format, false, config, error), read) << error;
+            if (read) {
+                EXPECT_NE(config, nullptr);
+            } else {
+                ASSERT_LT(rejected, expected_errors.size());
+                EXPECT_NE(error.find(expected_errors[rejected++]), std::string::npos) << error;
+            }
+        }
+        ASSERT_TRUE(reader.try_read_next(format, false, config, error)) << error;
+        EXPECT_EQ(config, nullptr);
+    }
+};
+
+#endif  // READER_PIPE_TESTER_HPP
@@ -0,0 +1,178 @@
+#ifndef RESULT_ARCHIVE_TESTER_HPP
+#define RESULT_ARCHIVE_TESTER_HPP
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <Eigen/Dense>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "ROOT/result_archive.hpp"
+
+/**
+ * @brief Test fixture class for the result archive unit tests.
+ *
+ */
+class ResultArchiveTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test that records are read back by position, with their trajectory stored row by row.
+     *
+     */
+    void testWriteRead() {
+        std::string filename = "test_results.rra";
+        Eigen::MatrixX2d results(3, 2);
+        results << 1, -3, 3, 5, 2, 0;
+        {
+            ResultArchiveWriter writer(filename, false);
+            writer.add(7, "quadratic", 0, 6, results, true);
+            writer.add(8, "", 1, 4, results, false);
+            EXPECT_EQ(writer.size(), 2U);
+        }
+
+        ResultArchiveReader reader(filename);
+        ASSERT_EQ(reader.size(), 2U);
+        ResultRecord first = reader.record(0);
+        EXPECT_EQ(first.header->id, 7U);
+        EXPECT_EQ(first.name, "quadratic");
+        EXPECT_EQ(first.header->iterations, 2);
+        EXPECT_EQ(first.header->evaluations, 6U);
+        EXPECT_EQ(first.header->root, 2);
+        EXPECT_EQ(first.header->f_root, 0);
+        ASSERT_EQ(first.trajectory.size(), 6U);
+        EXPECT_EQ(std::vector<double>(first.trajectory.begin(), first.trajectory.end()),
+                  std::vector<double>({1, -3, 3, 5, 2, 0}));
+        // records and trajectories stay aligned whatever the length of the names
+        EXPECT_EQ(reader.index[1] % 8, 0U);
+
+        ResultRecord second = reader.record(1);
+        EXPECT_EQ(second.header->id, 8U);
+        EXPECT_TRUE(second.name.empty());
+        EXPECT_TRUE(second.trajectory.empty());
+        EXPECT_EQ(result_record_json(second),
+                  R"({"id":8,"name":"","status":"max_iterations","root":2,"f_root":0,"iterations":2,)"
+                  R"("evaluations":4,"trajectory_rows":0})");
+        std::filesystem::remove(filename);
+    }
+
+    /**
+     * @brief Test that appending keeps the previous records and indexes the new ones after them.
+     *
+     */
+    void testAppend() {
+        std::string filename = "test_append.rra";
+        Eigen::MatrixX2d results(1, 2);
+        results << 4, 0;
+        {
+            ResultArchiveWriter writer(filename, true);  // a missing archive is created
+            writer.add(0, "first", 0, 1, results, true);
+        }
+        for (std::uint64_t id = 1; id < 3; ++id) {
+            ResultArchiveWriter writer(filename, true);
+            EXPECT_EQ(writer.size(), id);
+            writer.add(id, "appended", 0, 1, results, false);
+        }
+
+        ResultArchiveReader reader(filename);
+        ASSERT_EQ(reader.size(), 3U);
+        for (std::size_t i = 0; i < reader.size(); ++i) {
+            EXPECT_EQ(reader.record(i).header->id, i);
+        }
+        EXPECT_EQ(reader.record(0).name, "first");
+        EXPECT_EQ(reader.record(0).trajectory.size(), 2U);
+        EXPECT_EQ(reader.record(2).name, "appended");
+
+        // overwriting drops the previous records
+        {
+            ResultArchiveWriter writer(filename, false);
+        }
+        EXPECT_EQ(ResultArchiveReader(filename).size(), 0U);
+        std::filesystem::remove(filename);
+    }
+
+    /**
+     * @brief Test that an append interrupted before the index is written leaves the previous archive readable.
+     *
+     */
+    void testInterruptedAppend() {
+        std::string filename = "test_interrupted.rra";
+        Eigen::MatrixX2d results(1, 2);
+        results << 4, 0;
+        {
+            ResultArchiveWriter writer(filename, false);
+            writer.add(0, "kept", 0, 1, results, true);
+            writer.add(1, "kept", 0, 1, results, true);
+        }
+
+        // the child process dies while appending, without running any destructor
+        pid_t child = ::fork();
+        if (child == 0) {
+            ResultArchiveWriter writer(filename, true);
+            for (std::uint64_t id = 2; id < 100; ++id) {
+                writer.add(id, "lost", 0, 1, results, true);
+            }
+            ::_exit(0);
+        }
+        ASSERT_GT(child, 0);
+        ::waitpid(child, nullptr, 0);
+
+        {
+            ResultArchiveReader reader(filename);
+            ASSERT_EQ(reader.size(), 2U);
+            for (std::size_t i = 0; i < reader.size(); ++i) {
+                EXPECT_EQ(reader.record(i).header->id, i);
+                EXPECT_EQ(reader.record(i).name, "kept");
+            }
+        }
+
+        // the next append replaces the leftovers of the interrupted one
+        {
+            ResultArchiveWriter writer(filename, true);
+            writer.add(2, "appended", 0, 1, results, false);
+            // nothing is visible before the writer is closed
+            EXPECT_EQ(ResultArchiveReader(filename).size(), 2U);
+        }
+        EXPECT_EQ(ResultArchiveReader(filename).size(), 3U);
+        EXPECT_FALSE(std::filesystem::exists(filename + ".part"));
+        std::filesystem::remove(filename);
+    }
+
+    /**
+     * @brief Test that merged shards hold the records of every shard, in order, with their identifiers.
+     *
+     */
+    void testMerge() {
+        std::vector<std::string> shards = {"test_shard0.rra", "test_shard1.rra"};
+        std::string merged = "test_merged.rra";
+        Eigen::MatrixX2d results(2, 2);
+        results << 1, 1, 0.5, 0;
+        for (std::uint64_t shard = 0; shard < shards.size(); ++shard) {
+            ResultArchiveWriter writer(shards[shard], false);
+            for (std::uint64_t id = shard; id < 6; id += shards.size()) {
+                writer.add(id, "problem" + std::to_string(id), 0, 2, results, id % 3 == 0);
+            }
+        }
+        merge_result_archives(merged, shards);
+
+        ResultArchiveReader reader(merged);
+        ASSERT_EQ(reader.size(), 6U);
+        std::vector<std::uint64_t> ids;
+        for (std::size_t i = 0; i < reader.size(); ++i) {
+            ResultRecord record = reader.record(i);
+            ids.push_back(record.header->id);
+            EXPECT_EQ(record.name, "problem" + std::to_string(record.header->id));
+            EXPECT_EQ(record.trajectory.size(), record.header->id % 3 == 0 ? 4U : 0U);
+        }
+        EXPECT_EQ(ids, std::vector<std::uint64_t>({0, 2, 4, 1, 3, 5}));
+
+        for (const auto& shard : shards) {
+            std::filesystem::remove(shard);
+        }
+        std::filesystem::remove(merged);
+    }
+};
+
+#endif  // RESULT_ARCHIVE_TESTER_HPP
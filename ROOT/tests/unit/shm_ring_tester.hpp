@@ -0,0 +1,100 @@
+#ifndef SHM_RING_TESTER_HPP
+#define SHM_RING_TESTER_HPP
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "ROOT/shm_ring.hpp"
+
+/**
+ * @brief Test fixture class for the shared-memory ring unit tests.
+ *
+ */
+class ShmRingTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test that a server answers every request of a client, in order, through the rings.
+     *
+     * @param capacity The number of slots of each ring (smaller than requests to exercise full rings).
+     * @param requests The number of requests to send.
+     */
+    void testRoundTrip(std::uint32_t capacity, int requests) {
+        std::string name = "/root-test-ring";
+        ShmServer server(name, capacity, [](const ShmRequest& request) {
+            return ShmResult{request.id, request.first * 2, request.second, request.max_iterations, SHM_SOLVED};
+        });
+        EXPECT_EQ(server.segment.header().capacity & (server.segment.header().capacity - 1), 0U);
+        std::thread server_thread([&server] { server.serve(); });
+
+        ShmClient client(name);
+        int sent = 0;
+        int received = 0;
+        ShmResult result{};
+        while (received < requests) {
+            if (sent < requests) {
+                ShmRequest request{};
+                request.id = static_cast<std::uint64_t>(sent);
+                request.first = sent;
+                request.max_iterations = sent % 7;
+                if (client.try_submit(request)) {
+                    ++sent;
+                    continue;
+                }
+            }
+            ASSERT_TRUE(client.receive(result));
+            EXPECT_EQ(result.id, static_cast<std::uint64_t>(received));
+            EXPECT_DOUBLE_EQ(result.root, 2.0 * received);
+            EXPECT_EQ(result.iterations, received % 7);
+            ++received;
+        }
+        EXPECT_FALSE(client.try_receive(result));
+        client.stop();
+        server_thread.join();
+        // the server stopped: waiting for another result returns instead of hanging
+        EXPECT_FALSE(client.receive(result));
+    }
+
+    /**
+     * @brief Test that a waiting client gives up on timeout and when the server process is gone.
+     *
+     */
+    void testReceiveGivesUp() {
+        std::string name = "/root-test-ring-dead";
+        ShmServer server(name, 4, [](const ShmRequest& request) { return ShmResult{request.id, 0, 0, 0, SHM_SOLVED}; });
+        ShmClient client(name);
+        ShmResult result{};
+        // nobody serves the segment yet, but the process that created it is alive
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_FALSE(client.receive(result, std::chrono::milliseconds(50)));
+        EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+
+        // pretend that the segment was created by a process which has exited since
+        pid_t child = ::fork();
+        if (child == 0) {
+            ::_exit(0);
+        }
+        ASSERT_GT(child, 0);
+        ::waitpid(child, nullptr, 0);
+        server.segment.header().server.store(child);
+        EXPECT_FALSE(client.receive(result));
+    }
+
+    /**
+     * @brief Test that expressions are only copied into a request field when they fit.
+     *
+     */
+    void testSetExpression() {
+        ShmRequest request{};
+        EXPECT_TRUE(shm_set_expression(request.function, "x^2-4"));
+        EXPECT_STREQ(request.function, "x^2-4");
+        EXPECT_TRUE(shm_set_expression(request.function, std::string(shm_expression_size - 1, 'x')));
+        EXPECT_FALSE(shm_set_expression(request.function, std::string(shm_expression_size, 'x')));
+    }
+};
+
+#endif  // SHM_RING_TESTER_HPP
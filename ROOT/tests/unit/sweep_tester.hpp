@@ -0,0 +1,123 @@
+#ifndef SWEEP_TESTER_HPP
+#define SWEEP_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ROOT/sweep.hpp"
+
+/**
+ * @brief Test fixture class for the parameter sweep unit tests.
+ *
+ */
+class SweepTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test the parsing of valid and invalid ranges and parameters.
+     *
+     */
+    void testParseRange() {
+        SweepRange range;
+        EXPECT_TRUE(parse_sweep_range(" p = 0:10:0.5 ", range));
+        EXPECT_EQ(range.name, "p");
+        EXPECT_EQ(range.size(), 21U);
+        EXPECT_DOUBLE_EQ(range.value(20), 10.0);
+        EXPECT_TRUE(parse_sweep_range("p=0:10:0.001", range));
+        EXPECT_EQ(range.size(), 10001U);
+        EXPECT_TRUE(parse_sweep_range("t_1=1:0:-0.25", range));
+        EXPECT_EQ(range.size(), 5U);
+        EXPECT_DOUBLE_EQ(range.value(4), 0.0);
+        for (const std::string invalid : {"x=0:1:0.1", "sinp=0:1:1", "p=0:1:0", "p=0:1:-1", "p=0:1", "=0:1:1",
+                                          "1p=0:1:1", "p=0:a:1", "p 0:1:1"}) {
+            EXPECT_FALSE(parse_sweep_range(invalid, range)) << invalid;
+        }
+        // an invalid description leaves the range untouched
+        EXPECT_EQ(range.name, "t_1");
+
+        std::string name;
+        double value = 0.0;
+        EXPECT_TRUE(parse_sweep_parameter("a = -2.5", name, value));
+        EXPECT_EQ(name, "a");
+        EXPECT_DOUBLE_EQ(value, -2.5);
+        EXPECT_FALSE(parse_sweep_parameter("a=", name, value));
+        EXPECT_FALSE(parse_sweep_parameter("cosa=1", name, value));
+    }
+
+    /**
+     * @brief Test the seeds placed from the previous roots by every method.
+     *
+     */
+    void testWarmStart() {
+        SweepSeed cold{0.0, 10.0};
+        auto function = [](double x) { return x - 2.1; };
+
+        EXPECT_DOUBLE_EQ(warm_start(Method::NEWTON, cold, {}, function).first, 0.0);
+        EXPECT_DOUBLE_EQ(warm_start(Method::NEWTON, cold, {1.0, 1.5}, function).first, 2.0);
+        EXPECT_DOUBLE_EQ(warm_start(Method::FIXED_POINT, cold, {1.5}, function).first, 1.5);
+
+        SweepSeed chords = warm_start(Method::CHORDS, cold, {1.0, 1.5}, function);
+        EXPECT_DOUBLE_EQ(chords.first, 1.5);
+        EXPECT_DOUBLE_EQ(chords.second, 2.0);
+        // a single root gives no slope, the first point is moved aside to keep the first chord defined
+        chords = warm_start(Method::CHORDS, cold, {1.5}, function);
+        EXPECT_DOUBLE_EQ(chords.second, 1.5);
+        EXPECT_LT(chords.first, 1.5);
+
+        SweepSeed bisection = warm_start(Method::BISECTION, cold, {1.0, 1.5}, function);
+        EXPECT_LE(bisection.first, 2.1);
+        EXPECT_GE(bisection.second, 2.1);
+        EXPECT_LE(bisection.second - bisection.first, 1.0);
+        EXPECT_GT(bisection.evaluations, 0);
+        // without a sign change near the prediction, the interval given by the user is kept
+        bisection = warm_start(Method::BISECTION, cold, {1.0, 1.5}, [](double x) { return x * x + 1.0; });
+        EXPECT_DOUBLE_EQ(bisection.first, 0.0);
+        EXPECT_DOUBLE_EQ(bisection.second, 10.0);
+    }
+
+    /**
+     * @brief Test a sweep of x^2 - p = 0 solved by a Newton iteration, with and without warm starts.
+     *
+     * @param jobs The number of threads of the warm sweep.
+     */
+    void testRunSweep(std::size_t jobs) {
+        SweepRange range{"p", 1.0, 100.0, 0.5};
+        auto make_problem = [] {
+            SweepProblem problem;
+            problem.parameter = std::make_shared<double>(0.0);
+            problem.function = [parameter = problem.parameter](double x) { return x * x - *parameter; };
+            problem.solve = [function = problem.function](const SweepSeed& seed) {
+                SweepPoint point;
+                point.root = seed.first;
+                while (std::abs(function(point.root)) > 1e-10 && point.iterations < 100) {
+                    point.root -= function(point.root) / (2 * point.root);
+                    ++point.iterations;
+                }
+                point.residual = std::abs(function(point.root));
+                point.status = point.iterations < 100 ? SolverStatus::CONVERGED : SolverStatus::MAX_ITERATIONS;
+                return point;
+            };
+            return problem;
+        };
+
+        std::vector<SweepPoint> cold = run_sweep(range, Method::NEWTON, {1.0, 0.0}, false, 1, make_problem);
+        std::vector<SweepPoint> warm = run_sweep(range, Method::NEWTON, {1.0, 0.0}, true, jobs, make_problem);
+        ASSERT_EQ(cold.size(), range.size());
+        ASSERT_EQ(warm.size(), range.size());
+        int cold_iterations = 0;
+        int warm_iterations = 0;
+        for (std::size_t i = 0; i < range.size(); ++i) {
+            EXPECT_DOUBLE_EQ(warm[i].parameter, range.value(i));
+            EXPECT_EQ(warm[i].status, SolverStatus::CONVERGED);
+            EXPECT_NEAR(warm[i].root, std::sqrt(range.value(i)), 1e-9);
+            cold_iterations += cold[i].iterations;
+            warm_iterations += warm[i].iterations;
+        }
+        EXPECT_LT(2 * warm_iterations, cold_iterations);
+    }
+};
+
+#endif  // SWEEP_TESTER_HPP
@@ -0,0 +1,15 @@
+#include <gtest/gtest.h>
+
+#include "async_writer_tester.hpp"
+
+TEST_F(AsyncWriterTester, QueueFull) {
+    testQueueFull(1);
+    testQueueFull(5);
+    testQueueFull(64);
+}
+
+TEST_F(AsyncWriterTester, RunsEveryJob) {
+    testRunsEveryJob(1, 1, 100);
+    testRunsEveryJob(2, 4, 1000);
+    testRunsEveryJob(64, 8, 500);
+}
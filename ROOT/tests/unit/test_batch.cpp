@@ -0,0 +1,14 @@
+#include <gtest/gtest.h>
+
+#include "batch_tester.hpp"
+
+TEST_F(BatchTester, ParseShard) { testParseShard(); }
+
+TEST_F(BatchTester, ShardsCoverBatch) {
+    testShardsCoverBatch(100, 1, 4);
+    testShardsCoverBatch(100, 3, 4);
+    testShardsCoverBatch(2, 5, 2);
+    testShardsCoverBatch(0, 1, 1);
+}
+
+TEST_F(BatchTester, SummaryRows) { testSummaryRows(); }
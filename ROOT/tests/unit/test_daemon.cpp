@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include "daemon_tester.hpp"
+#include "thread_pool_tester.hpp"
+
+TEST_F(ThreadPoolTester, RunsEveryTask) {
+    testRunsEveryTask(1, 10);
+    testRunsEveryTask(4, 1000);
+    testRunsEveryTask(0, 3);
+}
+
+TEST_F(SolverDaemonTester, FrameRoundTrip) {
+    testFrameRoundTrip({"", "{\"method\": \"newton\"}", std::string(100000, 'x')});
+}
+
+TEST_F(SolverDaemonTester, ServeConcurrentConnections) { testServe(4, 50); }
+
+TEST_F(SolverDaemonTester, ServeMoreConnectionsThanThreads) { testMoreConnectionsThanThreads(2, 6, 3); }
+
+TEST_F(SolverDaemonTester, RejectsBadRequests) {
+    testRejectsBadRequests({
+        R"({"method": "newton")",
+        R"({"function": "x^2-4"})",
+        R"({"function": "x^2-4", "method": "unknown"})",
+        R"({"function": "x^2-4", "method": "muller", "x0": 0, "x1": 1})",
+        R"({"function": "x^2+y", "method": "chords", "x0": 1, "x1": 3})",
+        R"({"function": "x^2-4", "method": "newton", "derivative": "2*x"})",
+        R"({"function": "x^2-4", "method": "newton", "initial": "one", "derivative": "2*x"})",
+        R"({"function": "x^2-4", "method": "newton", "initial": 1, "derivative": "2*z"})",
+        R"({"function": "x^2-4", "method": "bisection", "interval_a": 3, "interval_b": 4})",
+        R"({"function": "x^2-4", "method": "chords", "x0": 1, "tolerance": "tight"})",
+    });
+}
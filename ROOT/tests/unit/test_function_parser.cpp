@@ -2,6 +2,7 @@
 
 #include <cmath>
 
+#include "function_cache_tester.hpp"
 #include "function_parser_base_tester.hpp"
 
 TEST_F(FunctionParserBaseTester, IsPolynomial) {
@@ -58,3 +59,30 @@ TEST_F(FunctionParserBaseTester, ParseFunction) {
         testParseFunction("-2*sin(x) + 3*cos(x)", expected, 0.0, 5e-6);
     }
 }
+
+TEST_F(FunctionParserBaseTester, ParseFunctionWithParameters) {
+    testParseFunctionWithParameters(
+        "a*x^2 - p", [](double x, double a, double p) { return a * x * x - p; }, 1.5);
+    testParseFunctionWithParameters(
+        "2*a*x - 3*p + a*p + 1", [](double x, double a, double p) { return 2 * a * x - 3 * p + a * p + 1; }, 1.5);
+    testParseFunctionWithParameters(
+        "a*sin(x) - p*cos(x)", [](double x, double a, double p) { return a * std::sin(x) - p * std::cos(x); }, 0.7);
+}
+
+TEST_F(FunctionParserBaseTester, TryParseFunction) {
+    testTryParseFunction("x^2-4", true);
+    testTryParseFunction("2*sin(x) - cos(x)", true);
+    testTryParseFunction("x^2+y", false);
+    testTryParseFunction("sin(x) + y", false);
+    testTryParseFunction("exp(x)", false);
+    testTryParseFunction("", false);
+}
+
+TEST_F(FunctionParserBaseTester, ParseFunctionPrecision) { testParseFunctionPrecision(); }
+
+TEST_F(FunctionParserBaseTester, ParseFunctionComplex) { testParseFunctionComplex(); }
+
+TEST_F(FunctionCacheTester, Get) {
+    testGet({"x^2-4", "2*x", "x^2-4", "sin(x)", "2*x"}, 3, 1.5);
+    testGet({}, 0, 0.0);
+}
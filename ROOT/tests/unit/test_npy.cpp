@@ -0,0 +1,13 @@
+#include <gtest/gtest.h>
+
+#include "npy_tester.hpp"
+
+TEST_F(NpyTester, Header) {
+    testHeader({3, 2}, "{'descr': '<f8', 'fortran_order': False, 'shape': (3, 2), }");
+    testHeader({7}, "{'descr': '<f8', 'fortran_order': False, 'shape': (7,), }");
+    testHeader({}, "{'descr': '<f8', 'fortran_order': False, 'shape': (), }");
+}
+
+TEST_F(NpyTester, Crc32) { testCrc32(); }
+
+TEST_F(NpyTester, Archive) { testArchive(); }
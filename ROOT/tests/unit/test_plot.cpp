@@ -0,0 +1,12 @@
+#include <gtest/gtest.h>
+
+#include "plot_tester.hpp"
+
+TEST_F(ConvergencePlotTester, PngEncode) {
+    testPngEncode(3, 2);
+    testPngEncode(1000, 800);
+}
+
+TEST_F(ConvergencePlotTester, Frame) { testFrame(); }
+
+TEST_F(ConvergencePlotTester, WriteSvg) { testWriteSvg(); }
@@ -0,0 +1,11 @@
+#include <gtest/gtest.h>
+
+#include "portfolio_tester.hpp"
+
+TEST_F(PortfolioTester, MethodNames) { testMethodNames(); }
+
+TEST_F(PortfolioTester, RaceCancelsLosers) { testRaceCancelsLosers(); }
+
+TEST_F(PortfolioTester, RaceWithoutWinner) { testRaceWithoutWinner(); }
+
+TEST_F(PortfolioTester, SummaryRows) { testSummaryRows(); }
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
 #include "reader_base_tester.hpp"
+#include "reader_bin_tester.hpp"
 #include "reader_csv_tester.hpp"
+#include "reader_dat_tester.hpp"
+#include "reader_jsonl_tester.hpp"
+#include "reader_pipe_tester.hpp"
 
 TEST_F(ReaderBaseTester, Trim) {
     testTrim(("  hello world  "), "hello world");
@@ -39,6 +43,7 @@ TEST_F(ReaderBaseTester, MethodParsing) {
     testParseMethod("fixed_point", Method::FIXED_POINT);
     testParseMethod("newton", Method::NEWTON);
     testParseMethod("chords", Method::CHORDS);
+    testParseMethod("muller", Method::MULLER);
 }
 
 TEST_F(ReaderCSVTester, SplitCsvLine) {
@@ -51,3 +56,94 @@ TEST_F(ReaderCSVTester, SplitCsvLine) {
     testSplitCsvLine("'value; with; semicolons';value2;'value3'", {"value; with; semicolons", "value2", "value3"}, ';',
                      '\'');
 }
+
+TEST_F(ReaderDATTester, ParseSingleProblem) {
+    testParseSections("function = x^2-4\nmethod = newton\n\n# comment\ninitial = -1\n", {""},
+                      {{{"function", "x^2-4"}, {"method", "newton"}, {"initial", "-1"}}});
+}
+
+TEST_F(ReaderDATTester, ParseSectionsWithGlobalDefaults) {
+    testParseSections(
+        "tolerance = 1e-5\nmethod = newton\n\n[first]\nfunction = x^2-4\ninitial = 1\n\n[second]\nmethod = "
+        "chords\nfunction = x^3-8\ntolerance = 1e-8\n",
+        {"first", "second"},
+        {{{"tolerance", "1e-5"}, {"method", "newton"}, {"function", "x^2-4"}, {"initial", "1"}},
+         {{"tolerance", "1e-8"}, {"method", "chords"}, {"function", "x^3-8"}}});
+}
+
+TEST_F(ReaderBINTester, RoundTrip) { testRoundTrip(); }
+
+TEST_F(ReaderBINTester, MakeConfigs) { testMakeConfigs(); }
+
+TEST_F(ReaderBINTester, CheckRow) { testCheckRow(); }
+
+TEST_F(ReaderBINTester, VisitRow) { testVisitRow(); }
+
+TEST_F(ReaderJSONLTester, ParseJsonObject) {
+    testParseJsonObject(R"({"function": "x^2-4", "method": "newton", "initial": -1, "derivative": "2*x"})",
+                        {{"function", "x^2-4"}, {"method", "newton"}, {"initial", "-1"}, {"derivative", "2*x"}});
+    testParseJsonObject(R"(  {"Tolerance":1e-5,"aitken":true,"name":null}  )",
+                        {{"tolerance", "1e-5"}, {"aitken", "true"}});
+    testParseJsonObject(R"({"name": "quoted \"name\"\té"})", {{"name", "quoted \"name\"\t\xc3\xa9"}});
+    testParseJsonObject("{}", {});
+}
+
+TEST_F(ReaderJSONLTester, ParseMalformedJsonObject) {
+    testParseJsonObjectFails(R"({"function": "x^2-4")");
+    testParseJsonObjectFails(R"({"function" "x^2-4"})");
+    testParseJsonObjectFails(R"({"interval": [1, 2]})");
+    testParseJsonObjectFails(R"({"initial": one})");
+    testParseJsonObjectFails(R"({"initial": 1} trailing)");
+}
+
+TEST_F(ReaderPipeTester, ReadCsvStream) {
+    testReadNext("csv",
+                 "method,function,derivative,initial,x0,x1\n"
+                 "newton,x^2-4,2*x,1,,\n"
+                 "\n"
+                 "chords,x^3-8,,,1,3\n",
+                 {Method::NEWTON, Method::CHORDS}, {"", ""});
+}
+
+TEST_F(ReaderPipeTester, ReadDatStream) {
+    // the global defaults are inherited by every section, and empty lines do not end a section
+    testReadNext("dat",
+                 "function = x^3-8\n"
+                 "[first]\nmethod = newton\n\nderivative = 3*x^2\ninitial = 1\n"
+                 "[second]\nmethod = chords\nx0 = 1\n\nx1 = 3\n",
+                 {Method::NEWTON, Method::CHORDS}, {"first", "second"});
+    testReadNext("dat", "method = bisection\nfunction = x-1\n\ninterval_a = 0\ninterval_b = 2\n", {Method::BISECTION},
+                 {""});
+}
+
+TEST_F(ReaderPipeTester, ReadJsonlStream) {
+    testReadNext("jsonl",
+                 "{\"method\": \"newton\", \"function\": \"x^2-4\", \"derivative\": \"2*x\", \"initial\": 1}\n"
+                 "{\"name\": \"cube\", \"method\": \"chords\", \"function\": \"x^3-8\", \"x0\": 1, \"x1\": 3}\n",
+                 {Method::NEWTON, Method::CHORDS}, {"", "cube"});
+}
+
+TEST_F(ReaderPipeTester, RejectsMalformedProblems) {
+    testRejectsMalformed("jsonl",
+                         "{\"method\": \"newton\", \"function\": \"x^2-4\", \"derivative\": \"2*x\", \"initial\": 1}\n"
+                         "{\"method\": \"bogus\", \"function\": \"x^2-4\"}\n"
+                         "{\"method\": \"newton\"\n"
+                         "{\"method\": \"chords\", \"function\": \"x^3-8\", \"x0\": 1, \"x1\": 3}\n",
+                         {true, false, false, true}, {"line 2: unknown method: bogus", "line 3: malformed JSON"});
+    testRejectsMalformed("csv",
+                         "method,function,x0,x1\n"
+                         "chords,x^3-8,1,3\n"
+                         "chords,x^3-8,1\n"
+                         "chords,sin(,1,3\n"
+                         "chords,x^2-4,1,3\n",
+                         {true, false, false, true}, {"line 3: header/value columns mismatch", "line 4:"});
+    testRejectsMalformed("dat",
+                         "max-iterations = 50\ntolerance 1e-5\n"
+                         "[bad]\nmethod = chords\nfunction x^3-8\nx0 = 1\nx1 = 3\n"
+                         "[good]\nmethod = chords\nfunction = x^3-8\nx0 = 1\n\nx1 = 3\n"
+                         "[incomplete]\nmethod = newton\nfunction = x^2-4\n"
+                         "[broken\nmethod = chords\n",
+                         {false, false, true, false, false},
+                         {"malformed line 2", "malformed line 5", "section [incomplete]: newton requires initial",
+                          "malformed section header on line 17"});
+}
@@ -0,0 +1,11 @@
+#include <gtest/gtest.h>
+
+#include "result_archive_tester.hpp"
+
+TEST_F(ResultArchiveTester, WriteRead) { testWriteRead(); }
+
+TEST_F(ResultArchiveTester, Append) { testAppend(); }
+
+TEST_F(ResultArchiveTester, InterruptedAppend) { testInterruptedAppend(); }
+
+TEST_F(ResultArchiveTester, Merge) { testMerge(); }
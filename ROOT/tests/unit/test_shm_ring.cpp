@@ -0,0 +1,12 @@
+#include <gtest/gtest.h>
+
+#include "shm_ring_tester.hpp"
+
+TEST_F(ShmRingTester, RoundTrip) {
+    testRoundTrip(8, 1000);
+    testRoundTrip(1000, 100);
+}
+
+TEST_F(ShmRingTester, SetExpression) { testSetExpression(); }
+
+TEST_F(ShmRingTester, ReceiveGivesUp) { testReceiveGivesUp(); }
@@ -0,0 +1,12 @@
+#include <gtest/gtest.h>
+
+#include "sweep_tester.hpp"
+
+TEST_F(SweepTester, ParseRange) { testParseRange(); }
+
+TEST_F(SweepTester, WarmStart) { testWarmStart(); }
+
+TEST_F(SweepTester, RunSweep) {
+    testRunSweep(1);
+    testRunSweep(4);
+}
@@ -61,3 +61,86 @@ TEST_F(WriterBaseTester, WriteGNUPLOT) {
 
     this->testWrite(values, WritingMethod::GNUPLOT);
 }
+
+TEST_F(WriterBaseTester, BuildPrinterJSONL) {
+    Eigen::MatrixX2d values(3, 2);
+    values << 0, 1, 1, 0, 2, -1;
+
+    std::unique_ptr<PrinterBase<Eigen::Vector2d>> printer;
+    this->testBuildPrinter(values, WritingMethod::JSONL, printer);
+}
+
+TEST_F(WriterBaseTester, WriteJSONL) {
+    Eigen::MatrixX2d values(3, 2);
+    values << 0, 1, 1, 0, 2, -1;
+
+    this->testWrite(values, WritingMethod::JSONL);
+}
+
+TEST_F(WriterBaseTester, WriteJSONLContent) {
+    Eigen::MatrixX2d values(3, 2);
+    values << 0.1, 1, 1, 0, 2, -1e-300;
+
+    this->testWriteJSONLContent(
+        values, R"({"trajectory":[[0.1,1],[1,0],[2,-1e-300]],"root":2,"f_root":-1e-300,"iterations":2})");
+}
+
+TEST_F(WriterBaseTester, WriteCSVContent) {
+    Eigen::MatrixX2d values(3, 2);
+    values << 0.1, 1, 1.0 / 3.0, 0, 2, -1e-300;
+
+    // every number is written in the shortest form which reads back to the same double
+    this->testWriteFileContent(values, WritingMethod::CSV, "output.csv",
+                               {"0.1,1", "0.3333333333333333,0", "2,-1e-300"});
+}
+
+TEST_F(WriterBaseTester, WriteDATContent) {
+    Eigen::MatrixX2d values(10000, 2);
+    for (int i = 0; i < values.rows(); ++i) {
+        values(i, 0) = i + 0.5;
+        values(i, 1) = -i;
+    }
+
+    // enough rows to write the buffer on the file more than once
+    std::vector<std::string> expected;
+    for (int i = 0; i < values.rows(); ++i) {
+        expected.push_back(std::to_string(i) + ".5 " + std::to_string(-i));
+    }
+    this->testWriteFileContent(values, WritingMethod::DAT, "output.dat", expected);
+}
+
+TEST_F(WriterBaseTester, BuildPrinterNPY) {
+    Eigen::MatrixX2d values(3, 2);
+    values << 0, 1, 1, 0, 2, -1;
+
+    std::unique_ptr<PrinterBase<Eigen::Vector2d>> printer;
+    this->testBuildPrinter(values, WritingMethod::NPY, printer);
+}
+
+TEST_F(WriterBaseTester, WriteNPY) {
+    Eigen::MatrixX2d values(3, 2);
+    values << 0, 1, 1, 0, 2, -1;
+
+    this->testWrite(values, WritingMethod::NPY);
+}
+
+TEST_F(WriterBaseTester, WriteNPYContent) {
+    Eigen::MatrixX2d values(3, 2);
+    values << 0.1, 1, 1.0 / 3.0, 0, 2, -1e-300;
+
+    this->testWriteNPYContent(values, "{'descr': '<f8', 'fortran_order': False, 'shape': (3, 2), }");
+}
+
+TEST_F(WriterBaseTester, WriteSinks) {
+    Eigen::MatrixX2d values(3, 2);
+    values << 0.1, 1, 1.0 / 3.0, 0, 2, -1e-300;
+
+    this->testWriteSinks(values);
+}
+
+TEST_F(WriterBaseTester, BorrowValues) {
+    Eigen::MatrixX2d values(3, 2);
+    values << 0, 1, 1, 0, 2, -1;
+
+    this->testBorrowValues(values);
+}
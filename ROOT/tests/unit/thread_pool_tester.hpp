@@ -0,0 +1,35 @@
+#ifndef THREAD_POOL_TESTER_HPP
+#define THREAD_POOL_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "ROOT/thread_pool.hpp"
+
+/**
+ * @brief Test fixture class for ThreadPool unit tests.
+ *
+ */
+class ThreadPoolTester : public ::testing::Test {
+  public:
+    /**
+     * @brief Test that every submitted task runs before the pool is destroyed.
+     *
+     * @param threads The number of worker threads.
+     * @param tasks The number of tasks to submit.
+     */
+    void testRunsEveryTask(std::size_t threads, int tasks) {
+        std::atomic<int> done = 0;
+        {
+            ThreadPool pool(threads);
+            EXPECT_EQ(pool.size(), threads == 0 ? 1 : threads);
+            for (int i = 0; i < tasks; ++i) {
+                pool.submit([&done] { ++done; });
+            }
+        }
+        EXPECT_EQ(done, tasks);
+    }
+};
+
+#endif  // THREAD_POOL_TESTER_HPP
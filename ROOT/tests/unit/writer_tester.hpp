@@ -11,8 +11,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
 
 #include "ROOT/writer.hpp"
 
@@ -20,12 +24,40 @@
  * @brief Tester class for Writer class unit tests
  */
 class WriterBaseTester : public ::testing::Test {
+  protected:
+    /**
+     * @brief Creates a directory for the files of the test, named after the test so that tests can run in parallel.
+     *
+     */
+    void SetUp() override {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        this->directory = std::filesystem::temp_directory_path() /
+                          ("root_" + std::string(info->test_suite_name()) + "_" + info->name());
+        std::filesystem::create_directories(this->directory);
+    }
+
+    /**
+     * @brief Removes the directory of the test with every file written in it.
+     *
+     */
+    void TearDown() override { std::filesystem::remove_all(this->directory); }
+
+    /**
+     * @brief Path of a file in the directory of the test.
+     *
+     * @param name The name of the file.
+     * @return The path of the file.
+     */
+    std::string path(const std::string& name) const { return (this->directory / name).string(); }
+
+    std::filesystem::path directory;  //!< Directory of the files written by the test
+
   public:
     template <typename T>
     void testBuildPrinter(const T& values, WritingMethod method,
                           std::unique_ptr<PrinterBase<Eigen::Vector2d>>& printer) {
         Writer<T> writer(values, method);
-        writer.build_printer(printer);
+        writer.build_printer(writer.sinks.front(), printer);
 
         switch (method) {
             case WritingMethod::CONSOLE:
@@ -40,6 +72,12 @@ class WriterBaseTester : public ::testing::Test {
             case WritingMethod::GNUPLOT:
                 EXPECT_NE(dynamic_cast<PrinterGNUPlot<Eigen::Vector2d>*>(printer.get()), nullptr);
                 break;
+            case WritingMethod::JSONL:
+                EXPECT_NE(dynamic_cast<PrinterJSONL<Eigen::Vector2d>*>(printer.get()), nullptr);
+                break;
+            case WritingMethod::NPY:
+                EXPECT_NE(dynamic_cast<PrinterNPY<Eigen::Vector2d>*>(printer.get()), nullptr);
+                break;
             default:
                 FAIL() << "Unknown WritingMethod";
         }
@@ -47,7 +85,7 @@ class WriterBaseTester : public ::testing::Test {
 
     template <typename T>
     void testWrite(const T& values, WritingMethod method) {
-        Writer<T> writer(values, method);
+        Writer<T> writer(values, method, this->path("output"));
         writer.write();
         EXPECT_NO_THROW(writer.write());
         // check if the method is CLI it is written on CLI
@@ -57,27 +95,141 @@ class WriterBaseTester : public ::testing::Test {
                 break;
             case WritingMethod::CSV:
                 // check if the method is CSV file is created
-                EXPECT_TRUE(std::filesystem::exists("output.csv"));
-                std::filesystem::remove("output.csv");
+                EXPECT_TRUE(std::filesystem::exists(this->path("output.csv")));
                 break;
             case WritingMethod::DAT:
                 // check if the method is DAT file is created
-                EXPECT_TRUE(std::filesystem::exists("output.dat"));
-                std::filesystem::remove("output.dat");
+                EXPECT_TRUE(std::filesystem::exists(this->path("output.dat")));
                 break;
             case WritingMethod::GNUPLOT:
                 // check if the method is GNUPLOT file is created and gnuplot script is generated
-                EXPECT_TRUE(std::filesystem::exists("output.dat"));
-                std::filesystem::remove("output.dat");
-                EXPECT_TRUE(std::filesystem::exists("output.plt"));
-                std::filesystem::remove("output.plt");
-                EXPECT_TRUE(std::filesystem::exists("output.png"));
-                std::filesystem::remove("output.png");
+                EXPECT_TRUE(std::filesystem::exists(this->path("output.dat")));
+                EXPECT_TRUE(std::filesystem::exists(this->path("output.plt")));
+                EXPECT_TRUE(std::filesystem::exists(this->path("output.png")));
+                break;
+            case WritingMethod::JSONL:
+                // check if the method is JSONL file is created
+                EXPECT_TRUE(std::filesystem::exists(this->path("output.jsonl")));
+                break;
+            case WritingMethod::NPY:
+                // check if the method is NPY file is created
+                EXPECT_TRUE(std::filesystem::exists(this->path("output.npy")));
                 break;
             default:
                 FAIL() << "Unknown WritingMethod";
         }
     }
+
+    template <typename T>
+    void testWriteFileContent(const T& values, WritingMethod method, const std::string& output_file,
+                              const std::vector<std::string>& expected_lines) {
+        {
+            Writer<T> writer(values, method, this->path("output"));
+            writer.write();
+        }
+        std::ifstream file(this->path(output_file));
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(file, line);) {
+            lines.push_back(line);
+        }
+        EXPECT_EQ(lines, expected_lines);
+    }
+
+    template <typename T>
+    void testWriteJSONLContent(const T& values, const std::string& expected_line) {
+        {
+            Writer<T> writer(values, WritingMethod::JSONL, this->path("output"));
+            writer.write();
+        }
+        {
+            // appending adds a second object on the following line
+            Writer<T> writer(values, WritingMethod::JSONL, this->path("output"), ',', false);
+            writer.write();
+        }
+        std::ifstream file(this->path("output.jsonl"));
+        std::string line;
+        int lines = 0;
+        while (std::getline(file, line)) {
+            EXPECT_EQ(line, expected_line);
+            ++lines;
+        }
+        EXPECT_EQ(lines, 2);
+    }
+
+    template <typename T>
+    void testBorrowValues(const T& values) {
+        // the writers view the caller's values instead of copying them
+        Writer<T> writer(values, WritingMethod::CSV);
+        EXPECT_EQ(writer.values.data(), values.data());
+        Writer<T> copy = writer;
+        EXPECT_EQ(copy.values.data(), values.data());
+
+        // a block view of the same values is written like the values themselves
+        {
+            PrinterCSV<Eigen::Vector2d> printer(this->path("block"), ',', true);
+            printer.write_block(values.topRows(2));
+        }
+        std::ifstream file(this->path("block.csv"));
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(file, line);) {
+            lines.push_back(line);
+        }
+        EXPECT_EQ(lines.size(), 2U);
+            }
+
+    template <typename T>
+    void testWriteSinks(const T& values) {
+        // every sink of a single writer gets the same content as a writer of its own
+        std::vector<WriterSink> sinks = {{WritingMethod::CSV, this->path("single"), ';'},
+                                         {WritingMethod::DAT, this->path("single")},
+                                         {WritingMethod::JSONL, this->path("single")},
+                                         {WritingMethod::CONSOLE}};
+        {
+            Writer<T> writer(values, sinks);
+            writer.write();
+        }
+        for (const auto& sink : sinks) {
+            if (sink.method != WritingMethod::CONSOLE) {
+                Writer<T> writer(values, sink.method, this->path("separate"), sink.separator);
+                writer.write();
+            }
+        }
+        for (const std::string extension : {".csv", ".dat", ".jsonl"}) {
+            std::ifstream single(this->path("single" + extension));
+            std::ifstream separate(this->path("separate" + extension));
+            std::string single_content((std::istreambuf_iterator<char>(single)), std::istreambuf_iterator<char>());
+            std::string separate_content((std::istreambuf_iterator<char>(separate)), std::istreambuf_iterator<char>());
+            EXPECT_FALSE(single_content.empty()) << extension;
+            EXPECT_EQ(single_content, separate_content) << extension;
+        }
+    }
+
+    template <typename T>
+    void testWriteNPYContent(const T& values, const std::string& expected_dict) {
+        {
+            Writer<T> writer(values, WritingMethod::NPY, this->path("output"));
+            writer.write();
+        }
+        std::ifstream file(this->path("output.npy"), std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        ASSERT_GE(bytes.size(), 10U);
+        EXPECT_EQ(bytes.substr(0, 8), std::string("\x93NUMPY\x01\x00", 8));
+
+        // the header is padded so that the data starts on a 64-byte boundary
+        size_t header_size = 10 + static_cast<unsigned char>(bytes[8]) + (static_cast<unsigned char>(bytes[9]) << 8);
+        EXPECT_EQ(header_size % 64, 0U);
+        EXPECT_EQ(bytes.substr(10, expected_dict.size()), expected_dict);
+        EXPECT_EQ(bytes[header_size - 1], '\n');
+
+        // the rows follow one another, as raw doubles
+        ASSERT_EQ(bytes.size(), header_size + values.size() * sizeof(double));
+        for (int i = 0; i < values.rows(); ++i) {
+            double row[2];
+            std::memcpy(row, bytes.data() + header_size + i * sizeof(row), sizeof(row));
+            EXPECT_EQ(row[0], values(i, 0));
+            EXPECT_EQ(row[1], values(i, 1));
+        }
+    }
 };
 
 #endif
@@ -0,0 +1,288 @@
+/**
+ * @file double_double.hpp
+ * @brief Contains the double-double type, an unevaluated sum of two doubles carrying about 32 significant digits
+ *
+ * A DoubleDouble stores a number as hi + lo, with |lo| <= ulp(hi) / 2. The arithmetic follows the error-free
+ * transformations of Dekker and Knuth (two_sum, two_prod through a fused multiply-add), which keeps every operation
+ * within a few units of 2^-104 relative error at the cost of about ten double operations. It is meant for
+ * ill-conditioned roots, where double runs out of digits before the tolerance is met; it provides what the Solver,
+ * the steppers and the parsed functions need (arithmetic, comparisons, abs, sqrt, integer powers, sin and cos),
+ * and the traits Eigen needs to store it in its matrices.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef ROOT_DOUBLE_DOUBLE_HPP
+#define ROOT_DOUBLE_DOUBLE_HPP
+
+#include <Eigen/Core>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Floating point number made of two non-overlapping doubles, with twice the precision of a double
+ */
+class DoubleDouble {
+  public:
+    constexpr DoubleDouble() = default;
+    /** @brief Converts a double, exactly
+     *
+     * @param value The number
+     */
+    constexpr DoubleDouble(double value) : hi(value) {}  // NOLINT(google-explicit-constructor)
+    /** @brief Converts an integer, exactly up to 2^53
+     *
+     * @param value The number
+     */
+    constexpr DoubleDouble(int value) : hi(value) {}  // NOLINT(google-explicit-constructor)
+    /** @brief Creates a number from its two components, which must not overlap
+     *
+     * @param hi The leading component
+     * @param lo The trailing component, |lo| <= ulp(hi) / 2
+     */
+    constexpr DoubleDouble(double hi, double lo) : hi(hi), lo(lo) {}
+    /** @brief Converts a long double, keeping the bits of its mantissa which fit in the two components
+     *
+     * @param value The number
+     */
+    explicit DoubleDouble(long double value)
+        : hi(static_cast<double>(value)), lo(static_cast<double>(value - static_cast<long double>(hi))) {}
+
+    /** @brief Rounds to the nearest double
+     *
+     * @return hi + lo, rounded
+     */
+    explicit operator double() const { return this->hi + this->lo; }
+    /** @brief Converts to a long double, which keeps as many digits as its mantissa holds
+     *
+     * @return hi + lo
+     */
+    explicit operator long double() const {
+        return static_cast<long double>(this->hi) + static_cast<long double>(this->lo);
+    }
+    /** @brief Rounds to the nearest float
+     *
+     * @return hi + lo, rounded
+     */
+    explicit operator float() const { return static_cast<float>(this->hi + this->lo); }
+
+    /** @brief Returns the leading component
+     *
+     * @return hi
+     */
+    constexpr double high() const { return this->hi; }
+    /** @brief Returns the trailing component
+     *
+     * @return lo
+     */
+    constexpr double low() const { return this->lo; }
+
+    /** @brief Returns the distance from 1 to the next double-double
+     *
+     * @return 2^-104
+     */
+    static constexpr DoubleDouble epsilon() { return {4.93038065763132e-32, 0.0}; }
+    /** @brief Returns pi/2, to the precision of the type
+     *
+     * @return pi/2
+     */
+    static constexpr DoubleDouble half_pi() { return {1.570796326794896558e+00, 6.123233995736766036e-17}; }
+
+    DoubleDouble operator-() const { return {-this->hi, -this->lo}; }
+    DoubleDouble& operator+=(const DoubleDouble& other) { return *this = *this + other; }
+    DoubleDouble& operator-=(const DoubleDouble& other) { return *this = *this - other; }
+    DoubleDouble& operator*=(const DoubleDouble& other) { return *this = *this * other; }
+    DoubleDouble& operator/=(const DoubleDouble& other) { return *this = *this / other; }
+
+    friend DoubleDouble operator+(const DoubleDouble& a, const DoubleDouble& b) {
+        DoubleDouble s = two_sum(a.hi, b.hi);
+        DoubleDouble t = two_sum(a.lo, b.lo);
+        s.lo += t.hi;
+        s = quick_two_sum(s.hi, s.lo);
+        s.lo += t.lo;
+        return quick_two_sum(s.hi, s.lo);
+    }
+    friend DoubleDouble operator-(const DoubleDouble& a, const DoubleDouble& b) { return a + -b; }
+    friend DoubleDouble operator*(const DoubleDouble& a, const DoubleDouble& b) {
+        DoubleDouble p = two_prod(a.hi, b.hi);
+        p.lo += a.hi * b.lo + a.lo * b.hi;
+        return quick_two_sum(p.hi, p.lo);
+    }
+    friend DoubleDouble operator/(const DoubleDouble& a, const DoubleDouble& b) {
+        // long division: each quotient digit is a double, the remainder is computed exactly enough by the product
+        double q1 = a.hi / b.hi;
+        DoubleDouble r = a - b * q1;
+        double q2 = r.hi / b.hi;
+        r = r - b * q2;
+        double q3 = r.hi / b.hi;
+        return quick_two_sum(q1, q2) + q3;
+    }
+
+    friend bool operator==(const DoubleDouble& a, const DoubleDouble& b) { return a.hi == b.hi && a.lo == b.lo; }
+    friend bool operator<(const DoubleDouble& a, const DoubleDouble& b) {
+        return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo);
+    }
+    friend bool operator>(const DoubleDouble& a, const DoubleDouble& b) { return b < a; }
+    friend bool operator<=(const DoubleDouble& a, const DoubleDouble& b) { return !(b < a); }
+    friend bool operator>=(const DoubleDouble& a, const DoubleDouble& b) { return !(a < b); }
+
+    friend DoubleDouble abs(const DoubleDouble& a) { return a.hi < 0.0 ? -a : a; }
+    friend bool isfinite(const DoubleDouble& a) { return std::isfinite(a.hi) && std::isfinite(a.lo); }
+    friend DoubleDouble sqrt(const DoubleDouble& a) {
+        if (a.hi <= 0.0) {
+            return std::sqrt(a.hi);
+        }
+        // one Newton correction of the double square root doubles its number of correct digits
+        double x = 1.0 / std::sqrt(a.hi);
+        DoubleDouble ax = a.hi * x;
+        return ax + (a - ax * ax).hi * (x * 0.5);
+    }
+    friend DoubleDouble pow(const DoubleDouble& base, int exponent) {
+        DoubleDouble result = 1.0;
+        DoubleDouble square = base;
+        for (unsigned n = static_cast<unsigned>(std::abs(exponent)); n != 0; n >>= 1) {
+            if (n & 1U) {
+                result *= square;
+            }
+            square *= square;
+        }
+        return exponent < 0 ? 1.0 / result : result;
+    }
+    friend DoubleDouble sin(const DoubleDouble& a) { return sin_quadrant(a, 0); }
+    friend DoubleDouble cos(const DoubleDouble& a) { return sin_quadrant(a, 1); }
+
+    /** @brief Writes the number in scientific notation, with as many digits as the precision of the stream
+     *
+     * @param out The stream
+     * @param a The number
+     * @return The stream
+     */
+    friend std::ostream& operator<<(std::ostream& out, const DoubleDouble& a) {
+        return out << to_string(a, out.precision() > 0 ? static_cast<int>(out.precision()) : 32);
+    }
+    /** @brief Formats the number in scientific notation
+     *
+     * @param a The number
+     * @param digits The number of significant digits, between 1 and 32
+     * @return The decimal representation, e.g. 1.4142135623730950488016887242097e+00
+     */
+    friend std::string to_string(const DoubleDouble& a, int digits) {
+        if (!isfinite(a)) {
+            return std::isnan(a.hi) ? "nan" : (a.hi < 0.0 ? "-inf" : "inf");
+        }
+        std::string text = a.hi < 0.0 ? "-" : "";
+        DoubleDouble r = abs(a);
+        if (r.hi == 0.0) {
+            return text + "0";
+        }
+        int exponent = static_cast<int>(std::floor(std::log10(r.hi)));
+        r = r / pow(DoubleDouble(10.0), exponent);
+        if (r.hi >= 10.0) {
+            r = r / 10.0;
+            ++exponent;
+        } else if (r.hi < 1.0) {
+            r = r * 10.0;
+            --exponent;
+        }
+        // one more digit than asked is extracted to round the last one, and the correction pass absorbs the digits
+        // falling out of [0, 9] because of the rounding of the leading component
+        int values[34] = {};
+        int count = (digits < 1 ? 1 : (digits > 32 ? 32 : digits)) + 1;
+        for (int i = 0; i < count; ++i) {
+            values[i] = static_cast<int>(std::floor(r.hi));
+            r = (r - values[i]) * 10.0;
+        }
+        if (values[count - 1] >= 5) {
+            ++values[count - 2];
+        }
+        for (int i = count - 2; i > 0; --i) {
+            while (values[i] < 0) {
+                values[i] += 10;
+                --values[i - 1];
+            }
+            while (values[i] > 9) {
+                values[i] -= 10;
+                ++values[i - 1];
+            }
+        }
+        if (values[0] > 9) {
+            values[0] /= 10;
+            ++exponent;
+        }
+        text += static_cast<char>('0' + values[0]);
+        text += '.';
+        for (int i = 1; i < count - 1; ++i) {
+            text += static_cast<char>('0' + values[i]);
+        }
+        text += exponent < 0 ? "e-" : "e+";
+        text += (std::abs(exponent) < 10 ? "0" : "") + std::to_string(std::abs(exponent));
+        return text;
+    }
+
+  private:
+    double hi = 0.0;  //!< The leading component
+    double lo = 0.0;  //!< The trailing component
+
+    /** @brief Adds two doubles exactly */
+    static DoubleDouble two_sum(double a, double b) {
+        double s = a + b;
+        double bb = s - a;
+        return {s, (a - (s - bb)) + (b - bb)};
+    }
+    /** @brief Adds two doubles exactly, given that |a| >= |b| */
+    static DoubleDouble quick_two_sum(double a, double b) {
+        double s = a + b;
+        return {s, b - (s - a)};
+    }
+    /** @brief Multiplies two doubles exactly, the rounding error being given by a fused multiply-add */
+    static DoubleDouble two_prod(double a, double b) {
+        double p = a * b;
+        return {p, std::fma(a, b, -p)};
+    }
+    /** @brief Computes sin(a + quadrant * pi/2), from a Taylor series of the reduced argument |r| <= pi/4 */
+    static DoubleDouble sin_quadrant(const DoubleDouble& a, int quadrant) {
+        double turns = std::nearbyint(a.hi / half_pi().hi);
+        DoubleDouble r = a - half_pi() * turns;
+        quadrant = static_cast<int>((static_cast<long long>(turns) + quadrant) % 4 + 4) % 4;
+
+        // sin(r) for even quadrants, cos(r) for odd ones, up to the sign
+        DoubleDouble r2 = r * r;
+        DoubleDouble term = quadrant % 2 == 0 ? r : DoubleDouble(1.0);
+        DoubleDouble sum = term;
+        for (int n = quadrant % 2 == 0 ? 2 : 1; std::abs(term.hi) > 1e-34 * std::abs(sum.hi); n += 2) {
+            term = -term * r2 / (static_cast<double>(n) * (n + 1));
+            sum += term;
+        }
+        return quadrant >= 2 ? -sum : sum;
+    }
+};
+
+namespace Eigen {
+/** @brief Traits letting Eigen store and combine DoubleDouble numbers */
+template <>
+struct NumTraits<DoubleDouble> : GenericNumTraits<DoubleDouble> {
+    using Real = DoubleDouble;        //!< The type is real
+    using NonInteger = DoubleDouble;  //!< The type is not an integer
+    using Literal = DoubleDouble;     //!< Literals are converted to the type
+    using Nested = DoubleDouble;      //!< Stored by value in expressions
+    enum {
+        IsComplex = 0,
+        IsInteger = 0,
+        IsSigned = 1,
+        RequireInitialization = 1,
+        ReadCost = 2,
+        AddCost = 20,
+        MulCost = 10
+    };
+    static inline Real epsilon() { return DoubleDouble::epsilon(); }
+    static inline Real dummy_precision() { return 1e-28; }
+    static inline Real highest() { return std::numeric_limits<double>::max(); }
+    static inline Real lowest() { return std::numeric_limits<double>::lowest(); }
+    static inline int digits10() { return 31; }
+    static inline int digits() { return 106; }
+};
+}  // namespace Eigen
+
+#endif  // ROOT_DOUBLE_DOUBLE_HPP
@@ -0,0 +1,110 @@
+/**
+ * @file generator.hpp
+ * @brief Contains a minimal C++20 coroutine generator, used to stream the iterates of a solving process
+ *
+ * A Generator produces its values lazily: the coroutine runs until its next co_yield only when the consumer asks for
+ * the next value, and it is destroyed (with its local variables) as soon as the consumer drops the Generator, even if
+ * it has not run to completion.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef ROOT_GENERATOR_HPP
+#define ROOT_GENERATOR_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <utility>
+
+/**
+ * @brief Move-only range over the values yielded by a coroutine, computed one at a time
+ */
+template <typename T>
+class Generator {
+  public:
+    /** @brief Coroutine promise storing the latest yielded value */
+    struct promise_type {
+        const T* value = nullptr;  //!< The latest yielded value, owned by the suspended coroutine
+
+        Generator get_return_object() { return Generator(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T& yielded) noexcept {
+            this->value = std::addressof(yielded);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    /** @brief Input iterator resuming the coroutine on every increment */
+    class iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;  //!< Single-pass iteration
+        using difference_type = std::ptrdiff_t;             //!< Required by std::input_iterator
+        using value_type = T;                               //!< Type of the yielded values
+
+        iterator() = default;
+        /** @brief Creates an iterator on a started coroutine
+         *
+         * @param handle The coroutine, suspended on its first value or finished
+         */
+        explicit iterator(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+        const T& operator*() const { return *this->handle.promise().value; }
+        const T* operator->() const { return this->handle.promise().value; }
+        iterator& operator++() {
+            this->handle.resume();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(std::default_sentinel_t) const { return !this->handle || this->handle.done(); }
+
+      private:
+        std::coroutine_handle<promise_type> handle;  //!< The coroutine, owned by the Generator
+    };
+
+    Generator(Generator&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            this->destroy();
+            this->handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+    ~Generator() { this->destroy(); }
+
+    /** @brief Runs the coroutine up to its first value
+     *
+     * @return Iterator on the first value, equal to end() if the coroutine yields nothing
+     */
+    iterator begin() {
+        if (this->handle) {
+            this->handle.resume();
+        }
+        return iterator(this->handle);
+    }
+    /** @brief Returns the sentinel reached once the coroutine has finished
+     *
+     * @return std::default_sentinel
+     */
+    std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+  private:
+    /** @brief Takes the ownership of a coroutine, suspended before its body
+     *
+     * @param handle The coroutine
+     */
+    explicit Generator(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    /** @brief Destroys the coroutine, and with it the local variables of its body */
+    void destroy() {
+        if (this->handle) {
+            this->handle.destroy();
+        }
+    }
+    std::coroutine_handle<promise_type> handle;  //!< The coroutine producing the values
+};
+
+#endif  // ROOT_GENERATOR_HPP
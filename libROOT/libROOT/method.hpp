@@ -5,6 +5,45 @@
  * @brief Enumeration of available root-finding methods.
  *
  */
-enum Method { BISECTION, NEWTON, CHORDS, FIXED_POINT };
+enum Method { BISECTION, NEWTON, CHORDS, FIXED_POINT, MULLER };
+
+/**
+ * @brief Enumeration of the ways a solving process can end.
+ *
+ */
+enum SolverStatus {
+    CONVERGED,        //!< The error or |f(x)| fell below the tolerance.
+    MAX_ITERATIONS,   //!< The maximum number of iterations was reached first.
+    DIVERGED,         //!< The latest guess or its evaluation is not a finite number, or no step reduces the residual.
+    CANCELLED,        //!< A stop was requested (through the stop token of the Solver) before convergence.
+    TIMED_OUT,        //!< The wall-clock time limit of the process was reached first.
+    BUDGET_EXHAUSTED  //!< The budget of function evaluations of the process was spent first.
+};
+
+/**
+ * @brief Name of a status, as written in the outputs of ROOT.
+ *
+ * @param status The status.
+ * @return "converged", "max_iterations", "diverged", "cancelled", "timed_out", "budget_exhausted", or "unknown"
+ * for a value outside of the enumeration.
+ */
+inline const char* solver_status_name(int status) {
+    switch (status) {
+        case SolverStatus::CONVERGED:
+            return "converged";
+        case SolverStatus::MAX_ITERATIONS:
+            return "max_iterations";
+        case SolverStatus::DIVERGED:
+            return "diverged";
+        case SolverStatus::CANCELLED:
+            return "cancelled";
+        case SolverStatus::TIMED_OUT:
+            return "timed_out";
+        case SolverStatus::BUDGET_EXHAUSTED:
+            return "budget_exhausted";
+        default:
+            return "unknown";
+    }
+}
 
 #endif
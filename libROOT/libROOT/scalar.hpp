@@ -0,0 +1,93 @@
+/**
+ * @file scalar.hpp
+ * @brief Contains the traits mapping the initial guess of a Solver to the scalar type its process computes with
+ *
+ * A Solver and its steppers are templated on the type of their initial guess: a scalar for the open methods
+ * (Newton-Raphson, Fixed Point), a 2-dimensional vector of that scalar for the bracketing ones (Bisection, Chords).
+ * The scalar can be float (for throughput), double, long double or DoubleDouble (for ill-conditioned roots); the
+ * iterates, the functions and the trajectory all use it, while the tolerance and the error stay in double. The open
+ * methods also accept std::complex<double>, to reach the complex roots of a function.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef ROOT_SCALAR_HPP
+#define ROOT_SCALAR_HPP
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <complex>
+
+#include "double_double.hpp"
+
+/**
+ * @brief Scalar type of an initial guess: the guess itself, or the type of the elements of an interval
+ */
+template <typename T>
+struct ScalarOf {
+    using type = T;  //!< A scalar guess is its own scalar type
+};
+
+/**
+ * @brief Scalar type of an interval, given as a 2-dimensional Eigen vector
+ */
+template <typename Scalar, int Options, int MaxRows, int MaxCols>
+struct ScalarOf<Eigen::Matrix<Scalar, 2, 1, Options, MaxRows, MaxCols>> {
+    using type = Scalar;  //!< The type of the two ends of the interval
+};
+
+/** @brief Scalar type the process of a Solver<T> computes with */
+template <typename T>
+using scalar_of_t = typename ScalarOf<T>::type;
+
+/** @brief Tells whether a scalar type is a std::complex */
+template <typename Scalar>
+inline constexpr bool is_complex_v = false;
+
+/** @brief Tells whether a scalar type is a std::complex */
+template <typename Real>
+inline constexpr bool is_complex_v<std::complex<Real>> = true;
+
+/** @brief An iterate: x(i) and f(x(i)) */
+template <typename Scalar>
+using Point = Eigen::Matrix<Scalar, 2, 1>;
+
+/** @brief A trajectory: x(i) in the first column, f(x(i)) in the second one */
+template <typename Scalar>
+using Trajectory = Eigen::Matrix<Scalar, Eigen::Dynamic, 2>;
+
+/**
+ * @brief Magnitude of a scalar, in double: errors and residuals are compared with the tolerance in this precision
+ *
+ * @param value The scalar
+ * @return |value|
+ */
+template <typename Scalar>
+double magnitude(const Scalar& value) {
+    using std::abs;
+    return static_cast<double>(abs(value));
+}
+
+/**
+ * @brief Tells whether a scalar is neither infinite nor NaN, whatever its type
+ *
+ * @param value The scalar
+ * @return true if the value is finite
+ */
+template <typename Scalar>
+bool is_finite(const Scalar& value) {
+    using std::isfinite;
+    return isfinite(value);
+}
+
+/**
+ * @brief Tells whether both parts of a complex number are finite
+ *
+ * @param value The complex number
+ * @return true if neither part is infinite or NaN
+ */
+template <typename Real>
+bool is_finite(const std::complex<Real>& value) {
+    return is_finite(value.real()) && is_finite(value.imag());
+}
+
+#endif  // ROOT_SCALAR_HPP
@@ -0,0 +1,99 @@
+/**
+ * @file solve_context.hpp
+ * @brief Contains the memory arena in which a Solver runs its processes, reused from one problem to the next
+ *
+ * A process needs memory for its stepper and for its trajectory, which grows with the iterations actually made. A
+ * SolveContext owns a single buffer serving these allocations through a monotonic resource: each process releases
+ * the memory of the previous one in a single step. A process outgrowing the buffer gets the rest from the heap, and
+ * the buffer then grows to what it used when the next process starts. Once it has grown to the largest problem of a
+ * batch, the processes make no heap allocation at all.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef ROOT_SOLVE_CONTEXT_HPP
+#define ROOT_SOLVE_CONTEXT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+/**
+ * @brief Reusable arena serving the allocations of one solving process at a time
+ */
+class SolveContext {
+  public:
+    /** @brief Creates a context and allocates its buffer
+     *
+     * @param capacity Bytes of the buffer, grown later on demand
+     */
+    explicit SolveContext(std::size_t capacity = 4096) { this->reset(capacity); }
+    SolveContext(const SolveContext&) = delete;
+    SolveContext& operator=(const SolveContext&) = delete;
+
+    /** @brief Releases the memory of the previous process, invalidating what was allocated for it
+     *
+     * @param bytes The memory the next process needs, the buffer is reallocated if it is smaller
+     */
+    void reset(std::size_t bytes) {
+        // the previous process reached the heap, the next ones get the memory it used from the buffer (up to a limit,
+        // so that a single exceptional process does not pin its memory for the lifetime of the context)
+        if (this->spill.bytes > 0) {
+            bytes = std::max(bytes, std::min(this->capacity + this->spill.bytes, retained_bytes));
+        }
+        this->spill.bytes = 0;
+        if (this->arena) {
+            this->arena->release();
+        }
+        if (!this->arena || bytes > this->capacity) {
+            // the old buffer is freed first; if the new one cannot be allocated, the next reset tries again
+            this->arena.reset();
+            this->buffer.reset();
+            this->capacity = 0;
+            this->buffer = std::make_unique<std::byte[]>(bytes);
+            this->capacity = bytes;
+            // the heap is only reached if the process asks for more than it announced
+            this->arena.emplace(this->buffer.get(), this->capacity, &this->spill);
+        }
+    }
+    /** @brief Returns the resource to allocate the memory of the current process from
+     *
+     * @return The monotonic resource over the buffer
+     */
+    std::pmr::memory_resource* resource() { return &*this->arena; }
+    /** @brief Returns the size of the buffer
+     *
+     * @return Bytes available to a process before the heap is reached
+     */
+    std::size_t get_capacity() const { return this->capacity; }
+
+  private:
+    static constexpr std::size_t retained_bytes = std::size_t{1} << 24;  //!< Largest buffer grown from heap usage
+
+    /**
+     * @brief Upstream of the arena, counting the memory a process took from the heap beyond the buffer
+     */
+    class Spill : public std::pmr::memory_resource {
+      public:
+        std::size_t bytes = 0;  //!< Bytes allocated since the last reset
+
+      private:
+        void* do_allocate(std::size_t size, std::size_t alignment) override {
+            void* memory = std::pmr::new_delete_resource()->allocate(size, alignment);
+            this->bytes += size;
+            return memory;
+        }
+        void do_deallocate(void* memory, std::size_t size, std::size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(memory, size, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    Spill spill;                                               //!< Heap memory of the arena beyond the buffer
+    std::size_t capacity = 0;                                  //!< Size of the buffer
+    std::unique_ptr<std::byte[]> buffer;                       //!< Memory served to the processes
+    std::optional<std::pmr::monotonic_buffer_resource> arena;  //!< Resource over the buffer, rebuilt when it grows
+};
+
+#endif  // ROOT_SOLVE_CONTEXT_HPP
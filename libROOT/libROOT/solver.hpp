@@ -1,8 +1,13 @@
 #ifndef ROOT_SOLVER_HPP
 #define ROOT_SOLVER_HPP
 #include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <complex>
 #include <iostream>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 #include "method.hpp"
 #include "solver_def.hpp"
@@ -12,103 +17,193 @@ constexpr double tol = 1e-6;
 constexpr int max_iters = 200;
 
 template <typename T>
-Solver<T>::Solver(std::function<double(double)> fun, T initial_guess, const Method method, int max_iterations,
+Solver<T>::Solver(std::function<Scalar(Scalar)> fun, T initial_guess, const Method method, int max_iterations,
                   double tolerance, bool aitken_mode, bool verbose) {
     this->function = fun;
     this->initial_guess = initial_guess;
     this->method = method;
     this->max_iterations = max_iterations;
     this->tolerance = tolerance;
-    this->results = Eigen::MatrixX2d(0, 2);
+    this->results = Trajectory<Scalar>(0, 2);
     this->aitken_requirement = aitken_mode;
     this->verbose = verbose;
 }
 template <typename T>
-Solver<T>::Solver(std::function<double(double)> fun, T initial_guess, const Method method, int max_iterations,
+Solver<T>::Solver(std::function<Scalar(Scalar)> fun, T initial_guess, const Method method, int max_iterations,
                   double tolerance, bool aitken_mode, bool verbose,
-                  std::function<double(double)> derivative_or_function_g) {
+                  std::function<Scalar(Scalar)> derivative_or_function_g) {
     this->function = fun;
     this->initial_guess = initial_guess;
     this->method = method;
     this->max_iterations = max_iterations;
     this->tolerance = tolerance;
-    this->results = Eigen::MatrixX2d(0, 2);
+    this->results = Trajectory<Scalar>(0, 2);
     this->aitken_requirement = aitken_mode;
     this->verbose = verbose;
     this->derivative_or_function_g = derivative_or_function_g;
 }
 
-template <>
-void Solver<double>::convert_stepper(std::unique_ptr<StepperBase<double>>& stepper) {
-    switch (this->method) {
-        case Method::NEWTON:
-            stepper = std::make_unique<NewtonRaphsonStepper<double>>(this->function, this->aitken_requirement,
-                                                                     this->derivative_or_function_g);
-            break;
-        case Method::FIXED_POINT:
-            stepper = std::make_unique<FixedPointStepper<double>>(this->function, this->aitken_requirement,
-                                                                  this->derivative_or_function_g);
-            break;
-        default:
-            std::cerr << "\033[31mCaught error: Selected method is not compatible with scalar initial guess\033[0m"
-                      << std::endl;
-            break;
-    }
-}
-
-template <>
-void Solver<Eigen::Vector2d>::convert_stepper(std::unique_ptr<StepperBase<Eigen::Vector2d>>& stepper) {
-    switch (this->method) {
-        case Method::BISECTION:
-            stepper = std::make_unique<BisectionStepper<Eigen::Vector2d>>(this->function, this->aitken_requirement,
-                                                                          this->initial_guess);
-            break;
-        case Method::CHORDS:
-            stepper = std::make_unique<ChordsStepper<Eigen::Vector2d>>(this->function, this->aitken_requirement,
-                                                                       this->initial_guess);
-            break;
-        default:
-            std::cerr << "\033[31mCaught error: Selected method is not compatible with vector initial guess\033[0m"
-                      << std::endl;
-            break;
+template <typename T>
+StepperPointer<T> Solver<T>::make_stepper(const T& initial_guess, std::function<Scalar(Scalar)> fun,
+                                          std::function<Scalar(Scalar)> auxiliary,
+                                          std::pmr::memory_resource* resource) const {
+    // the open methods start from a scalar guess, the bracketing ones from an interval
+    if constexpr (std::is_same_v<T, Scalar>) {
+        switch (this->method) {
+            case Method::NEWTON:
+                return allocate_stepper<NewtonRaphsonStepper, T>(resource, std::move(fun), this->aitken_requirement,
+                                                                 std::move(auxiliary));
+            case Method::FIXED_POINT:
+                return allocate_stepper<FixedPointStepper, T>(resource, std::move(fun), this->aitken_requirement,
+                                                              std::move(auxiliary));
+            case Method::MULLER:
+                // a real parabola may have no real root, the next iterate then only exists in the complex plane
+                if constexpr (is_complex_v<Scalar>) {
+                    return allocate_stepper<MullerStepper, T>(resource, std::move(fun), this->aitken_requirement);
+                } else {
+                    std::cerr << "\033[31mCaught error: Muller's method needs a complex initial guess\033[0m"
+                              << std::endl;
+                    return nullptr;
+                }
+            default:
+                std::cerr << "\033[31mCaught error: Selected method is not compatible with scalar initial guess\033[0m"
+                          << std::endl;
+                return nullptr;
+        }
+    } else {
+        switch (this->method) {
+            case Method::BISECTION:
+                return allocate_stepper<BisectionStepper, T>(resource, std::move(fun), this->aitken_requirement,
+                                                             initial_guess);
+            case Method::CHORDS:
+                return allocate_stepper<ChordsStepper, T>(resource, std::move(fun), this->aitken_requirement,
+                                                          initial_guess);
+            default:
+                std::cerr << "\033[31mCaught error: Selected method is not compatible with vector initial guess\033[0m"
+                          << std::endl;
+                return nullptr;
+        }
     }
 }
 
 template <typename T>
-void Solver<T>::save_results(int iter, Eigen::Vector2d result_to_save) {
+void Solver<T>::convert_stepper(StepperPointer<T>& stepper) {
+    stepper = this->make_stepper(this->initial_guess, this->function, this->derivative_or_function_g);
+}
+
+template <typename T>
+std::size_t Solver<T>::process_bytes() const {
+    constexpr std::size_t stepper =
+        std::max({sizeof(NewtonRaphsonStepper<T>), sizeof(FixedPointStepper<T>), sizeof(MullerStepper<T>),
+                  sizeof(BisectionStepper<T>), sizeof(ChordsStepper<T>)});
+    // the slack covers the padding the arena inserts to align each of the two blocks
+    const Eigen::Index rows = std::min(static_cast<Eigen::Index>(std::max(this->max_iterations, 1)) + 1, first_rows);
+    return stepper + static_cast<std::size_t>(rows) * sizeof(Point<Scalar>) + 2 * alignof(std::max_align_t);
+}
+
+template <typename T>
+typename Solver<T>::Scalar Solver<T>::starting_point(const T& initial_guess) {
+    if constexpr (std::is_same_v<T, Scalar>) {
+        return initial_guess;
+    } else {
+        return initial_guess(1);
+    }
+}
+
+template <typename T>
+void Solver<T>::save_results(int iter, Point<Scalar> result_to_save) {
     results.conservativeResize(iter + 1, 2);
     this->results.row(iter) = result_to_save.transpose();
 }
 
 template <typename T>
-Eigen::Vector2d Solver<T>::get_previous_result(int step_length) {
+Point<typename Solver<T>::Scalar> Solver<T>::get_previous_result(int step_length) {
     int target_row = results.rows() - step_length - 1;
     return this->results.row(target_row);
 }
 
-template <>
-void Solver<double>::save_starting_point() {
+template <typename T>
+void Solver<T>::save_starting_point() {
     if (results.rows() == 0) results.conservativeResize(1, 2);
-    this->save_results(0, {this->initial_guess, this->function(this->initial_guess)});
+    Scalar to_save = starting_point(this->initial_guess);
+    this->save_results(0, {to_save, this->function(to_save)});
 }
 
-template <>
-void Solver<Eigen::Vector2d>::save_starting_point() {
-    if (results.rows() == 0) results.resize(1, 2);
-    double to_save = initial_guess(1);
-    this->save_results(0, {to_save, this->function(to_save)});
+template <typename T>
+double Solver<T>::calculate_error(const Scalar& x_prev, const Scalar& x_next) const {
+    return magnitude(x_prev - x_next);
+}
+
+template <typename T>
+bool Solver<T>::within_limits(long evaluations, std::chrono::steady_clock::time_point deadline) const {
+    // the clock is only read when there is a time limit
+    return (this->max_evaluations <= 0 || evaluations < this->max_evaluations) &&
+           (this->time_limit <= std::chrono::nanoseconds::zero() || std::chrono::steady_clock::now() < deadline);
 }
 
 template <typename T>
-double Solver<T>::calculate_error(double x_prev, double x_next) {
-    return abs(x_prev - x_next);
+bool Solver<T>::stop_requested(const std::stop_token& stop) const {
+    return stop.stop_requested() || this->stop_token.stop_requested();
 }
 
 template <typename T>
-Eigen::MatrixX2d Solver<T>::solve() {
+bool Solver<T>::keep_iterating(int iter, double err, const Scalar& f_last, long evaluations,
+                               const std::stop_token& stop, std::chrono::steady_clock::time_point deadline) const {
+    return err > this->tolerance && magnitude(f_last) > this->tolerance && iter < this->max_iterations &&
+           !this->stop_requested(stop) && this->within_limits(evaluations, deadline);
+}
+
+template <typename T>
+SolverStatus Solver<T>::final_status(int iter, double err, const Point<Scalar>& last, long evaluations,
+                                     const std::stop_token& stop) const {
+    if (!is_finite(last(0)) || !is_finite(last(1))) {
+        return SolverStatus::DIVERGED;
+    }
+    if (err <= this->tolerance || magnitude(last(1)) <= this->tolerance) {
+        return SolverStatus::CONVERGED;
+    }
+    if (iter >= this->max_iterations) {
+        return SolverStatus::MAX_ITERATIONS;
+    }
+    if (this->stop_requested(stop)) {
+        return SolverStatus::CANCELLED;
+    }
+    if (this->max_evaluations > 0 && evaluations >= this->max_evaluations) {
+        return SolverStatus::BUDGET_EXHAUSTED;
+    }
+    return SolverStatus::TIMED_OUT;
+}
+
+template <typename T>
+Solver<T>::CountingScope::CountingScope(Solver& solver)
+    : solver(solver), function(solver.function), auxiliary(solver.derivative_or_function_g) {
+    // the steppers get counting wrappers of the functions
+    this->solver.evaluations = 0;
+    this->solver.function = [&solver, function = this->function](Scalar x) {
+        ++solver.evaluations;
+        return function(x);
+    };
+    if (this->auxiliary) {
+        this->solver.derivative_or_function_g = [&solver, auxiliary = this->auxiliary](Scalar x) {
+            ++solver.evaluations;
+            return auxiliary(x);
+        };
+    }
+}
+
+template <typename T>
+Solver<T>::CountingScope::~CountingScope() {
+    this->solver.function = this->function;
+    this->solver.derivative_or_function_g = this->auxiliary;
+}
+
+template <typename T>
+Trajectory<typename Solver<T>::Scalar> Solver<T>::solve() {
     double err = 1.0;
+    const auto deadline = std::chrono::steady_clock::now() + this->time_limit;
 
-    std::unique_ptr<StepperBase<T>> stepper;
+    StepperPointer<T> stepper;
+    CountingScope counting(*this);
 
     convert_stepper(stepper);
 
@@ -121,8 +216,9 @@ Eigen::MatrixX2d Solver<T>::solve() {
 
     int iter = 1;
 
-    while (err > this->tolerance && abs(this->get_previous_result(0)(1)) > this->tolerance &&
-           iter < this->max_iterations) {
+    // an incompatible method leaves no stepper, the starting point is then the whole trajectory
+    while (stepper &&
+           this->keep_iterating(iter, err, this->get_previous_result(0)(1), this->evaluations, {}, deadline)) {
         if (this->verbose) {
             std::cout << "x(0): " << this->get_previous_result(0)(0) << "; f(x0): " << this->get_previous_result(0)(1)
                       << std::endl;
@@ -135,18 +231,123 @@ Eigen::MatrixX2d Solver<T>::solve() {
                   << std::endl;
     }
     if (this->verbose) {
-        if (err <= this->tolerance || abs(this->get_previous_result(0)(1)) <= this->tolerance) {
+        if (err <= this->tolerance || magnitude(this->get_previous_result(0)(1)) <= this->tolerance) {
             std::cout << "Converged in " << iter - 1 << " iterations." << std::endl;
         }
     }
     std::cout << "Final estimate: x = " << this->get_previous_result(0)(0)
               << "; f(x) = " << this->get_previous_result(0)(1) << "; error = " << err << std::endl;
 
+    this->status = stepper ? this->final_status(iter, err, this->get_previous_result(0), this->evaluations, {})
+                           : SolverStatus::DIVERGED;
+    Eigen::Index best = 0;
+    this->results.col(1).cwiseAbs().minCoeff(&best);
+    this->best_estimate = this->results.row(best);
+
     return results;
 }
 
 template <typename T>
-void Solver<T>::solver_step(int& iter, std::unique_ptr<StepperBase<T>>& stepper, double& err) {
+Generator<Point<typename Solver<T>::Scalar>> Solver<T>::iterate() {
+    const auto deadline = std::chrono::steady_clock::now() + this->time_limit;
+    // the scope lives in the coroutine frame, so the functions are restored even if the consumer stops early
+    CountingScope counting(*this);
+    StepperPointer<T> stepper;
+    convert_stepper(stepper);
+
+    Scalar start = starting_point(this->initial_guess);
+    Point<Scalar> current(start, this->function(start));
+    this->best_estimate = current;
+    co_yield current;
+
+    int iter = 1;
+    double err = 1.0;
+    while (stepper && this->keep_iterating(iter, err, current(1), this->evaluations, {}, deadline)) {
+        Point<Scalar> next = stepper->step(current);
+        err = this->calculate_error(next(0), current(0));
+        current = next;
+        ++iter;
+        if (magnitude(current(1)) < magnitude(this->best_estimate(1))) {
+            this->best_estimate = current;
+        }
+        co_yield current;
+    }
+    this->status = stepper ? this->final_status(iter, err, current, this->evaluations, {}) : SolverStatus::DIVERGED;
+}
+
+template <typename T>
+BasicSolution<typename Solver<T>::Scalar> Solver<T>::solve(const T& initial_guess, std::stop_token stop) const {
+    SolveContext context(this->process_bytes());
+    return this->solve(initial_guess, context, std::move(stop)).to_solution();
+}
+
+template <typename T>
+BasicSolutionView<typename Solver<T>::Scalar> Solver<T>::solve(const T& initial_guess, SolveContext& context,
+                                                                std::stop_token stop) const {
+    const auto deadline = std::chrono::steady_clock::now() + this->time_limit;
+    const Eigen::Index max_rows = static_cast<Eigen::Index>(std::max(this->max_iterations, 1)) + 1;
+    context.reset(this->process_bytes());
+    std::pmr::memory_resource* resource = context.resource();
+
+    long evaluations = 0;
+    // pointers are all the wrappers capture, so they fit in the small buffer of std::function: neither the functions
+    // of the Solver nor its members are copied or written, whichever thread runs the process
+    std::function<Scalar(Scalar)> function = [&evaluations, fun = &this->function](Scalar x) {
+        ++evaluations;
+        return (*fun)(x);
+    };
+    std::function<Scalar(Scalar)> auxiliary;
+    if (this->derivative_or_function_g) {
+        auxiliary = [&evaluations, fun = &this->derivative_or_function_g](Scalar x) {
+            ++evaluations;
+            return (*fun)(x);
+        };
+    }
+    StepperPointer<T> stepper = this->make_stepper(initial_guess, function, auxiliary, resource);
+
+    // the trajectory only takes the memory of the iterations actually made: its block doubles whenever it is full,
+    // the arena keeping the smaller ones until the next process (a bound on the iterations is not a size to reserve)
+    Eigen::Index capacity = std::min(max_rows, first_rows);
+    auto allocate_rows = [resource](Eigen::Index count) {
+        return static_cast<Scalar*>(
+            resource->allocate(static_cast<std::size_t>(count) * sizeof(Point<Scalar>), alignof(Scalar)));
+    };
+    Scalar* rows = allocate_rows(capacity);
+    auto store = [&rows](Eigen::Index row, const Point<Scalar>& point) {
+        rows[2 * row] = point(0);
+        rows[2 * row + 1] = point(1);
+    };
+
+    Scalar start = starting_point(initial_guess);
+    Point<Scalar> current(start, function(start));
+    store(0, current);
+    Point<Scalar> best = current;
+
+    int iter = 1;
+    double err = 1.0;
+    while (stepper && this->keep_iterating(iter, err, current(1), evaluations, stop, deadline)) {
+        Point<Scalar> next = stepper->step(current);
+        err = this->calculate_error(next(0), current(0));
+        current = next;
+        if (iter == capacity) {
+            Eigen::Index grown = std::min(2 * capacity, max_rows);
+            Scalar* larger = allocate_rows(grown);
+            std::copy_n(rows, 2 * capacity, larger);
+            rows = larger;
+            capacity = grown;
+        }
+        store(iter, current);
+        ++iter;
+        if (magnitude(current(1)) < magnitude(best(1))) {
+            best = current;
+        }
+    }
+    SolverStatus status = stepper ? this->final_status(iter, err, current, evaluations, stop) : SolverStatus::DIVERGED;
+    return {{rows, iter, 2}, status, evaluations, best};
+}
+
+template <typename T>
+void Solver<T>::solver_step(int& iter, StepperPointer<T>& stepper, double& err) {
     if (this->verbose) {
         std::cout << "Iteration " << iter << ": ";
     }
@@ -156,7 +357,14 @@ void Solver<T>::solver_step(int& iter, std::unique_ptr<StepperBase<T>>& stepper,
     ++iter;
 }
 
+template class Solver<float>;
 template class Solver<double>;
-template class Solver<Eigen::Vector2d>;
+template class Solver<long double>;
+template class Solver<DoubleDouble>;
+template class Solver<Point<float>>;
+template class Solver<Point<double>>;
+template class Solver<Point<long double>>;
+template class Solver<Point<DoubleDouble>>;
+template class Solver<std::complex<double>>;
 
 #endif  // ROOT_SOLVER_HPP
@@ -16,31 +16,95 @@
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <chrono>
 #include <functional>
+#include <stop_token>
 #include <string>
 
+#include "generator.hpp"
 #include "method.hpp"
+#include "scalar.hpp"
+#include "solve_context.hpp"
 #include "stepper_def.hpp"
 
 template <typename T>
 class StepperBase;
+
+/**
+ * @brief The results of a solving process, with the counters describing how it went
+ */
+template <typename Scalar>
+struct BasicSolution {
+    Trajectory<Scalar> results = Trajectory<Scalar>(0, 2);  //!< x(i) in the first column, f(x(i)) in the second one
+    SolverStatus status = SolverStatus::CONVERGED;          //!< How the solving process ended
+    long evaluations = 0;                                   //!< Number of function evaluations
+    Point<Scalar> best = Point<Scalar>::Zero();             //!< The iterate with the smallest |f(x(i))|
+
+    /**
+     * @brief The estimate of the root reported in the summaries: the last iterate, or the best one when the process
+     * was ended early by a limit or a cancellation (its last iterate may then be far from the root).
+     *
+     * @return x and f(x) of the estimate, given that results holds at least one row
+     */
+    [[nodiscard]] Point<Scalar> estimate() const {
+        if (this->status == SolverStatus::TIMED_OUT || this->status == SolverStatus::BUDGET_EXHAUSTED ||
+            this->status == SolverStatus::CANCELLED) {
+            return this->best;
+        }
+        return this->results.row(this->results.rows() - 1);
+    }
+};
+
+/** @brief The results of a solving process in double precision */
+using Solution = BasicSolution<double>;
+
+/**
+ * @brief The results of a process run in a SolveContext, whose trajectory stays in the memory of the context
+ *
+ * The view is valid until the context runs another process (or is destroyed); copy it into a solution to keep it.
+ */
+template <typename Scalar>
+struct BasicSolutionView {
+    /** @brief x(i) in the first column, f(x(i)) in the second one, mapped on the arena of the context */
+    Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, 2, Eigen::RowMajor>> results{nullptr, 0, 2};
+    SolverStatus status = SolverStatus::CONVERGED;  //!< How the solving process ended
+    long evaluations = 0;                           //!< Number of function evaluations
+    Point<Scalar> best = Point<Scalar>::Zero();     //!< The iterate with the smallest |f(x(i))|
+
+    /** @brief Copies the trajectory out of the context
+     *
+     * @return The same results, owning their memory
+     */
+    [[nodiscard]] BasicSolution<Scalar> to_solution() const {
+        return {this->results, this->status, this->evaluations, this->best};
+    }
+};
+
+/** @brief The results of a process run in a SolveContext, in double precision */
+using SolutionView = BasicSolutionView<double>;
+
 /**
  * @brief Class Solver managing the solving process and creating the Stepper object
  */
 template <typename T>
 class Solver {
+  public:
+    using Scalar = scalar_of_t<T>;  //!< The type of the iterates and of the values of the function
+
   private:
+    /** @brief Rows of the first trajectory block of a process run in a SolveContext */
+    static constexpr Eigen::Index first_rows = 64;
     friend class SolverTester;  //!< Friend class for unit testing purposes
     Method method;              //!< Method which will be used - defined thanks to @author Saransh-ccp's Reader
     int max_iterations;         //!< Stores the maximum iterations for the method
     double tolerance;           //!< Stores the tolerance below which the process ends
     bool aitken_requirement;    //!< True if Aitken acceleration is required, 0 otherwise
     bool verbose;               //!< Verbose mode flag
-    std::function<double(double)>
+    std::function<Scalar(Scalar)>
         derivative_or_function_g;  //!< Stores the derivative or g_function of the function if needed
-    Eigen::MatrixX2d results;  //!< Stores in the first column the points computed at each step, in the second the value
-                               //!< of the function at those points.
-    std::function<double(double)>
+    Trajectory<Scalar> results;  //!< Stores in the first column the points computed at each step, in the second the
+                                 //!< value of the function at those points.
+    std::function<Scalar(Scalar)>
         function;     //!< Stores the function to find the root of and the starting guess for the process
     T initial_guess;  //!< Templated initial_guess for the method, whose type changes depending on the method itself
     /** @brief Creates the stepper, calls the step computation, the error calculation and the results' saver.
@@ -49,26 +113,26 @@ class Solver {
      * @param stepper The stepper object previously created and specialized depending on the method
      * @param err Reference to the error, which will be computed and updated to check convergence
      */
-    void solver_step(int& iter, std::unique_ptr<StepperBase<T>>& stepper, double& err);
+    void solver_step(int& iter, StepperPointer<T>& stepper, double& err);
     /** @brief Saves the result of a step in a defined row of the results' matrix.
      *
      * @param iter The row index in which to store the result
      * @param result_to_save 2-dimensional vector storing the new guess x(i) and the evaluation at it f(x(i))
      */
-    void save_results(int iter, Eigen::Vector2d result_to_save);
+    void save_results(int iter, Point<Scalar> result_to_save);
     /** @brief Returns a row of the results' matrix.
      *
      * @param step_length tells how far to go up from the bottom row
      * @return 2-dimensional vector storing x(end - step_length) and f(x(end - step_length))
      */
-    Eigen::Vector2d get_previous_result(int step_length);
+    Point<Scalar> get_previous_result(int step_length);
     /** @brief Computes the error of the latest iteration
      *
      * @param x_next The new guess x(i)
      * @param x_prev The old guess x(i-1)
      * @return |x_next - x_prev|
      */
-    double calculate_error(double x_prev, double x_next);
+    double calculate_error(const Scalar& x_prev, const Scalar& x_next) const;
     /** @brief Saves the actual initial guess in the top row of the results' matrix, no matter what type will be the
      * Class argument initial_guess.
      */
@@ -78,7 +142,93 @@ class Solver {
      *
      * @param stepper The original abstract stepper to be converted
      */
-    void convert_stepper(std::unique_ptr<StepperBase<T>>& stepper);
+    void convert_stepper(StepperPointer<T>& stepper);
+    /**
+     * @brief Creates the typed stepper of the method, working on the given functions
+     *
+     * @param initial_guess The initial guess(es) or interval of the process
+     * @param fun The function to find the root of, as seen by the stepper
+     * @param auxiliary The derivative or g function, as seen by the stepper
+     * @param resource The memory to allocate the stepper from
+     * @return The stepper, or nullptr if the method is not compatible with the type of the initial guess
+     */
+    StepperPointer<T> make_stepper(const T& initial_guess, std::function<Scalar(Scalar)> fun,
+                                   std::function<Scalar(Scalar)> auxiliary,
+                                   std::pmr::memory_resource* resource = std::pmr::new_delete_resource()) const;
+    /** @brief Returns the memory a process run in a SolveContext needs to start
+     *
+     * @return Bytes for the largest stepper and for the first block of the trajectory, which doubles when full
+     */
+    std::size_t process_bytes() const;
+    /** @brief Returns the point at which the process starts: the guess itself, or the end of the interval
+     *
+     * @param initial_guess The initial guess(es) or interval of the process
+     * @return x(0)
+     */
+    static Scalar starting_point(const T& initial_guess);
+    SolverStatus status = SolverStatus::CONVERGED;  //!< How the latest solving process ended
+    long evaluations = 0;  //!< Calls of the function (and of the derivative or g function) in the latest process
+    /** @brief Checked before every iteration, the latest process ends once a stop is requested */
+    std::stop_token stop_token;
+    std::chrono::nanoseconds time_limit{0};  //!< Wall-clock time allowed to a process, no limit if zero
+    long max_evaluations = 0;                //!< Function evaluations allowed to a process, no limit if zero
+    Point<Scalar> best_estimate;             //!< The iterate of the latest process with the smallest |f(x)|
+    /** @brief Tells whether the process may start another iteration without exceeding its limits.
+     *
+     * @param evaluations The function evaluations of the process so far
+     * @param deadline The instant at which the time limit of the process is reached, read only if there is one
+     * @return false once the budget of evaluations is spent or the deadline has passed
+     */
+    bool within_limits(long evaluations, std::chrono::steady_clock::time_point deadline) const;
+    /** @brief Tells whether a stop was requested, through the token of the process or the one of the Solver
+     *
+     * @param stop The stop token given to the process, if any
+     * @return true once either token is stopped
+     */
+    bool stop_requested(const std::stop_token& stop) const;
+    /** @brief Tells whether the process goes on with another iteration.
+     *
+     * @param iter The index of the next iteration
+     * @param err The error of the latest iteration
+     * @param f_last The value of the function at the latest iterate
+     * @param evaluations The function evaluations of the process so far
+     * @param stop The stop token given to the process, if any
+     * @param deadline The instant at which the time limit of the process is reached
+     * @return false once the process converged, or reached one of its limits, or was asked to stop
+     */
+    bool keep_iterating(int iter, double err, const Scalar& f_last, long evaluations, const std::stop_token& stop,
+                        std::chrono::steady_clock::time_point deadline) const;
+    /** @brief Tells how a process ended, once it stopped iterating.
+     *
+     * @param iter The index of the iteration which would have come next
+     * @param err The error of the latest iteration
+     * @param last The latest iterate x(i) and f(x(i))
+     * @param evaluations The function evaluations of the process
+     * @param stop The stop token given to the process, if any
+     * @return The status of the process
+     */
+    SolverStatus final_status(int iter, double err, const Point<Scalar>& last, long evaluations,
+                              const std::stop_token& stop) const;
+    /**
+     * @brief Replaces the functions with wrappers counting their evaluations for the duration of a process, and
+     * restores them on destruction (which also happens when a streamed process is abandoned before its end).
+     */
+    class CountingScope {
+      public:
+        /** @brief Resets the counter of the solver and wraps its functions
+         *
+         * @param solver The solver running the process
+         */
+        explicit CountingScope(Solver& solver);
+        ~CountingScope();
+        CountingScope(const CountingScope&) = delete;
+        CountingScope& operator=(const CountingScope&) = delete;
+
+      private:
+        Solver& solver;                           //!< The solver running the process
+        std::function<Scalar(Scalar)> function;   //!< The function of the solver, restored at the end
+        std::function<Scalar(Scalar)> auxiliary;  //!< The derivative or g function, restored at the end
+    };
 
   public:
     /**
@@ -92,7 +242,7 @@ class Solver {
      * @param aitken_mode Option to apply Aitken's acceleration
      * @param verbose Option to give verbose output
      */
-    Solver(std::function<double(double)> fun, T initial_guess, const Method method, int max_iterations,
+    Solver(std::function<Scalar(Scalar)> fun, T initial_guess, const Method method, int max_iterations,
            double tolerance, bool aitken_mode, bool verbose);
     /**
      * @brief Constructor for Solver object
@@ -106,13 +256,87 @@ class Solver {
      * @param verbose Option to give verbose output
      * @param derivative_or_function_g The derivative of the function (for Newton) or g_function (for Fixed Point)
      */
-    Solver(std::function<double(double)> fun, T initial_guess, const Method method, int max_iterations,
-           double tolerance, bool aitken_mode, bool verbose, std::function<double(double)> derivative_or_function_g);
+    Solver(std::function<Scalar(Scalar)> fun, T initial_guess, const Method method, int max_iterations,
+           double tolerance, bool aitken_mode, bool verbose, std::function<Scalar(Scalar)> derivative_or_function_g);
     /** @brief Calls everything required to Solve with a method.
      *
      * @return Matrix storing in the first column x(i) for each iteration i, in the second column f(x(i))
      */
-    Eigen::MatrixX2d solve();
+    Trajectory<Scalar> solve();
+    /** @brief Solves from the given initial guess, without modifying the Solver: any number of threads may call it
+     * at once on the same object.
+     *
+     * The Solver only holds the definition of the problem (functions, method, tolerance, limits); the state of the
+     * process (stepper, counters, trajectory) lives on the stack of the call. The functions are not copied: the
+     * stepper calls them through wrappers holding pointers to them and to the counter of the call, so they must be
+     * safe to call concurrently. Nothing is written on the console, whatever the verbose flag.
+     *
+     * @param initial_guess The initial guess(es) or interval, replacing the one given to the constructor
+     * @param stop Ends this process before its next iteration once a stop is requested (the token given to
+     * set_stop_token() ends every process)
+     * @return The trajectory, the status, the number of evaluations and the best iterate of the process
+     */
+    BasicSolution<Scalar> solve(const T& initial_guess, std::stop_token stop = {}) const;
+    /** @brief Solves from the given initial guess like solve(initial_guess, stop), with the memory of a context.
+     *
+     * The stepper and the trajectory are allocated in the arena of the context, which the process resets first:
+     * reusing a context from one problem to the next, no heap allocation is made once its buffer fits the largest
+     * problem (the functions must not allocate either). A context serves one process at a time, so concurrent
+     * callers each need their own.
+     *
+     * @param initial_guess The initial guess(es) or interval, replacing the one given to the constructor
+     * @param context The memory of the process, which also holds the returned trajectory until its next process
+     * @param stop Ends this process before its next iteration once a stop is requested
+     * @return The trajectory, the status, the number of evaluations and the best iterate of the process
+     */
+    BasicSolutionView<Scalar> solve(const T& initial_guess, SolveContext& context,
+                                    std::stop_token stop = {}) const;
+    /** @brief Streams the iterates of a solving process, each one computed only when the consumer asks for it.
+     *
+     * The process follows the same steps and stopping rules as solve(), but keeps no trajectory: only the latest
+     * iterate is stored, and nothing is written on the console. The consumer may stop early by leaving the loop over
+     * the generator; the status, the number of evaluations and the best estimate are set once the generator has
+     * run to its end. The Solver must outlive the generator.
+     *
+     * @return Generator of x(i) and f(x(i)), from the starting point x(0) to the last iterate
+     */
+    Generator<Point<Scalar>> iterate();
+    /** @brief Returns how the latest solving process ended.
+     *
+     * @return CONVERGED, MAX_ITERATIONS or DIVERGED
+     */
+    SolverStatus get_status() const { return this->status; }
+    /** @brief Returns the number of function evaluations of the latest solving process.
+     *
+     * @return Calls of the function, plus calls of the derivative (Newton) or of the g function (Fixed Point)
+     */
+    long get_evaluations() const { return this->evaluations; }
+    /** @brief Lets another thread end the solving processes cooperatively, for instance when racing several methods.
+     *
+     * The token is checked before every iteration: once a stop is requested, the running process returns the
+     * iterations computed so far with the CANCELLED status (unless it already converged).
+     *
+     * @param token The stop token, associated with the std::stop_source requesting the stop
+     */
+    void set_stop_token(std::stop_token token) { this->stop_token = std::move(token); }
+    /** @brief Bounds the cost of every solving process, whatever the cost of one iteration.
+     *
+     * The limits are checked before every iteration, so a process may exceed its budget of evaluations by the
+     * evaluations of one step. A process ending on a limit has the TIMED_OUT or BUDGET_EXHAUSTED status, and its
+     * best estimate is given by get_best_estimate().
+     *
+     * @param time_limit Wall-clock time allowed to a process, no limit if zero
+     * @param max_evaluations Calls of the function (and of the derivative or g function) allowed, no limit if zero
+     */
+    void set_limits(std::chrono::nanoseconds time_limit, long max_evaluations) {
+        this->time_limit = time_limit;
+        this->max_evaluations = max_evaluations;
+    }
+    /** @brief Returns the best estimate of the root found by the latest solving process.
+     *
+     * @return x(i) and f(x(i)) for the iteration i with the smallest |f(x(i))|
+     */
+    Point<Scalar> get_best_estimate() const { return this->best_estimate; }
 };
 
 #endif  // ROOT_SOLVER_DEF_HPP
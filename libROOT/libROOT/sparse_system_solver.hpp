@@ -0,0 +1,221 @@
+/**
+ * @file sparse_system_solver.hpp
+ * @brief Contains the SparseSystemSolver class, which finds a root of a large system of non-linear equations whose
+ * Jacobian is sparse
+ *
+ * The iterations are the damped Newton ones of the SystemSolver, with the Jacobian stored in an Eigen::SparseMatrix
+ * whose structure is given by the user. Without an analytic Jacobian, the columns are colored so that two columns of
+ * the same color have no non-zero in a common row: a single evaluation of F, with all the unknowns of a color shifted
+ * at once, then gives the finite differences of all these columns, and a Jacobian costs as many evaluations as there
+ * are colors (3 for a tridiagonal matrix, whatever its size) instead of one per unknown. The linear systems are
+ * solved by SparseLU, whose ordering and symbolic factorization are computed once since the structure never changes,
+ * or by BiCGSTAB with an incomplete LU preconditioner.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef ROOT_SPARSE_SYSTEM_SOLVER_HPP
+#define ROOT_SPARSE_SYSTEM_SOLVER_HPP
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "method.hpp"
+#include "system_solver.hpp"
+
+/**
+ * @brief Enumeration of the linear solvers a SparseSystemSolver can use.
+ *
+ */
+enum SparseLinearSolver {
+    SPARSE_LU,  //!< Direct sparse LU, with the symbolic analysis reused across iterations.
+    BICGSTAB    //!< Iterative BiCGSTAB preconditioned by an incomplete LU, for systems too large to factorize.
+};
+
+/**
+ * @brief Class SparseSystemSolver managing the damped Newton process on a system with a sparse Jacobian
+ */
+class SparseSystemSolver {
+  public:
+    using Function = SystemSolver::Function;  //!< F: R^n -> R^n
+    /** @brief Sparse J: R^n -> R^(n x n) */
+    using Jacobian = std::function<Eigen::SparseMatrix<double>(const Eigen::VectorXd&)>;
+
+  private:
+    friend class SystemSolverTester;                //!< Friend class for unit testing purposes
+    Function function;                              //!< The system to find the root of
+    Jacobian jacobian;                              //!< The Jacobian of F, approximated if empty
+    Eigen::SparseMatrix<double> pattern;            //!< The structure of the Jacobian, compressed
+    std::vector<std::vector<Eigen::Index>> colors;  //!< The columns of each color
+    int max_iterations;                             //!< Maximum number of Newton iterations
+    double tolerance;                               //!< Tolerance on ||F(x)|| or on a full step
+    SparseLinearSolver linear_solver = SPARSE_LU;   //!< Solver of the linear systems
+    int reuse = 1;                                  //!< Iterations a factorization may serve
+
+    /** @brief Colors the columns of the pattern greedily, in their natural order: each column takes the smallest
+     * color not used by a column sharing one of its rows.
+     */
+    void color_columns() {
+        const Eigen::Index n = this->pattern.cols();
+        const Eigen::SparseMatrix<double, Eigen::RowMajor> rows = this->pattern;
+        std::vector<Eigen::Index> color(n, -1);
+        // forbidden[c] == j once color c is used by a neighbor of column j, which spares clearing it for each column
+        std::vector<Eigen::Index> forbidden(n + 1, -1);
+        for (Eigen::Index j = 0; j < n; ++j) {
+            for (Eigen::SparseMatrix<double>::InnerIterator entry(this->pattern, j); entry; ++entry) {
+                for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator neighbor(rows, entry.row());
+                     neighbor; ++neighbor) {
+                    if (color[neighbor.col()] >= 0) {
+                        forbidden[color[neighbor.col()]] = j;
+                    }
+                }
+            }
+            Eigen::Index chosen = 0;
+            while (forbidden[chosen] == j) {
+                ++chosen;
+            }
+            color[j] = chosen;
+            if (chosen == static_cast<Eigen::Index>(this->colors.size())) {
+                this->colors.emplace_back();
+            }
+            this->colors[chosen].push_back(j);
+        }
+    }
+    /** @brief Approximates the Jacobian with forward differences, one evaluation of F per color
+     *
+     * @param x The point at which the Jacobian is approximated
+     * @param fx F(x)
+     * @param evaluations The counter of evaluations of F, increased by the number of colors
+     * @param matrix The Jacobian, with the structure of the pattern, whose values are overwritten
+     */
+    void finite_differences(const Eigen::VectorXd& x, const Eigen::VectorXd& fx, long& evaluations,
+                            Eigen::SparseMatrix<double>& matrix) const {
+        Eigen::VectorXd shifted = x;
+        for (const std::vector<Eigen::Index>& columns : this->colors) {
+            for (Eigen::Index column : columns) {
+                shifted(column) +=
+                    std::sqrt(std::numeric_limits<double>::epsilon()) * std::max(std::abs(x(column)), 1.0);
+            }
+            Eigen::VectorXd difference = this->function(shifted) - fx;
+            ++evaluations;
+            // the columns of a color have their non-zeros in distinct rows, so each row of the difference is theirs
+            for (Eigen::Index column : columns) {
+                double step = shifted(column) - x(column);
+                for (Eigen::SparseMatrix<double>::InnerIterator entry(matrix, column); entry; ++entry) {
+                    entry.valueRef() = difference(entry.row()) / step;
+                }
+                shifted(column) = x(column);
+            }
+        }
+    }
+
+    /** @brief Checks that a Jacobian is compressed and has exactly the structure of the pattern
+     *
+     * @param matrix The Jacobian given by the user
+     * @return Whether the symbolic analysis of the pattern holds for the matrix
+     */
+    bool has_pattern(const Eigen::SparseMatrix<double>& matrix) const {
+        return matrix.isCompressed() && matrix.rows() == this->pattern.rows() &&
+               matrix.cols() == this->pattern.cols() && matrix.nonZeros() == this->pattern.nonZeros() &&
+               std::equal(matrix.outerIndexPtr(), matrix.outerIndexPtr() + matrix.outerSize() + 1,
+                          this->pattern.outerIndexPtr()) &&
+               std::equal(matrix.innerIndexPtr(), matrix.innerIndexPtr() + matrix.nonZeros(),
+                          this->pattern.innerIndexPtr());
+    }
+
+  public:
+    /**
+     * @brief Constructor for SparseSystemSolver object
+     *
+     * @param fun The system F to find the root of
+     * @param pattern A matrix whose non-zeros (their values are ignored) are the entries of the Jacobian which can be
+     * non-zero
+     * @param max_iterations Maximum iterations in which the method has to converge
+     * @param tolerance The tolerance below which ||F(x)|| (max norm), or the max norm of an undamped step, make the
+     * method converge
+     * @param jacobian The Jacobian of F, with the structure of the pattern (compressed), approximated with colored
+     * forward differences if empty
+     */
+    SparseSystemSolver(Function fun, Eigen::SparseMatrix<double> pattern, int max_iterations, double tolerance,
+                       Jacobian jacobian = {})
+        : function(std::move(fun)),
+          jacobian(std::move(jacobian)),
+          pattern(std::move(pattern)),
+          max_iterations(max_iterations),
+          tolerance(tolerance) {
+        this->pattern.makeCompressed();
+        this->pattern.coeffs().setZero();
+        this->color_columns();
+    }
+
+    /** @brief Chooses how the linear systems of the iterations are solved
+     *
+     * @param linear_solver SPARSE_LU, or BICGSTAB for systems whose LU factors do not fit in memory
+     * @param reuse Iterations a factorization (or preconditioner) may serve before the Jacobian is computed again
+     */
+    void set_linear_solver(SparseLinearSolver linear_solver, int reuse = 1) {
+        this->linear_solver = linear_solver;
+        this->reuse = std::max(reuse, 1);
+    }
+    /** @brief Returns the number of colors of the columns of the pattern
+     *
+     * @return The evaluations of F a finite-difference Jacobian costs
+     */
+    std::size_t get_colors() const { return this->colors.size(); }
+
+    /** @brief Solves from the given initial guess, without modifying the SparseSystemSolver
+     *
+     * @param initial_guess x(0), whose size is the number of columns of the pattern
+     * @return The trajectory, the status and the counters of the process, as for a SystemSolver; DIVERGED as well
+     * when BiCGSTAB does not converge, or when SparseLU is given a Jacobian which does not have the structure of the
+     * pattern
+     */
+    SystemSolution solve(const Eigen::VectorXd& initial_guess) const;
+};
+
+inline SystemSolution SparseSystemSolver::solve(const Eigen::VectorXd& initial_guess) const {
+    Eigen::SparseMatrix<double> matrix = this->pattern;
+    Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> lu;
+    Eigen::BiCGSTAB<Eigen::SparseMatrix<double>, Eigen::IncompleteLUT<double>> bicgstab;
+    bool analyzed = false;
+    auto factorize = [this, &matrix, &lu, &bicgstab, &analyzed](const Eigen::VectorXd& x, const Eigen::VectorXd& fx,
+                                                              long& evaluations) {
+        if (this->jacobian) {
+            matrix = this->jacobian(x);
+        } else {
+            this->finite_differences(x, fx, evaluations, matrix);
+        }
+        if (this->linear_solver == BICGSTAB) {
+            bicgstab.compute(matrix);
+            return bicgstab.info() == Eigen::Success;
+        }
+        // the structure of the Jacobian never changes, so its ordering and symbolic analysis are computed once; a
+        // Jacobian of another structure would be factorized with the wrong analysis
+        if (this->jacobian && !this->has_pattern(matrix)) {
+            return false;
+        }
+        if (!analyzed) {
+            lu.analyzePattern(matrix);
+            analyzed = true;
+        }
+        lu.factorize(matrix);
+        return lu.info() == Eigen::Success;
+    };
+    auto solve = [this, &lu, &bicgstab](const Eigen::VectorXd& rhs, Eigen::VectorXd& step) {
+        if (this->linear_solver == BICGSTAB) {
+            step = bicgstab.solve(rhs);
+            return bicgstab.info() == Eigen::Success;
+        }
+        step = lu.solve(rhs);
+        return lu.info() == Eigen::Success;
+    };
+    return damped_newton(this->function, initial_guess, this->max_iterations, this->tolerance, this->reuse, factorize,
+                         solve);
+}
+
+#endif  // ROOT_SPARSE_SYSTEM_SOLVER_HPP
@@ -2,19 +2,21 @@
 #define ROOT_STEPPER_HPP
 
 #include <Eigen/Dense>
+#include <algorithm>
+#include <complex>
 #include <functional>
 #include <iostream>
 
 #include "stepper_def.hpp"
 
 template <typename T>
-StepperBase<T>::StepperBase(std::function<double(double)> fun, bool aitken_mode) {
+StepperBase<T>::StepperBase(std::function<Scalar(Scalar)> fun, bool aitken_mode) {
     this->function = fun;
     this->aitken_requirement = aitken_mode;
 }
 
 template <typename T>
-Eigen::Vector2d StepperBase<T>::step(Eigen::Vector2d previous_step) {
+Point<typename StepperBase<T>::Scalar> StepperBase<T>::step(Point<Scalar> previous_step) {
     if (!this->aitken_requirement) {
         return this->compute_step(previous_step);
     } else {
@@ -23,89 +25,120 @@ Eigen::Vector2d StepperBase<T>::step(Eigen::Vector2d previous_step) {
 }
 
 template <typename T>
-Eigen::Vector2d StepperBase<T>::aitken_step(Eigen::Vector2d previous_iter) {
-    Eigen::Vector2d iter_one = this->compute_step(previous_iter);
-    Eigen::Vector2d iter_two = this->compute_step(iter_one);
-    double denominator = (iter_two(0) - iter_one(0)) / (iter_one(0) - previous_iter(0));
-    if (denominator == 0) {
+Point<typename StepperBase<T>::Scalar> StepperBase<T>::aitken_step(Point<Scalar> previous_iter) {
+    Point<Scalar> iter_one = this->compute_step(previous_iter);
+    Point<Scalar> iter_two = this->compute_step(iter_one);
+    Scalar denominator = (iter_two(0) - iter_one(0)) / (iter_one(0) - previous_iter(0));
+    if (denominator == Scalar(0)) {
         std::cerr << "\033[31mCaught error: Division by 0. The method will diverge\033[0m" << std::endl;
     }
-    double new_point = iter_two(0) - (pow(iter_two(0) - iter_one(0), 2) / denominator);
+    Scalar new_point = iter_two(0) - ((iter_two(0) - iter_one(0)) * (iter_two(0) - iter_one(0)) / denominator);
     return {new_point, function(new_point)};
 }
 
-template <>
-NewtonRaphsonStepper<double>::NewtonRaphsonStepper(std::function<double(double)> fun, bool aitken_mode,
-                                                   std::function<double(double)> der)
-    : StepperBase<double>(fun, aitken_mode) {
+template <typename T>
+NewtonRaphsonStepper<T>::NewtonRaphsonStepper(std::function<Scalar(Scalar)> fun, bool aitken_mode,
+                                              std::function<Scalar(Scalar)> der)
+    : StepperBase<T>(fun, aitken_mode) {
     this->derivative = der;
 }
 
-template <>
-Eigen::Vector2d NewtonRaphsonStepper<double>::compute_step(Eigen::Vector2d previous_iteration) {
-    double denominator = derivative(previous_iteration(0));
-    if (denominator == 0) {
+template <typename T>
+Point<typename NewtonRaphsonStepper<T>::Scalar> NewtonRaphsonStepper<T>::compute_step(
+    Point<Scalar> previous_iteration) {
+    Scalar denominator = derivative(previous_iteration(0));
+    if (denominator == Scalar(0)) {
         std::cerr << "\033[31mCaught error: Division by 0. The method will diverge\033[0m" << std::endl;
     }
-    double new_point = previous_iteration(0) - previous_iteration(1) / denominator;
-    double new_eval = this->function(new_point);
+    Scalar new_point = previous_iteration(0) - previous_iteration(1) / denominator;
+    Scalar new_eval = this->function(new_point);
     return {new_point, new_eval};
 }
 
-template <>
-FixedPointStepper<double>::FixedPointStepper(std::function<double(double)> fun, bool aitken_mode,
-                                             std::function<double(double)> g_fun)
-    : StepperBase<double>(fun, aitken_mode) {
+template <typename T>
+FixedPointStepper<T>::FixedPointStepper(std::function<Scalar(Scalar)> fun, bool aitken_mode,
+                                        std::function<Scalar(Scalar)> g_fun)
+    : StepperBase<T>(fun, aitken_mode) {
     this->fixed_point_function = g_fun;
 }
 
-template <>
-Eigen::Vector2d FixedPointStepper<double>::compute_step(Eigen::Vector2d previous_iteration) {
-    double new_point = this->fixed_point_function(previous_iteration(0));
-    double new_eval = this->function(new_point);
+template <typename T>
+Point<typename FixedPointStepper<T>::Scalar> FixedPointStepper<T>::compute_step(Point<Scalar> previous_iteration) {
+    Scalar new_point = this->fixed_point_function(previous_iteration(0));
+    Scalar new_eval = this->function(new_point);
     return {new_point, new_eval};
 }
 
-template <>
-ChordsStepper<Eigen::Vector2d>::ChordsStepper(std::function<double(double)> fun, bool aitken_mode, Eigen::Vector2d _int)
-    : StepperBase<Eigen::Vector2d>(fun, aitken_mode) {
+template <typename T>
+ChordsStepper<T>::ChordsStepper(std::function<Scalar(Scalar)> fun, bool aitken_mode, Point<Scalar> _int)
+    : StepperBase<T>(fun, aitken_mode) {
     auto interval = _int;
     this->iter_minus_1 = interval(0);
     this->iter_zero = interval(1);
 }
 
-template <>
-Eigen::Vector2d ChordsStepper<Eigen::Vector2d>::compute_step(Eigen::Vector2d last_iter) {
-    double numerator = this->iter_zero - this->iter_minus_1;
-    double denominator = last_iter(1) - this->function(this->iter_minus_1);
-    if (denominator == 0) {
+template <typename T>
+Point<typename ChordsStepper<T>::Scalar> ChordsStepper<T>::compute_step(Point<Scalar> last_iter) {
+    Scalar numerator = this->iter_zero - this->iter_minus_1;
+    Scalar denominator = last_iter(1) - this->function(this->iter_minus_1);
+    if (denominator == Scalar(0)) {
         std::cerr << "\033[31mCaught error: Division by 0. The method will diverge\033[0m" << std::endl;
     }
-    double new_point = this->iter_zero - last_iter(1) * numerator / denominator;
+    Scalar new_point = this->iter_zero - last_iter(1) * numerator / denominator;
     this->iter_minus_1 = this->iter_zero;
     this->iter_zero = new_point;
     return {new_point, this->function(new_point)};
 }
 
-template <>
-BisectionStepper<Eigen::Vector2d>::BisectionStepper(std::function<double(double)> fun, bool aitken_mode,
-                                                    Eigen::Vector2d _int)
-    : StepperBase<Eigen::Vector2d>(fun, aitken_mode) {
+template <typename T>
+MullerStepper<T>::MullerStepper(std::function<Scalar(Scalar)> fun, bool aitken_mode)
+    : StepperBase<T>(fun, aitken_mode) {}
+
+template <typename T>
+Point<typename MullerStepper<T>::Scalar> MullerStepper<T>::compute_step(Point<Scalar> last_iter) {
+    if (!this->started) {
+        Scalar h = Scalar(0.5 * std::max(magnitude(last_iter(0)), 1.0));
+        this->older = {last_iter(0) - h, this->function(last_iter(0) - h)};
+        this->old = {last_iter(0) + h, this->function(last_iter(0) + h)};
+        this->started = true;
+    }
+    Scalar h1 = this->old(0) - this->older(0);
+    Scalar h2 = last_iter(0) - this->old(0);
+    Scalar d1 = (this->old(1) - this->older(1)) / h1;
+    Scalar d2 = (last_iter(1) - this->old(1)) / h2;
+    Scalar a = (d2 - d1) / (h2 + h1);
+    Scalar b = a * h2 + d2;
+    using std::sqrt;
+    Scalar root = sqrt(b * b - Scalar(4) * a * last_iter(1));
+    // the larger denominator picks the root of the parabola closest to x(i-1), without cancellation
+    Scalar denominator = magnitude(b + root) >= magnitude(b - root) ? b + root : b - root;
+    if (denominator == Scalar(0)) {
+        std::cerr << "\033[31mCaught error: Division by 0. The method will diverge\033[0m" << std::endl;
+    }
+    Scalar new_point = last_iter(0) - Scalar(2) * last_iter(1) / denominator;
+    this->older = this->old;
+    this->old = last_iter;
+    return {new_point, this->function(new_point)};
+}
+
+template <typename T>
+BisectionStepper<T>::BisectionStepper(std::function<Scalar(Scalar)> fun, bool aitken_mode, Point<Scalar> _int)
+    : StepperBase<T>(fun, aitken_mode) {
     auto interval = _int;
     this->left_edge = interval(0);
     this->right_edge = interval(1);
 }
 
-template <>
-Eigen::Vector2d BisectionStepper<Eigen::Vector2d>::compute_step(Eigen::Vector2d last_iter) {
-    if (this->function(left_edge) == 0) {
+template <typename T>
+Point<typename BisectionStepper<T>::Scalar> BisectionStepper<T>::compute_step(Point<Scalar> last_iter) {
+    if (this->function(left_edge) == Scalar(0)) {
         return {left_edge, this->function(left_edge)};
     }
-    if (this->function(right_edge) == 0) {
+    if (this->function(right_edge) == Scalar(0)) {
         return {right_edge, this->function(right_edge)};
     }
-    double x_new = (this->left_edge + this->right_edge) / 2;
-    if (this->function(x_new) * this->function(this->left_edge) < 0) {
+    Scalar x_new = (this->left_edge + this->right_edge) / Scalar(2);
+    if (this->function(x_new) * this->function(this->left_edge) < Scalar(0)) {
         this->right_edge = x_new;
     } else {
         this->left_edge = x_new;
@@ -113,12 +146,36 @@ Eigen::Vector2d BisectionStepper<Eigen::Vector2d>::compute_step(Eigen::Vector2d
     return {x_new, this->function(x_new)};
 }
 
+// the open methods step from a scalar guess, the bracketing ones from an interval, in every supported precision; only
+// the open methods take complex guesses, an interval having no meaning in the complex plane
+template class StepperBase<float>;
 template class StepperBase<double>;
-template class StepperBase<Eigen::Vector2d>;
-
+template class StepperBase<long double>;
+template class StepperBase<DoubleDouble>;
+template class StepperBase<Point<float>>;
+template class StepperBase<Point<double>>;
+template class StepperBase<Point<long double>>;
+template class StepperBase<Point<DoubleDouble>>;
+template class StepperBase<std::complex<double>>;
+
+template class NewtonRaphsonStepper<float>;
 template class NewtonRaphsonStepper<double>;
+template class NewtonRaphsonStepper<long double>;
+template class NewtonRaphsonStepper<DoubleDouble>;
+template class FixedPointStepper<float>;
 template class FixedPointStepper<double>;
-template class BisectionStepper<Eigen::Vector2d>;
-template class ChordsStepper<Eigen::Vector2d>;
+template class FixedPointStepper<long double>;
+template class FixedPointStepper<DoubleDouble>;
+template class NewtonRaphsonStepper<std::complex<double>>;
+template class FixedPointStepper<std::complex<double>>;
+template class MullerStepper<std::complex<double>>;
+template class BisectionStepper<Point<float>>;
+template class BisectionStepper<Point<double>>;
+template class BisectionStepper<Point<long double>>;
+template class BisectionStepper<Point<DoubleDouble>>;
+template class ChordsStepper<Point<float>>;
+template class ChordsStepper<Point<double>>;
+template class ChordsStepper<Point<long double>>;
+template class ChordsStepper<Point<DoubleDouble>>;
 
 #endif  // ROOT_STEPPER_HPP
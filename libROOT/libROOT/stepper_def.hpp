@@ -15,15 +15,25 @@
 #define ROOT_STEPPER_DEF_HPP
 
 #include <Eigen/Dense>
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+#include "scalar.hpp"
 
 /**
  * @brief The virtual mother stepper class which defines constructor and method in common for all the methods.
  */
 template <typename T>
 class StepperBase {
+  public:
+    using Scalar = scalar_of_t<T>;  //!< The type of the iterates and of the values of the function
+
   protected:
-    std::function<double(double)> function;  //!< Function to compute the root of
+    std::function<Scalar(Scalar)> function;  //!< Function to compute the root of
     bool aitken_requirement;                 //!< Option to use Aitken's acceleration
     /**
      * @brief Virtual function to compute the step for the method -> overridden by all the methods
@@ -31,14 +41,14 @@ class StepperBase {
      * @param previous_iteration 2-dimensional vector storing x(i-1) and f(x(i-1)) - previous guesses
      * @return 2-dimensional vector storing x(i) and f(x(i)) - new guesses
      */
-    virtual Eigen::Vector2d compute_step(Eigen::Vector2d) = 0;
+    virtual Point<Scalar> compute_step(Point<Scalar>) = 0;
     /**
      * @brief Method to handle the computation of a step using Aitken's acceleration
      *
      * @param previous_iter 2-dimensional vector storing x(i-1) and f(x(i-1))
      * @return 2-dimensional vector storing x(i) - computed with the 3 Aitken's steps - and f(x(i))
      */
-    Eigen::Vector2d aitken_step(Eigen::Vector2d previous_iter);
+    Point<Scalar> aitken_step(Point<Scalar> previous_iter);
 
   public:
     /**
@@ -47,7 +57,7 @@ class StepperBase {
      * @param fun Function to compute the root of
      * @param aitken_mode Option to apply or not the Aitken's acceleration
      */
-    StepperBase(std::function<double(double)> fun, bool aitken_mode);
+    StepperBase(std::function<Scalar(Scalar)> fun, bool aitken_mode);
     virtual ~StepperBase() = default;
     /**
      * @brief Method handling all the steps involved in computing the new guess
@@ -55,16 +65,56 @@ class StepperBase {
      * @param previous_step 2-dimensional vector storing x(i-1) and f(x(i-1)) previous guesses of the method
      * @return 2-dimensional vector storing x(i) and f(x(i)) new guesses of the method
      */
-    Eigen::Vector2d step(Eigen::Vector2d previous_step);
+    Point<Scalar> step(Point<Scalar> previous_step);
+};
+
+/**
+ * @brief Destroys a stepper and gives its memory back to the resource it was allocated from
+ */
+template <typename T>
+struct StepperDeleter {
+    std::pmr::memory_resource* resource = std::pmr::new_delete_resource();  //!< The resource holding the stepper
+    std::size_t size = 0;                                                   //!< Size of the concrete stepper
+    std::size_t alignment = alignof(std::max_align_t);                      //!< Alignment of the concrete stepper
+
+    /** @brief Destroys the stepper and deallocates it
+     *
+     * @param stepper The stepper, allocated by allocate_stepper()
+     */
+    void operator()(StepperBase<T>* stepper) const {
+        stepper->~StepperBase<T>();
+        this->resource->deallocate(stepper, this->size, this->alignment);
+    }
 };
 
+/** @brief Owning pointer to a stepper allocated from a memory resource */
+template <typename T>
+using StepperPointer = std::unique_ptr<StepperBase<T>, StepperDeleter<T>>;
+
+/**
+ * @brief Creates a stepper in the memory of a resource (the heap, or the arena of a SolveContext)
+ *
+ * @param resource The resource to allocate the stepper from
+ * @param args The arguments of the constructor of the stepper
+ * @return The stepper, deallocated from the same resource when the pointer is destroyed
+ */
+template <template <typename> class Stepper, typename T, typename... Args>
+StepperPointer<T> allocate_stepper(std::pmr::memory_resource* resource, Args&&... args) {
+    void* memory = resource->allocate(sizeof(Stepper<T>), alignof(Stepper<T>));
+    auto* stepper = ::new (memory) Stepper<T>(std::forward<Args>(args)...);
+    return StepperPointer<T>(stepper, StepperDeleter<T>{resource, sizeof(Stepper<T>), alignof(Stepper<T>)});
+}
+
 /**
  * @brief The specialized Stepper to compute a step with the Newton-Raphson method.
  */
 template <typename T>
 class NewtonRaphsonStepper : public StepperBase<T> {
+  public:
+    using Scalar = scalar_of_t<T>;  //!< The type of the iterates and of the values of the function
+
   private:
-    std::function<double(double)> derivative;  //!< Stores the derivative of the function
+    std::function<Scalar(Scalar)> derivative;  //!< Stores the derivative of the function
 
   public:
     /** @brief The specialized constructor - initializes the function and the derivative
@@ -73,20 +123,23 @@ class NewtonRaphsonStepper : public StepperBase<T> {
      * @param aitken_mode Option to use Aitken's acceleration
      * @param der The derivative of the function, needed for NR method
      */
-    NewtonRaphsonStepper(std::function<double(double)> fun, bool aitken_mode, std::function<double(double)> der);
+    NewtonRaphsonStepper(std::function<Scalar(Scalar)> fun, bool aitken_mode, std::function<Scalar(Scalar)> der);
     /** @brief Specialized method to compute and return a new step with NR
      *
      * @param previous_iteration 2-dimensional vector storing x(i-1) and f(x(i-1)) - previous guesses
      * @returns 2-dimensional vector storing x(i) = x(i-1) - f(x(i-1)) / f'(x(i-1)) and f(x(i)) - new guesses
      */
-    Eigen::Vector2d compute_step(Eigen::Vector2d previous_iteration) override;
+    Point<Scalar> compute_step(Point<Scalar> previous_iteration) override;
 };
 
 /** @brief The specialized Stepper to compute a step with the Fixed Point method*/
 template <typename T>
 class FixedPointStepper : public StepperBase<T> {
+  public:
+    using Scalar = scalar_of_t<T>;  //!< The type of the iterates and of the values of the function
+
   private:
-    std::function<double(double)> fixed_point_function;  //!< tores the fixed point to use in the steps
+    std::function<Scalar(Scalar)> fixed_point_function;  //!< tores the fixed point to use in the steps
 
   public:
     /** @brief The specialized constructor - initializes the function and the fixed point function
@@ -95,21 +148,24 @@ class FixedPointStepper : public StepperBase<T> {
      * @param aitken_mode Option to use Aitken's acceleration
      * @param g_fun The fixed point function such that g_fun(x) = x, needed for FP method
      */
-    FixedPointStepper(std::function<double(double)> fun, bool aitken_mode, std::function<double(double)> g_fun);
+    FixedPointStepper(std::function<Scalar(Scalar)> fun, bool aitken_mode, std::function<Scalar(Scalar)> g_fun);
     /**
      * @brief Specialized method to compute and return a new step with FP
      *
      * @param previous_iteration 2-dimensional vector storing x(i-1) and f(x(i-1)) - previous guesses
      * @return 2-dimensional vector storing x(i) = g_fun(x(i-1)) - where g_fun is the fixed point function - and f(x(i))
      */
-    Eigen::Vector2d compute_step(Eigen::Vector2d previous_iteration) override;
+    Point<Scalar> compute_step(Point<Scalar> previous_iteration) override;
 };
 
 /** \brief The specialized Stepper to compute a step with the Chords Method (also called Secants in literature)*/
 template <typename T>
 class ChordsStepper : public StepperBase<T> {
+  public:
+    using Scalar = scalar_of_t<T>;  //!< The type of the iterates and of the values of the function
+
   private:
-    double iter_minus_1, iter_zero;  //!< The two previous guesses required at each iteration
+    Scalar iter_minus_1, iter_zero;  //!< The two previous guesses required at each iteration
     // It could seem a bit redundant because the latest iteration is input in the compute_step method too, passed from
     // the Solver class, but it was more important to unify the compute_step calling with just one syntax.
   public:
@@ -119,7 +175,7 @@ class ChordsStepper : public StepperBase<T> {
      * @param aitken_mode Option to use Aitken's acceleration
      * @param _int 2-dimensional vector storing the two initial guesses x(-1) and x(0)
      */
-    ChordsStepper(std::function<double(double)> fun, bool aitken_mode, Eigen::Vector2d _int);
+    ChordsStepper(std::function<Scalar(Scalar)> fun, bool aitken_mode, Point<Scalar> _int);
     /** @brief Specialized method to compute and return a new step with Chords.
      *
      * After the computation, the two previous guesses are then updated for the next step.
@@ -128,14 +184,52 @@ class ChordsStepper : public StepperBase<T> {
      * @return 2-dimensional vector storing x(i) = x(i-1) - (x(i-1) - x(i-2)) / (f(x(i-1)) - f(x(i-2))) * f(x(i-1)) and
      * f(x(i)) - new guesses
      */
-    Eigen::Vector2d compute_step(Eigen::Vector2d previous_iteration) override;
+    Point<Scalar> compute_step(Point<Scalar> previous_iteration) override;
+};
+
+/** @brief The specialized Stepper to compute a step with Muller's method.
+ *
+ * A parabola is fitted through the latest three iterates and the next one is its root closest to the latest iterate.
+ * When the parabola does not cross the real line, the square root of its discriminant is imaginary: with a complex
+ * scalar, the iterates then leave the real line on their own and reach complex roots from a real guess.
+ */
+template <typename T>
+class MullerStepper : public StepperBase<T> {
+  public:
+    using Scalar = scalar_of_t<T>;  //!< The type of the iterates and of the values of the function
+
+  private:
+    Point<Scalar> older;   //!< x(i-3) and f(x(i-3))
+    Point<Scalar> old;     //!< x(i-2) and f(x(i-2))
+    bool started = false;  //!< False until the two points preceding the initial guess are created
+
+  public:
+    /** @brief Constructor for the MullerStepper class
+     *
+     * @param fun The function to compute the root of
+     * @param aitken_mode Option to use Aitken's acceleration
+     */
+    MullerStepper(std::function<Scalar(Scalar)> fun, bool aitken_mode);
+    /** @brief Specialized method to compute and return a new step with Muller's method.
+     *
+     * The first step creates the two points preceding the initial guess on each side of it, at a distance of half
+     * its magnitude (or of 0.5 near zero).
+     *
+     * @param previous_iteration 2-dimensional vector storing x(i-1) and f(x(i-1)) - old guesses
+     * @return 2-dimensional vector storing x(i) = x(i-1) - 2 f(x(i-1)) / (b +- sqrt(b^2 - 4 a f(x(i-1)))), a and b
+     * being the coefficients of the parabola, and f(x(i)) - new guesses
+     */
+    Point<Scalar> compute_step(Point<Scalar> previous_iteration) override;
 };
 
 /** @brief The specialized Stepper to compute a step with the Bisection Method*/
 template <typename T>
 class BisectionStepper : public StepperBase<T> {
+  public:
+    using Scalar = scalar_of_t<T>;  //!< The type of the iterates and of the values of the function
+
   private:
-    double left_edge, right_edge;  //!< Bounds of the interval to use (updated at each step)
+    Scalar left_edge, right_edge;  //!< Bounds of the interval to use (updated at each step)
 
   public:
     /** @brief Constructor of a BisectionStepper object
@@ -144,7 +238,7 @@ class BisectionStepper : public StepperBase<T> {
      * @param aitken_mode Option to use Aitken's acceleration
      * @param _int Initial interval such that f(_int(0))*f(_int(1)) < 0
      */
-    BisectionStepper(std::function<double(double)> fun, bool aitken_mode, Eigen::Vector2d _int);
+    BisectionStepper(std::function<Scalar(Scalar)> fun, bool aitken_mode, Point<Scalar> _int);
     /** @brief Specialized method to compute and return a new step with Bisection.
      * Let left_edge = a, right_edge = b; then we have an interval [a,b] such that f(a)*f(b) < 0; We compute x_new =
      * (a+b)/2; if f(a)*f(x_new) < 0 then a_new = a, b_new = x_new, otherwise a_new = x_new, b_new = b -> left_edge =
@@ -153,7 +247,7 @@ class BisectionStepper : public StepperBase<T> {
      * @param previous_iteration 2-dimensional vector storing x(i-1) and f(x(i-1)) - old guesses
      * @return 2-dimensional vector storing x(i) = (left_edge + right_edge) / 2 and f(x(i)) - new guesses
      */
-    Eigen::Vector2d compute_step(Eigen::Vector2d previous_iteration) override;
+    Point<Scalar> compute_step(Point<Scalar> previous_iteration) override;
 };
 
 #endif  // ROOT_STEPPER_DEF_HPP
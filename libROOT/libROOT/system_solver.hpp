@@ -0,0 +1,267 @@
+/**
+ * @file system_solver.hpp
+ * @brief Contains the SystemSolver class, which finds a root of a system of n non-linear equations in n unknowns
+ *
+ * The SystemSolver runs a damped Newton method on F: R^n -> R^n. Each iteration solves J(x) dx = -F(x), J being the
+ * Jacobian given by the user or approximated with forward differences, and moves along dx by the largest step of a
+ * backtracking line search which sufficiently decreases ||F||^2 (Armijo's rule), so that a starting point far from
+ * the root does not make the iterates overshoot. The factorization of the Jacobian (Eigen's PartialPivLU, or LDLT
+ * for symmetric Jacobians) can serve several iterations: it is computed again once it has served the chosen number
+ * of iterations, or earlier when its direction needed damping.
+ *
+ * @author Saransh-cpp
+ */
+#ifndef ROOT_SYSTEM_SOLVER_HPP
+#define ROOT_SYSTEM_SOLVER_HPP
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "method.hpp"
+
+/**
+ * @brief Enumeration of the factorizations of the Jacobian a SystemSolver can use.
+ *
+ */
+enum JacobianFactorization {
+    PARTIAL_PIV_LU,  //!< LU with partial pivoting, for any invertible Jacobian.
+    LDLT             //!< Robust Cholesky, about twice as fast, for symmetric Jacobians (e.g. gradients).
+};
+
+/**
+ * @brief The results of a solving process on a system of equations
+ */
+struct SystemSolution {
+    /** @brief x(i) in the first n columns of row i, ||F(x(i))|| (max norm) in the last one */
+    Eigen::MatrixXd results;
+    SolverStatus status = SolverStatus::CONVERGED;  //!< How the solving process ended
+    long evaluations = 0;                           //!< Evaluations of F, finite differences included
+    int factorizations = 0;                         //!< Jacobians computed (or approximated) and factorized
+
+    /** @brief Returns the last iterate
+     *
+     * @return x(i) of the last row of the results
+     */
+    [[nodiscard]] Eigen::VectorXd root() const {
+        return this->results.row(this->results.rows() - 1).head(this->results.cols() - 1).transpose();
+    }
+};
+
+/**
+ * @brief Runs the damped Newton iterations shared by the dense and the sparse system solvers
+ *
+ * @param function The system F to find the root of
+ * @param initial_guess x(0)
+ * @param max_iterations Maximum number of Newton iterations
+ * @param tolerance The tolerance on ||F(x)|| (max norm) or on the max norm of an undamped step
+ * @param reuse Iterations a factorization may serve
+ * @param factorize Computes the Jacobian at x (given F(x) and the counter of evaluations of F, increased by finite
+ * differences) and factorizes it, returning false if the factorization failed
+ * @param solve Solves J dx = b with the latest factorization into its second argument, returning false if it could
+ * not (e.g. an iterative solver which did not converge)
+ * @return The trajectory, the status and the counters of the process
+ */
+template <typename Factorize, typename Solve>
+SystemSolution damped_newton(const std::function<Eigen::VectorXd(const Eigen::VectorXd&)>& function,
+                             const Eigen::VectorXd& initial_guess, int max_iterations, double tolerance, int reuse,
+                             Factorize&& factorize, Solve&& solve);
+
+/**
+ * @brief Class SystemSolver managing the damped Newton process on a system of non-linear equations
+ */
+class SystemSolver {
+  public:
+    using Function = std::function<Eigen::VectorXd(const Eigen::VectorXd&)>;  //!< F: R^n -> R^n
+    using Jacobian = std::function<Eigen::MatrixXd(const Eigen::VectorXd&)>;  //!< J: R^n -> R^(n x n)
+
+  private:
+    Function function;                                     //!< The system to find the root of
+    Jacobian jacobian;                                     //!< The Jacobian of F, approximated if empty
+    int max_iterations;                                    //!< Maximum number of Newton iterations
+    double tolerance;                                      //!< Tolerance on ||F(x)|| or on a full step
+    JacobianFactorization factorization = PARTIAL_PIV_LU;  //!< Factorization of the Jacobian
+    int reuse = 1;                                         //!< Iterations a factorization may serve
+
+    /** @brief Approximates the Jacobian with forward differences, one evaluation of F per column
+     *
+     * @param x The point at which the Jacobian is approximated
+     * @param fx F(x)
+     * @param evaluations The counter of evaluations of F, increased by n
+     * @return The n x n approximation of J(x)
+     */
+    Eigen::MatrixXd finite_differences(const Eigen::VectorXd& x, const Eigen::VectorXd& fx, long& evaluations) const {
+        Eigen::MatrixXd approximation(fx.size(), x.size());
+        Eigen::VectorXd shifted = x;
+        for (Eigen::Index column = 0; column < x.size(); ++column) {
+            // the square root of the machine epsilon balances the truncation and the rounding errors
+            double h = std::sqrt(std::numeric_limits<double>::epsilon()) * std::max(std::abs(x(column)), 1.0);
+            shifted(column) = x(column) + h;
+            approximation.col(column) = (this->function(shifted) - fx) / (shifted(column) - x(column));
+            shifted(column) = x(column);
+            ++evaluations;
+        }
+        return approximation;
+    }
+
+  public:
+    /**
+     * @brief Constructor for SystemSolver object
+     *
+     * @param fun The system F to find the root of
+     * @param max_iterations Maximum iterations in which the method has to converge
+     * @param tolerance The tolerance below which ||F(x)|| (max norm), or the max norm of an undamped step, make the
+     * method converge
+     * @param jacobian The Jacobian of F, approximated with forward differences if empty
+     */
+    SystemSolver(Function fun, int max_iterations, double tolerance, Jacobian jacobian = {})
+        : function(std::move(fun)),
+          jacobian(std::move(jacobian)),
+          max_iterations(max_iterations),
+          tolerance(tolerance) {}
+
+    /** @brief Chooses how the linear systems of the iterations are solved
+     *
+     * @param factorization PARTIAL_PIV_LU, or LDLT when the Jacobian is symmetric
+     * @param reuse Iterations a factorization may serve before the Jacobian is computed again: 1 gives Newton's
+     * method, larger values trade a few more iterations for fewer Jacobians and factorizations
+     */
+    void set_factorization(JacobianFactorization factorization, int reuse = 1) {
+        this->factorization = factorization;
+        this->reuse = std::max(reuse, 1);
+    }
+
+    /** @brief Solves from the given initial guess, without modifying the SystemSolver
+     *
+     * @param initial_guess x(0), whose size is the number of unknowns
+     * @return The trajectory, the status and the counters of the process: CONVERGED, MAX_ITERATIONS, or DIVERGED
+     * when an iterate is not finite, the Jacobian cannot be factorized, or no step along a fresh Newton direction
+     * decreases ||F|| (a local minimum of ||F|| which is not a root)
+     */
+    SystemSolution solve(const Eigen::VectorXd& initial_guess) const;
+};
+
+template <typename Factorize, typename Solve>
+SystemSolution damped_newton(const std::function<Eigen::VectorXd(const Eigen::VectorXd&)>& function,
+                             const Eigen::VectorXd& initial_guess, int max_iterations, double tolerance, int reuse,
+                             Factorize&& factorize, Solve&& solve) {
+    constexpr double sufficient_decrease = 1e-4;  // Armijo's constant of the line search
+    constexpr double min_damping = 1.0 / 1024.0;  // smallest fraction of the Newton step tried
+    SystemSolution solution;
+    const Eigen::Index n = initial_guess.size();
+    std::vector<Eigen::VectorXd> iterates{initial_guess};
+    std::vector<double> norms;
+
+    Eigen::VectorXd x = initial_guess;
+    Eigen::VectorXd fx = function(x);
+    ++solution.evaluations;
+    norms.push_back(fx.lpNorm<Eigen::Infinity>());
+
+    int served = reuse;
+    bool fresh = false;
+    bool stalled = false;
+    double err = std::numeric_limits<double>::infinity();
+
+    int iter = 0;
+    while (std::isfinite(norms.back()) && norms.back() > tolerance && err > tolerance && iter < max_iterations) {
+        if (served >= reuse) {
+            ++solution.factorizations;
+            if (!factorize(x, fx, solution.evaluations)) {
+                stalled = true;
+                break;
+            }
+            served = 0;
+            fresh = true;
+        }
+        Eigen::VectorXd step;
+        if (!solve(Eigen::VectorXd(-fx), step)) {
+            if (!fresh) {
+                // a reused preconditioner may not suit the current Jacobian any more
+                served = reuse;
+                continue;
+            }
+            stalled = true;
+            break;
+        }
+
+        // backtracking on the merit function ||F||^2, halving the step until it decreases enough
+        const double merit = fx.squaredNorm();
+        double damping = 1.0;
+        Eigen::VectorXd x_new = x + step;
+        Eigen::VectorXd f_new = function(x_new);
+        ++solution.evaluations;
+        while (!(f_new.allFinite() && f_new.squaredNorm() <= (1.0 - 2.0 * sufficient_decrease * damping) * merit) &&
+               damping > min_damping) {
+            damping /= 2.0;
+            x_new = x + damping * step;
+            f_new = function(x_new);
+            ++solution.evaluations;
+        }
+        if (!(f_new.allFinite() && f_new.squaredNorm() <= (1.0 - 2.0 * sufficient_decrease * damping) * merit)) {
+            if (!fresh) {
+                // a reused factorization may not give a descent direction any more
+                served = reuse;
+                continue;
+            }
+            stalled = true;
+            break;
+        }
+
+        err = damping == 1.0 ? step.lpNorm<Eigen::Infinity>() : std::numeric_limits<double>::infinity();
+        x = std::move(x_new);
+        fx = std::move(f_new);
+        iterates.push_back(x);
+        norms.push_back(fx.lpNorm<Eigen::Infinity>());
+        ++iter;
+        ++served;
+        fresh = false;
+        if (damping < 1.0) {
+            // the model of the current factorization was poor, the next iteration computes a new one
+            served = reuse;
+        }
+    }
+
+    solution.results = Eigen::MatrixXd(iterates.size(), n + 1);
+    for (std::size_t row = 0; row < iterates.size(); ++row) {
+        solution.results.row(static_cast<Eigen::Index>(row)) << iterates[row].transpose(), norms[row];
+    }
+    if (stalled || !x.allFinite() || !std::isfinite(norms.back())) {
+        solution.status = SolverStatus::DIVERGED;
+    } else if (norms.back() <= tolerance || err <= tolerance) {
+        solution.status = SolverStatus::CONVERGED;
+    } else {
+        solution.status = SolverStatus::MAX_ITERATIONS;
+    }
+    return solution;
+}
+
+inline SystemSolution SystemSolver::solve(const Eigen::VectorXd& initial_guess) const {
+    // both factorizations keep their storage from one iteration to the next
+    Eigen::PartialPivLU<Eigen::MatrixXd> lu(initial_guess.size());
+    Eigen::LDLT<Eigen::MatrixXd> ldlt(initial_guess.size());
+    auto factorize = [this, &lu, &ldlt](const Eigen::VectorXd& x, const Eigen::VectorXd& fx, long& evaluations) {
+        Eigen::MatrixXd matrix = this->jacobian ? this->jacobian(x) : this->finite_differences(x, fx, evaluations);
+        if (this->factorization == LDLT) {
+            ldlt.compute(matrix);
+            return ldlt.info() == Eigen::Success;
+        }
+        lu.compute(matrix);
+        return true;
+    };
+    auto solve = [this, &lu, &ldlt](const Eigen::VectorXd& rhs, Eigen::VectorXd& step) {
+        if (this->factorization == LDLT) {
+            step = ldlt.solve(rhs);
+        } else {
+            step = lu.solve(rhs);
+        }
+        return true;
+    };
+    return damped_newton(this->function, initial_guess, this->max_iterations, this->tolerance, this->reuse, factorize,
+                         solve);
+}
+
+#endif  // ROOT_SYSTEM_SOLVER_HPP
@@ -4,6 +4,14 @@
 #include <gtest/gtest.h>
 
 #include <Eigen/Dense>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <libROOT/mixed_solver.hpp>
 #include <libROOT/solver.hpp>
 #include <libROOT/stepper.hpp>
 
@@ -13,7 +21,7 @@ class SolverTester : public ::testing::Test {
     void testConverStepper(std::function<double(double)> func, T initial_guess, Method method,
                            std::function<double(double)> derivative_or_function_g = nullptr) {
         Solver<T> solver(func, initial_guess, method, 100, 1e-6, false, false, derivative_or_function_g);
-        std::unique_ptr<StepperBase<T>> stepper;
+        StepperPointer<T> stepper;
         solver.convert_stepper(stepper);
         ASSERT_NE(stepper, nullptr) << "Stepper conversion failed for method.";
 
@@ -120,7 +128,7 @@ class SolverTester : public ::testing::Test {
     void testSolverStep(std::function<double(double)> func, T initial_guess, Method method,
                         std::function<double(double)> derivative_or_function_g = nullptr) {
         Solver<T> solver(func, initial_guess, method, 100, 1e-6, false, false, derivative_or_function_g);
-        std::unique_ptr<StepperBase<T>> stepper;
+        StepperPointer<T> stepper;
         solver.convert_stepper(stepper);
         ASSERT_NE(stepper, nullptr) << "Stepper conversion failed for method.";
 
@@ -146,6 +154,339 @@ class SolverTester : public ::testing::Test {
         double final_fx = solver.results(solver.results.rows() - 1, 1);
         ASSERT_NEAR(final_fx, 0.0, 1e-4) << "Final function value is not close to zero.";
     }
+
+    void testStatusAndEvaluations() {
+        int calls = 0;
+        auto func = [&calls](double x) {
+            ++calls;
+            return x * x - 2;
+        };
+        auto derivative = [&calls](double x) {
+            ++calls;
+            return 2 * x;
+        };
+        Solver<double> solver(func, 1.0, Method::NEWTON, 100, 1e-6, false, false, derivative);
+        solver.solve();
+        ASSERT_EQ(solver.get_status(), SolverStatus::CONVERGED) << "Newton did not report convergence.";
+        ASSERT_EQ(solver.get_evaluations(), calls) << "Evaluation counter does not match the calls made.";
+
+        // a second process counts its own evaluations only
+        calls = 0;
+        solver.solve();
+        ASSERT_EQ(solver.get_evaluations(), calls) << "Evaluation counter was not reset between processes.";
+
+        Solver<double> capped(func, 1.0, Method::NEWTON, 2, 1e-12, false, false, derivative);
+        capped.solve();
+        ASSERT_EQ(capped.get_status(), SolverStatus::MAX_ITERATIONS) << "Capped solve did not report the limit.";
+
+        Solver<double> diverging([](double x) { return std::exp(x); }, 1.0, Method::NEWTON, 2000, 1e-300, false,
+                                 false, [](double x) { return 0.0 * x; });
+        diverging.solve();
+        ASSERT_EQ(diverging.get_status(), SolverStatus::DIVERGED) << "Non-finite iterate was not reported.";
+    }
+
+    void testCancellation() {
+        // the stop is requested by the function itself after a few evaluations, as another thread would do
+        std::stop_source source;
+        int calls = 0;
+        auto func = [&source, &calls](double x) {
+            if (++calls == 5) {
+                source.request_stop();
+            }
+            return x - 1.0;
+        };
+        Eigen::Vector2d interval(0.0, 1000.0);
+        Solver<Eigen::Vector2d> solver(func, interval, Method::BISECTION, 1000, 1e-12, false, false);
+        solver.set_stop_token(source.get_token());
+        Eigen::MatrixX2d results = solver.solve();
+        ASSERT_EQ(solver.get_status(), SolverStatus::CANCELLED) << "Stopped solve did not report the cancellation.";
+        ASSERT_LT(results.rows(), 5) << "Solve went on after the stop was requested.";
+
+        // a converged process keeps its status even if the stop comes right after
+        Solver<double> newton([](double x) { return x * x - 2; }, 1.0, Method::NEWTON, 100, 1e-6, false, false,
+                              [](double x) { return 2 * x; });
+        std::stop_source late;
+        newton.set_stop_token(late.get_token());
+        newton.solve();
+        late.request_stop();
+        ASSERT_EQ(newton.get_status(), SolverStatus::CONVERGED);
+        newton.solve();
+        ASSERT_EQ(newton.get_status(), SolverStatus::CANCELLED) << "Process started after the stop was not cancelled.";
+    }
+
+    void testLimits() {
+        Eigen::Vector2d interval(0.0, 1000.0);
+        Solver<Eigen::Vector2d> budget([](double x) { return x - 1.0; }, interval, Method::BISECTION, 100000, 1e-300,
+                                       false, false);
+        budget.set_limits(std::chrono::nanoseconds::zero(), 20);
+        Eigen::MatrixX2d results = budget.solve();
+        ASSERT_EQ(budget.get_status(), SolverStatus::BUDGET_EXHAUSTED) << "Spent budget was not reported.";
+        // one step of bisection evaluates the function a few times, which may overshoot the budget once
+        ASSERT_GE(budget.get_evaluations(), 20);
+        ASSERT_LT(budget.get_evaluations(), 30);
+        ASSERT_LE(std::abs(budget.get_best_estimate()(1)), results.col(1).cwiseAbs().minCoeff());
+
+        // every evaluation is slow, the deadline ends the process long before its iterations
+        auto slow = [](double x) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return x - 1.0;
+        };
+        Solver<Eigen::Vector2d> deadline(slow, interval, Method::BISECTION, 100000, 1e-300, false, false);
+        deadline.set_limits(std::chrono::milliseconds(20), 0);
+        auto start = std::chrono::steady_clock::now();
+        deadline.solve();
+        ASSERT_EQ(deadline.get_status(), SolverStatus::TIMED_OUT) << "Deadline was not reported.";
+        ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+
+        // limits which are not reached leave the status untouched
+        Solver<double> newton([](double x) { return x * x - 2; }, 1.0, Method::NEWTON, 100, 1e-6, false, false,
+                              [](double x) { return 2 * x; });
+        newton.set_limits(std::chrono::seconds(10), 1000);
+        newton.solve();
+        ASSERT_EQ(newton.get_status(), SolverStatus::CONVERGED);
+        ASSERT_NEAR(newton.get_best_estimate()(0), std::sqrt(2.0), 1e-6);
+    }
+
+    template <typename T>
+    void testIterate(std::function<double(double)> func, T initial_guess, Method method,
+                     std::function<double(double)> derivative_or_function_g = nullptr) {
+        Solver<T> solver(func, initial_guess, method, 100, 1e-8, false, false, derivative_or_function_g);
+        Eigen::MatrixX2d results = solver.solve();
+        long evaluations = solver.get_evaluations();
+
+        // the streamed iterates are the rows of the trajectory, in order
+        Eigen::Index row = 0;
+        for (const Eigen::Vector2d& iterate : solver.iterate()) {
+            ASSERT_LT(row, results.rows()) << "More iterates were streamed than solve() computed.";
+            ASSERT_DOUBLE_EQ(iterate(0), results(row, 0));
+            ASSERT_DOUBLE_EQ(iterate(1), results(row, 1));
+            ++row;
+        }
+        ASSERT_EQ(row, results.rows()) << "Fewer iterates were streamed than solve() computed.";
+        ASSERT_EQ(solver.get_status(), SolverStatus::CONVERGED);
+        ASSERT_EQ(solver.get_evaluations(), evaluations);
+
+        // a consumer stopping early leaves the solver as it was, ready for another process
+        int streamed = 0;
+        for (const Eigen::Vector2d& iterate : solver.iterate()) {
+            (void)iterate;
+            if (++streamed == 2) {
+                break;
+            }
+        }
+        solver.solve();
+        ASSERT_EQ(solver.get_evaluations(), evaluations) << "Abandoned stream left its counters on the functions.";
+    }
+
+    /** @brief Function object counting its copies, to check that concurrent processes share the functions */
+    struct CopyCountingFunction {
+        std::function<double(double)> function;                                            //!< The counted function
+        std::shared_ptr<std::atomic<int>> copies = std::make_shared<std::atomic<int>>(0);  //!< Shared counter
+
+        CopyCountingFunction(std::function<double(double)> function) : function(std::move(function)) {}
+        CopyCountingFunction(const CopyCountingFunction& other) : function(other.function), copies(other.copies) {
+            ++*this->copies;
+        }
+        CopyCountingFunction(CopyCountingFunction&&) = default;
+        double operator()(double x) const { return this->function(x); }
+    };
+
+    template <typename T>
+    void testConcurrentSolve(std::function<double(double)> func, const std::vector<T>& initial_guesses, Method method,
+                             std::function<double(double)> derivative_or_function_g = nullptr) {
+        CopyCountingFunction counted(func);
+        const Solver<T> solver(counted, initial_guesses.front(), method, 100, 1e-10, false, false,
+                               derivative_or_function_g);
+        int copies = counted.copies->load();
+
+        // every thread solves from its own guesses, on the same Solver
+        std::vector<Solution> solutions(initial_guesses.size());
+        {
+            std::vector<std::jthread> threads;
+            for (std::size_t i = 0; i < initial_guesses.size(); ++i) {
+                threads.emplace_back([&, i] {
+                    for (int repeat = 0; repeat < 50; ++repeat) {
+                        solutions[i] = solver.solve(initial_guesses[i]);
+                    }
+                });
+            }
+        }
+        ASSERT_EQ(counted.copies->load(), copies) << "A process copied the function of the shared Solver.";
+
+        // each process follows the trajectory of a Solver built for its own guess
+        for (std::size_t i = 0; i < initial_guesses.size(); ++i) {
+            Solver<T> alone(func, initial_guesses[i], method, 100, 1e-10, false, false, derivative_or_function_g);
+            Eigen::MatrixX2d results = alone.solve();
+            ASSERT_EQ(solutions[i].results.rows(), results.rows());
+            for (Eigen::Index row = 0; row < results.rows(); ++row) {
+                ASSERT_DOUBLE_EQ(solutions[i].results(row, 0), results(row, 0));
+                ASSERT_DOUBLE_EQ(solutions[i].results(row, 1), results(row, 1));
+            }
+            ASSERT_EQ(solutions[i].status, alone.get_status());
+            ASSERT_EQ(solutions[i].evaluations, alone.get_evaluations());
+            ASSERT_DOUBLE_EQ(solutions[i].best(0), alone.get_best_estimate()(0));
+        }
+    }
+
+    void testSolveContextAllocations(const std::function<long()>& allocations) {
+        auto func = [](double x) { return x * x - 2; };
+        const Solver<double> newton(func, 1.0, Method::NEWTON, 100, 1e-10, false, false,
+                                    [](double x) { return 2 * x; });
+        const Solver<Eigen::Vector2d> chords(func, Eigen::Vector2d(0.0, 2.0), Method::CHORDS, 100, 1e-10, false, false);
+        // without a real root, Newton iterates until its maximum number of iterations, past the first block
+        const Solver<double> wandering([](double x) { return x * x + 1; }, 0.5, Method::NEWTON, 500, 1e-12, false,
+                                       false, [](double x) { return 2 * x; });
+        SolveContext context(16);
+
+        // the first processes grow the buffer of the context to the size of the problems: a process outgrowing it
+        // reaches the heap once, and the next process starts from a buffer holding what it used
+        for (int i = 0; i < 2; ++i) {
+            newton.solve(1.0, context);
+            chords.solve(Eigen::Vector2d(0.0, 2.0), context);
+            wandering.solve(0.5, context);
+        }
+        std::size_t capacity = context.get_capacity();
+
+        long before = allocations();
+        double roots = 0.0;
+        for (int i = 0; i < 100; ++i) {
+            SolutionView scalar = newton.solve(1.0 + i, context);
+            roots += scalar.results(scalar.results.rows() - 1, 0);
+            SolutionView interval = chords.solve(Eigen::Vector2d(0.5, 2.0 + i), context);
+            roots += interval.results(interval.results.rows() - 1, 0);
+            ASSERT_EQ(wandering.solve(0.5 + i * 1e-3, context).results.rows(), 500);
+        }
+        long after = allocations();
+        ASSERT_EQ(after, before) << "A process run in a reused context allocated on the heap.";
+        ASSERT_EQ(context.get_capacity(), capacity);
+        ASSERT_NEAR(roots, 200 * std::sqrt(2.0), 1e-6);
+
+        // the view holds the same trajectory as the owning path
+        Solution owned = newton.solve(3.0);
+        SolutionView view = newton.solve(3.0, context);
+        ASSERT_EQ(view.results.rows(), owned.results.rows());
+        ASSERT_TRUE(view.to_solution().results.isApprox(owned.results));
+        ASSERT_EQ(view.evaluations, owned.evaluations);
+        ASSERT_EQ(view.status, SolverStatus::CONVERGED);
+
+        // the rows copied into the grown blocks are the ones streamed by the stateful process
+        Solver<double> streamed([](double x) { return x * x + 1; }, 0.5, Method::NEWTON, 500, 1e-12, false, false,
+                                [](double x) { return 2 * x; });
+        SolutionView long_view = wandering.solve(0.5, context);
+        ASSERT_EQ(long_view.status, SolverStatus::MAX_ITERATIONS);
+        Eigen::Index row = 0;
+        for (const Eigen::Vector2d& iterate : streamed.iterate()) {
+            ASSERT_LT(row, long_view.results.rows());
+            ASSERT_DOUBLE_EQ(iterate(0), long_view.results(row, 0));
+            ASSERT_DOUBLE_EQ(iterate(1), long_view.results(row, 1));
+            ++row;
+        }
+        ASSERT_EQ(row, long_view.results.rows());
+    }
+
+    void testTrajectoryGrowsWithIterations() {
+        // the bound on the iterations is not reserved: a process converging in a few steps needs a small buffer
+        const Solver<double> newton([](double x) { return x * x - 2; }, 1.0, Method::NEWTON, 2000000000, 1e-10, false,
+                                    false, [](double x) { return 2 * x; });
+        ASSERT_LT(newton.process_bytes(), std::size_t{4096});
+        SolveContext context(16);
+        SolutionView view = newton.solve(1.0, context);
+        ASSERT_EQ(view.status, SolverStatus::CONVERGED);
+        ASSERT_NEAR(view.results(view.results.rows() - 1, 0), std::sqrt(2.0), 1e-10);
+        ASSERT_LT(context.get_capacity(), std::size_t{4096});
+    }
+    template <typename Scalar>
+    void testScalarType(double tolerance) {
+        auto func = [](Scalar x) { return x * x - Scalar(2); };
+        auto derivative = [](Scalar x) { return Scalar(2) * x; };
+        const Solver<Scalar> newton(func, Scalar(1), Method::NEWTON, 100, tolerance, false, false, derivative);
+        const Solver<Point<Scalar>> bisection(func, Point<Scalar>(Scalar(1), Scalar(2)), Method::BISECTION, 200,
+                                              tolerance, false, false);
+        const DoubleDouble root = sqrt(DoubleDouble(2.0));
+
+        BasicSolution<Scalar> open = newton.solve(Scalar(1));
+        ASSERT_EQ(open.status, SolverStatus::CONVERGED);
+        ASSERT_LT(magnitude(DoubleDouble(open.estimate()(0)) - root), tolerance);
+
+        BasicSolution<Scalar> bracketing = bisection.solve(Point<Scalar>(Scalar(1), Scalar(2)));
+        ASSERT_EQ(bracketing.status, SolverStatus::CONVERGED);
+        ASSERT_LT(magnitude(DoubleDouble(bracketing.estimate()(0)) - root), tolerance);
+    }
+
+    void testDoubleDouble() {
+        // 1 + 2^-80 is lost in a double, but not in a double-double
+        DoubleDouble tiny = std::ldexp(1.0, -80);
+        ASSERT_EQ(static_cast<double>((DoubleDouble(1.0) + tiny) - 1.0), std::ldexp(1.0, -80));
+
+        DoubleDouble root = sqrt(DoubleDouble(2.0));
+        ASSERT_LT(magnitude(root * root - 2.0), 1e-30);
+        ASSERT_EQ(to_string(root, 32), "1.4142135623730950488016887242097e+00");
+        ASSERT_LT(magnitude(DoubleDouble(1.0) / 3.0 * 3.0 - 1.0), 1e-31);
+        ASSERT_LT(magnitude(pow(root, 10) - 32.0), 1e-29);
+
+        DoubleDouble x = 0.7;
+        ASSERT_LT(magnitude(sin(x) * sin(x) + cos(x) * cos(x) - 1.0), 1e-30);
+        ASSERT_NEAR(static_cast<double>(sin(x)), std::sin(0.7), 1e-16);
+        ASSERT_NEAR(static_cast<double>(cos(DoubleDouble(10.0))), std::cos(10.0), 1e-15);
+        ASSERT_LT(magnitude(sin(DoubleDouble::half_pi() * 2.0)), 1e-31);
+    }
+    template <typename T, typename Wide>
+    void testMixedPrecision(Method method, const T& initial_guess, bool derivative, double tolerance) {
+        std::function<Wide(Wide)> wide_derivative;
+        if (derivative) {
+            wide_derivative = [](Wide x) { return Wide(2) * x; };
+        }
+        const MixedSolver<T, Wide> solver([](float x) { return x * x - 2.0F; }, [](Wide x) { return x * x - Wide(2); },
+                                          method, 100, tolerance, [](float x) { return 2.0F * x; }, wide_derivative);
+        MixedSolution<Wide> solution = solver.solve(initial_guess);
+
+        // the tolerance is below the resolution of float, so the wide phase has to meet it
+        ASSERT_EQ(solution.status, SolverStatus::CONVERGED);
+        ASSERT_LT(magnitude(DoubleDouble(solution.estimate()(0)) - sqrt(DoubleDouble(2.0))), tolerance);
+        ASSERT_GE(solution.narrow_iterations, 3);
+        ASSERT_LE(solution.results.rows() - 1 - solution.narrow_iterations, 4);
+    }
+    void testComplexRoots() {
+        using Complex = std::complex<double>;
+        const Complex i(0.0, 1.0);
+        auto quadratic = [](Complex x) { return x * x + 1.0; };
+
+        // Newton needs a complex guess to leave the real line
+        const Solver<Complex> newton(quadratic, Complex(0.5, 0.5), Method::NEWTON, 100, 1e-12, false, false,
+                                     [](Complex x) { return 2.0 * x; });
+        BasicSolution<Complex> solution = newton.solve(Complex(0.5, 0.5));
+        ASSERT_EQ(solution.status, SolverStatus::CONVERGED);
+        ASSERT_LT(std::abs(solution.estimate()(0) - i), 1e-12);
+
+        // Muller finds the complex roots from real guesses, without a derivative
+        const Solver<Complex> muller(quadratic, 1.0, Method::MULLER, 100, 1e-12, false, false);
+        solution = muller.solve(1.0);
+        ASSERT_EQ(solution.status, SolverStatus::CONVERGED);
+        ASSERT_LT(std::abs(std::abs(solution.estimate()(0).imag()) - 1.0), 1e-12);
+        ASSERT_LT(std::abs(solution.estimate()(0).real()), 1e-12);
+
+        const Solver<Complex> cubic([](Complex x) { return x * x * x - 1.0; }, -2.0, Method::MULLER, 100, 1e-12,
+                                    false, false);
+        solution = cubic.solve(-2.0);
+        ASSERT_EQ(solution.status, SolverStatus::CONVERGED);
+        ASSERT_LT(std::abs(std::pow(solution.estimate()(0), 3) - 1.0), 1e-11);
+        ASSERT_GT(std::abs(solution.estimate()(0).imag()), 0.5);
+
+        // a real guess cannot hold the complex iterates of Muller's method
+        Solver<double> real([](double x) { return x * x + 1.0; }, 1.0, Method::MULLER, 100, 1e-12, false, false);
+        ASSERT_EQ(real.solve(1.0).status, SolverStatus::DIVERGED);
+
+        // the stateful processes stop at the starting point as well, without a stepper to call
+        int streamed = 0;
+        for (const Eigen::Vector2d& iterate : real.iterate()) {
+            ASSERT_DOUBLE_EQ(iterate(0), 1.0);
+            ++streamed;
+        }
+        ASSERT_EQ(streamed, 1) << "Iterates were streamed without a stepper.";
+        ASSERT_EQ(real.get_status(), SolverStatus::DIVERGED);
+        ASSERT_EQ(real.solve().rows(), 1);
+        ASSERT_EQ(real.get_status(), SolverStatus::DIVERGED);
+    }
 };
 
 #endif  // SOLVER_TESTER_HPP
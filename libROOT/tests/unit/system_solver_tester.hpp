@@ -0,0 +1,239 @@
+#ifndef SYSTEM_SOLVER_TESTER_HPP
+#define SYSTEM_SOLVER_TESTER_HPP
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <cmath>
+#include <libROOT/sparse_system_solver.hpp>
+#include <libROOT/system_solver.hpp>
+#include <vector>
+
+/**
+ * @brief Test fixture class for SystemSolver unit tests.
+ *
+ */
+class SystemSolverTester : public ::testing::Test {
+  public:
+    /** @brief x^2 + y^2 = 4 and x y = 1, whose roots are the intersections of a circle and a hyperbola */
+    static Eigen::VectorXd circle(const Eigen::VectorXd& x) {
+        return Eigen::Vector2d(x(0) * x(0) + x(1) * x(1) - 4.0, x(0) * x(1) - 1.0);
+    }
+    /** @brief Jacobian of circle() */
+    static Eigen::MatrixXd circle_jacobian(const Eigen::VectorXd& x) {
+        return (Eigen::Matrix2d() << 2.0 * x(0), 2.0 * x(1), x(1), x(0)).finished();
+    }
+
+    void testNewton(bool analytic) {
+        SystemSolver solver(circle, 50, 1e-12, analytic ? SystemSolver::Jacobian(circle_jacobian) : nullptr);
+        SystemSolution solution = solver.solve(Eigen::Vector2d(2.0, 0.5));
+        ASSERT_EQ(solution.status, SolverStatus::CONVERGED);
+        ASSERT_LT(circle(solution.root()).lpNorm<Eigen::Infinity>(), 1e-12);
+        ASSERT_NEAR(solution.root()(0), std::sqrt(2.0 + std::sqrt(3.0)), 1e-12);
+        ASSERT_EQ(solution.results.cols(), 3);
+        ASSERT_EQ(solution.factorizations, solution.results.rows() - 1);
+        // forward differences cost one evaluation per unknown and per Jacobian
+        long expected = solution.results.rows() + (analytic ? 0 : 2 * solution.factorizations);
+        ASSERT_EQ(solution.evaluations, expected);
+    }
+
+    void testFactorizationReuse() {
+        SystemSolver newton(circle, 50, 1e-12, circle_jacobian);
+        SystemSolver reusing(circle, 50, 1e-12, circle_jacobian);
+        reusing.set_factorization(PARTIAL_PIV_LU, 4);
+        SystemSolution fresh = newton.solve(Eigen::Vector2d(2.0, 0.5));
+        SystemSolution reused = reusing.solve(Eigen::Vector2d(2.0, 0.5));
+        ASSERT_EQ(reused.status, SolverStatus::CONVERGED);
+        ASSERT_LT((reused.root() - fresh.root()).norm(), 1e-10);
+        ASSERT_LT(reused.factorizations, fresh.factorizations);
+        ASSERT_LT(reused.factorizations, reused.results.rows() - 1);
+    }
+
+    void testLDLT() {
+        // the gradient of (1/2) x^T A x + (1/4) sum(x^4) - b^T x has a symmetric positive definite Jacobian
+        Eigen::Matrix3d a;
+        a << 4.0, 1.0, 0.0, 1.0, 3.0, 1.0, 0.0, 1.0, 2.0;
+        Eigen::Vector3d b(1.0, -2.0, 3.0);
+        auto gradient = [a, b](const Eigen::VectorXd& x) -> Eigen::VectorXd {
+            return a * x + x.array().cube().matrix() - b;
+        };
+        auto hessian = [a](const Eigen::VectorXd& x) -> Eigen::MatrixXd {
+            return a + Eigen::MatrixXd(3.0 * x.array().square().matrix().asDiagonal());
+        };
+        SystemSolver solver(gradient, 50, 1e-12, hessian);
+        solver.set_factorization(LDLT);
+        SystemSolution solution = solver.solve(Eigen::Vector3d::Zero());
+        ASSERT_EQ(solution.status, SolverStatus::CONVERGED);
+        ASSERT_LT(gradient(solution.root()).lpNorm<Eigen::Infinity>(), 1e-12);
+    }
+
+    void testLineSearch() {
+        // undamped Newton on atan overshoots further at each step from |x(0)| > 1.39
+        auto arctangent = [](const Eigen::VectorXd& x) -> Eigen::VectorXd { return x.array().atan().matrix(); };
+        auto derivative = [](const Eigen::VectorXd& x) -> Eigen::MatrixXd {
+            return (1.0 / (1.0 + x.array().square())).matrix().asDiagonal();
+        };
+        SystemSolver solver(arctangent, 50, 1e-12, derivative);
+        SystemSolution solution = solver.solve(Eigen::Vector2d(3.0, -10.0));
+        ASSERT_EQ(solution.status, SolverStatus::CONVERGED);
+        ASSERT_LT(solution.root().norm(), 1e-12);
+        // the line search decreases ||F|| (2-norm) at every iteration
+        for (Eigen::Index row = 1; row < solution.results.rows(); ++row) {
+            Eigen::VectorXd x = solution.results.row(row).head(2).transpose();
+            Eigen::VectorXd previous = solution.results.row(row - 1).head(2).transpose();
+            ASSERT_LT(arctangent(x).norm(), arctangent(previous).norm());
+        }
+
+        // x^2 + 1 has no real root: the line search stalls at the minimum of the residual
+        SystemSolver rootless([](const Eigen::VectorXd& x) -> Eigen::VectorXd { return x.array().square() + 1.0; },
+                              50, 1e-12);
+        ASSERT_EQ(rootless.solve(Eigen::VectorXd::Constant(1, 0.5)).status, SolverStatus::DIVERGED);
+    }
+
+    /** @brief Discretized Bratu problem u'' + e^u = 0 on (0, 1), u(0) = u(1) = 0, on n interior points */
+    static Eigen::VectorXd bratu(const Eigen::VectorXd& u) {
+        const Eigen::Index n = u.size();
+        const double h2 = 1.0 / static_cast<double>((n + 1) * (n + 1));
+        Eigen::VectorXd f = -2.0 * u + h2 * u.array().exp().matrix();
+        f.head(n - 1) += u.tail(n - 1);
+        f.tail(n - 1) += u.head(n - 1);
+        return f;
+    }
+    /** @brief Jacobian of bratu(), tridiagonal */
+    static Eigen::SparseMatrix<double> bratu_jacobian(const Eigen::VectorXd& u) {
+        const Eigen::Index n = u.size();
+        const double h2 = 1.0 / static_cast<double>((n + 1) * (n + 1));
+        std::vector<Eigen::Triplet<double>> entries;
+        for (Eigen::Index i = 0; i < n; ++i) {
+            entries.emplace_back(i, i, -2.0 + h2 * std::exp(u(i)));
+            if (i > 0) {
+                entries.emplace_back(i, i - 1, 1.0);
+                entries.emplace_back(i - 1, i, 1.0);
+            }
+        }
+        Eigen::SparseMatrix<double> jacobian(n, n);
+        jacobian.setFromTriplets(entries.begin(), entries.end());
+        return jacobian;
+    }
+    /** @brief 4 u(i, j) - its 4 neighbors + u(i, j)^3 - 1 on an m x m grid, zero outside of it */
+    static Eigen::VectorXd grid(const Eigen::VectorXd& u, Eigen::Index m) {
+        Eigen::VectorXd f = 4.0 * u + u.array().cube().matrix() - Eigen::VectorXd::Ones(u.size());
+        for (Eigen::Index k = 0; k < u.size(); ++k) {
+            Eigen::Index i = k / m;
+            Eigen::Index j = k % m;
+            f(k) -= (i > 0 ? u(k - m) : 0.0) + (i < m - 1 ? u(k + m) : 0.0) + (j > 0 ? u(k - 1) : 0.0) +
+                    (j < m - 1 ? u(k + 1) : 0.0);
+        }
+        return f;
+    }
+    /** @brief Jacobian of grid() */
+    static Eigen::SparseMatrix<double> grid_jacobian(const Eigen::VectorXd& u, Eigen::Index m) {
+        std::vector<Eigen::Triplet<double>> entries;
+        for (Eigen::Index k = 0; k < u.size(); ++k) {
+            Eigen::Index i = k / m;
+            Eigen::Index j = k % m;
+            entries.emplace_back(k, k, 4.0 + 3.0 * u(k) * u(k));
+            for (Eigen::Index neighbor : {i > 0 ? k - m : -1, i < m - 1 ? k + m : -1, j > 0 ? k - 1 : -1,
+                                          j < m - 1 ? k + 1 : -1}) {
+                if (neighbor >= 0) {
+                    entries.emplace_back(k, neighbor, -1.0);
+                }
+            }
+        }
+        Eigen::SparseMatrix<double> jacobian(u.size(), u.size());
+        jacobian.setFromTriplets(entries.begin(), entries.end());
+        return jacobian;
+    }
+
+    void testColoredFiniteDifferences() {
+        const Eigen::Index m = 20;
+        auto function = [m](const Eigen::VectorXd& u) { return grid(u, m); };
+        Eigen::VectorXd u = Eigen::VectorXd::LinSpaced(m * m, -1.0, 2.0);
+        Eigen::SparseMatrix<double> exact = grid_jacobian(u, m);
+        SparseSystemSolver solver(function, exact, 20, 1e-10);
+
+        // no two columns of a color share a row
+        ASSERT_LE(solver.get_colors(), 9U);
+        for (const std::vector<Eigen::Index>& columns : solver.colors) {
+            std::vector<int> used(m * m, 0);
+            for (Eigen::Index column : columns) {
+                for (Eigen::SparseMatrix<double>::InnerIterator entry(exact, column); entry; ++entry) {
+                    ASSERT_EQ(used[entry.row()]++, 0);
+                }
+            }
+        }
+
+        long evaluations = 0;
+        Eigen::SparseMatrix<double> approximation = solver.pattern;
+        solver.finite_differences(u, function(u), evaluations, approximation);
+        ASSERT_EQ(evaluations, static_cast<long>(solver.get_colors()));
+        ASSERT_LT((Eigen::MatrixXd(approximation) - Eigen::MatrixXd(exact)).lpNorm<Eigen::Infinity>(), 1e-6);
+        ASSERT_EQ(SparseSystemSolver(bratu, bratu_jacobian(Eigen::VectorXd::Zero(100)), 20, 1e-10).get_colors(), 3U);
+    }
+
+    void testSparseNewton(SparseLinearSolver linear_solver, bool analytic) {
+        const Eigen::Index n = 20000;
+        SparseSystemSolver solver(bratu, bratu_jacobian(Eigen::VectorXd::Zero(n)), 20, 1e-12,
+                                  analytic ? SparseSystemSolver::Jacobian(bratu_jacobian) : nullptr);
+        solver.set_linear_solver(linear_solver);
+        SystemSolution solution = solver.solve(Eigen::VectorXd::Zero(n));
+        ASSERT_EQ(solution.status, SolverStatus::CONVERGED);
+        ASSERT_LT(bratu(solution.root()).lpNorm<Eigen::Infinity>(), 1e-12);
+        // the lower solution of the Bratu problem for lambda = 1 peaks at about 0.1405 in the middle of the interval
+        ASSERT_NEAR(solution.root()(n / 2), 0.1405, 1e-3);
+        // three colors: a Jacobian costs three evaluations of F, whatever n
+        long expected = solution.results.rows() + (analytic ? 0 : 3 * solution.factorizations);
+        ASSERT_EQ(solution.evaluations, expected);
+    }
+
+    void testSparseFailures() {
+        const Eigen::Index n = 100;
+        const Eigen::SparseMatrix<double> pattern = bratu_jacobian(Eigen::VectorXd::Zero(n));
+
+        // SparseLU refuses Jacobians whose structure differs from the analyzed one, before evaluating F again
+        SparseSystemSolver::Jacobian diagonal = [](const Eigen::VectorXd& u) {
+            Eigen::SparseMatrix<double> jacobian(u.size(), u.size());
+            for (Eigen::Index i = 0; i < u.size(); ++i) {
+                jacobian.insert(i, i) = -2.0;
+            }
+            jacobian.makeCompressed();
+            return jacobian;
+        };
+        // as many non-zeros as the pattern, one of them in another row
+        SparseSystemSolver::Jacobian moved = [](const Eigen::VectorXd& u) {
+            Eigen::SparseMatrix<double> jacobian = bratu_jacobian(u);
+            jacobian.coeffRef(1, 0) = 0.0;
+            jacobian.insert(2, 0) = 1.0;
+            jacobian.prune(0.0, 0.0);
+            jacobian.makeCompressed();
+            return jacobian;
+        };
+        for (const SparseSystemSolver::Jacobian& jacobian : {diagonal, moved}) {
+            SparseSystemSolver solver(bratu, pattern, 20, 1e-12, jacobian);
+            SystemSolution solution = solver.solve(Eigen::VectorXd::Zero(n));
+            ASSERT_EQ(solution.status, SolverStatus::DIVERGED);
+            ASSERT_EQ(solution.evaluations, 1);
+        }
+
+        // the second equation is twice the first one, for another right-hand side: the preconditioner is computed but
+        // BiCGSTAB breaks down, and its step is not tried
+        SparseSystemSolver::Jacobian singular = [](const Eigen::VectorXd& u) {
+            Eigen::SparseMatrix<double> jacobian(u.size(), u.size());
+            for (Eigen::Index i = 0; i < u.size(); ++i) {
+                jacobian.insert(i, i) = 1.0;
+            }
+            jacobian.insert(1, 0) = 2.0;
+            jacobian.coeffRef(1, 1) = 0.0;
+            jacobian.makeCompressed();
+            return jacobian;
+        };
+        SparseSystemSolver solver(bratu, pattern, 20, 1e-12, singular);
+        solver.set_linear_solver(BICGSTAB);
+        SystemSolution solution = solver.solve(Eigen::VectorXd::Zero(n));
+        ASSERT_EQ(solution.status, SolverStatus::DIVERGED);
+        ASSERT_EQ(solution.evaluations, 1);
+    }
+};
+
+#endif
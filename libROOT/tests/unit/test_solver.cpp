@@ -1,8 +1,64 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
 #include "libROOT/solver.hpp"
 #include "solver_tester.hpp"
 
+namespace {
+std::atomic<long> heap_allocations{0};  // calls of the global operator new, counted for the SolveContext test
+
+void* counted_allocation(std::size_t size, std::size_t alignment) noexcept {
+    ++heap_allocations;
+    size = size == 0 ? 1 : size;
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    // aligned_alloc wants a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void* counted_allocation_or_throw(std::size_t size, std::size_t alignment) {
+    if (void* memory = counted_allocation(size, alignment)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+}  // namespace
+
+// the whole family is replaced, so that every form of new is counted and freed by the matching form of delete
+void* operator new(std::size_t size) { return counted_allocation_or_throw(size, 0); }
+void* operator new[](std::size_t size) { return counted_allocation_or_throw(size, 0); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return counted_allocation_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return counted_allocation_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_allocation(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_allocation(size, 0); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_allocation(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_allocation(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+
 TEST_F(SolverTester, ConvertStepperScalarNewton) {
     auto func = [](double x) { return x * x - 2; };
     double initial_guess = 1.0;
@@ -88,3 +144,56 @@ TEST_F(SolverTester, FullSolveChordsVector) {
     initial_guess << 1.0, 2.0;
     this->testSolve<Eigen::Vector2d>(func, initial_guess, Method::CHORDS);
 }
+
+TEST_F(SolverTester, StatusAndEvaluations) { this->testStatusAndEvaluations(); }
+
+TEST_F(SolverTester, Cancellation) { this->testCancellation(); }
+
+TEST_F(SolverTester, Limits) { this->testLimits(); }
+
+TEST_F(SolverTester, Iterate) {
+    auto func = [](double x) { return x * x * x - 2 * x - 5; };
+    this->testIterate<double>(func, 2.0, Method::NEWTON, [](double x) { return 3 * x * x - 2; });
+    this->testIterate<double>(func, 2.0, Method::FIXED_POINT, [](double x) { return std::cbrt(2 * x + 5); });
+    this->testIterate<Eigen::Vector2d>(func, Eigen::Vector2d(2.0, 3.0), Method::BISECTION);
+    this->testIterate<Eigen::Vector2d>(func, Eigen::Vector2d(2.0, 3.0), Method::CHORDS);
+}
+
+TEST_F(SolverTester, ConcurrentSolve) {
+    auto func = [](double x) { return x * x - 2; };
+    std::vector<double> guesses;
+    std::vector<Eigen::Vector2d> intervals;
+    for (int i = 0; i < 8; ++i) {
+        guesses.push_back(0.5 + 0.75 * i);
+        intervals.emplace_back(0.5 - 0.125 * i, 1.5 + 0.5 * i);
+    }
+    this->testConcurrentSolve<double>(func, guesses, Method::NEWTON, [](double x) { return 2 * x; });
+    this->testConcurrentSolve<Eigen::Vector2d>(func, intervals, Method::BISECTION);
+    this->testConcurrentSolve<Eigen::Vector2d>(func, intervals, Method::CHORDS);
+}
+
+TEST_F(SolverTester, SolveContextAllocations) {
+    this->testSolveContextAllocations([] { return heap_allocations.load(); });
+}
+
+TEST_F(SolverTester, TrajectoryGrowsWithIterations) { this->testTrajectoryGrowsWithIterations(); }
+
+TEST_F(SolverTester, ScalarTypes) {
+    // each tolerance is out of reach of the narrower types
+    this->testScalarType<float>(1e-5);
+    this->testScalarType<double>(1e-12);
+    this->testScalarType<long double>(1e-16);
+    this->testScalarType<DoubleDouble>(1e-28);
+}
+
+TEST_F(SolverTester, DoubleDouble) { this->testDoubleDouble(); }
+
+TEST_F(SolverTester, MixedPrecision) {
+    this->testMixedPrecision<float, double>(Method::NEWTON, 1.0F, true, 1e-14);
+    this->testMixedPrecision<float, double>(Method::NEWTON, 1.0F, false, 1e-14);
+    this->testMixedPrecision<Point<float>, double>(Method::BISECTION, Point<float>(1.0F, 2.0F), false, 1e-14);
+    this->testMixedPrecision<float, long double>(Method::NEWTON, 3.0F, true, 1e-18);
+    this->testMixedPrecision<Point<float>, DoubleDouble>(Method::CHORDS, Point<float>(0.0F, 2.0F), true, 1e-29);
+}
+
+TEST_F(SolverTester, ComplexRoots) { this->testComplexRoots(); }
@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+
+#include "system_solver_tester.hpp"
+
+TEST_F(SystemSolverTester, Newton) {
+    testNewton(true);
+    testNewton(false);
+}
+
+TEST_F(SystemSolverTester, FactorizationReuse) { testFactorizationReuse(); }
+
+TEST_F(SystemSolverTester, LDLT) { testLDLT(); }
+
+TEST_F(SystemSolverTester, LineSearch) { testLineSearch(); }
+
+TEST_F(SystemSolverTester, ColoredFiniteDifferences) { testColoredFiniteDifferences(); }
+
+TEST_F(SystemSolverTester, SparseNewton) {
+    testSparseNewton(SPARSE_LU, true);
+    testSparseNewton(SPARSE_LU, false);
+    testSparseNewton(BICGSTAB, false);
+}
+
+TEST_F(SystemSolverTester, SparseFailures) { testSparseFailures(); }